@@ -60,6 +60,24 @@
 
 #include "up_internal.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Maximum number of frames processed per receive work invocation.  With
+ * budgeted receive polling, CONFIG_NETDEV_NAPI_BUDGET is used instead.
+ */
+
+#define SIM_NETDEV_RXBATCH 16
+
+/* Size of the packet and GRO buffers when segmentation or receive offload
+ * is enabled.
+ */
+
+#if defined(CONFIG_NET_GSO) || defined(CONFIG_NET_GRO)
+#  define SIM_NETDEV_OFFLOADSIZE 16384
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -68,17 +86,45 @@
 
 static struct work_s g_timer_work;
 static struct work_s g_avail_work;
+#ifdef CONFIG_NETDEV_NAPI
+static bool g_rx_enabled = true;
+#else
 static struct work_s g_recv_work;
+#endif
 
 /* Ethernet peripheral state */
 
 static struct net_driver_s g_sim_dev;
 
+#ifdef CONFIG_NET_BATCH
+/* Ring of outgoing packets collected by one poll of the network */
+
+static struct netdev_desc_s g_tx_desc[CONFIG_NET_BATCH_NPKTS];
+static struct netdev_ring_s g_tx_ring;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static void netdriver_reply(FAR struct net_driver_s *dev)
+static int netdriver_xmit(FAR struct net_driver_s *dev)
+{
+  NETDEV_TXPACKETS(dev);
+  netdev_send(dev->d_buf, dev->d_len);
+  NETDEV_TXDONE(dev);
+  return 0;
+}
+
+static void netdriver_send(FAR struct net_driver_s *dev)
+{
+#ifdef CONFIG_NET_GSO
+  devif_gso_send(dev, netdriver_xmit);
+#else
+  netdriver_xmit(dev);
+#endif
+}
+
+static int netdriver_reply(FAR struct net_driver_s *dev)
 {
   /* If the receiving resulted in data that should be sent out on
    * the network, the field d_len is set to a value > 0.
@@ -110,27 +156,35 @@ static void netdriver_reply(FAR struct net_driver_s *dev)
 
       /* Send the packet */
 
-      NETDEV_TXPACKETS(dev);
-      netdev_send(dev->d_buf, dev->d_len);
-      NETDEV_TXDONE(dev);
+      netdriver_send(dev);
     }
+
+  return 0;
 }
 
-static void netdriver_recv_work(FAR void *arg)
+static int netdriver_recv(FAR struct net_driver_s *dev, int budget)
 {
-  FAR struct net_driver_s *dev = arg;
   FAR struct eth_hdr_s *eth;
-
-  net_lock();
+  int nframes;
 
   /* netdev_read will return 0 on a timeout event and > 0
    * on a data received event
    */
 
-  dev->d_len = netdev_read((FAR unsigned char *)dev->d_buf,
-                           dev->d_pktsize);
-  if (dev->d_len > 0)
+  for (nframes = 0; nframes < budget; nframes++)
     {
+      if (!netdev_avail())
+        {
+          break;
+        }
+
+      dev->d_len = netdev_read((FAR unsigned char *)dev->d_buf,
+                               dev->d_pktsize);
+      if (dev->d_len == 0)
+        {
+          break;
+        }
+
       NETDEV_RXPACKETS(dev);
 
       /* Data received event.  Check for valid Ethernet header with
@@ -163,6 +217,13 @@ static void netdriver_recv_work(FAR void *arg)
                */
 
               arp_ipin(dev);
+#ifdef CONFIG_NET_GRO
+              if (devif_gro_input(dev, netdriver_reply))
+                {
+                  continue;
+                }
+#endif
+
               ipv4_input(dev);
 
               /* Check for a reply to the IPv4 packet */
@@ -179,6 +240,13 @@ static void netdriver_recv_work(FAR void *arg)
 
               /* Give the IPv6 packet to the network layer */
 
+#ifdef CONFIG_NET_GRO
+              if (devif_gro_input(dev, netdriver_reply))
+                {
+                  continue;
+                }
+#endif
+
               ipv6_input(dev);
 
               /* Check for a reply to the IPv6 packet */
@@ -218,9 +286,36 @@ static void netdriver_recv_work(FAR void *arg)
         }
     }
 
+#ifdef CONFIG_NET_GRO
+  /* Pass any segments held for aggregation to the network */
+
+  devif_gro_flush(dev, netdriver_reply);
+#endif
+
+  return nframes;
+}
+
+#ifdef CONFIG_NETDEV_NAPI
+static void netdriver_rxint(FAR struct net_driver_s *dev)
+{
+  /* The host has no receive interrupt; let netdriver_loop() watch for
+   * frames again.
+   */
+
+  g_rx_enabled = true;
+}
+#else
+static void netdriver_recv_work(FAR void *arg)
+{
+  FAR struct net_driver_s *dev = arg;
+
+  net_lock();
+  netdriver_recv(dev, SIM_NETDEV_RXBATCH);
   net_unlock();
 }
+#endif
 
+#ifndef CONFIG_NET_BATCH
 static int netdriver_txpoll(FAR struct net_driver_s *dev)
 {
   /* If the polling resulted in data that should be sent out on the network,
@@ -255,9 +350,7 @@ static int netdriver_txpoll(FAR struct net_driver_s *dev)
         {
           /* Send the packet */
 
-          NETDEV_TXPACKETS(dev);
-          netdev_send(dev->d_buf, dev->d_len);
-          NETDEV_TXDONE(dev);
+          netdriver_send(dev);
         }
     }
 
@@ -267,6 +360,49 @@ static int netdriver_txpoll(FAR struct net_driver_s *dev)
 
   return 0;
 }
+#endif
+
+#ifdef CONFIG_NET_BATCH
+static void netdriver_txbatch(FAR struct net_driver_s *dev, int delay)
+{
+  FAR struct netdev_desc_s *desc;
+  FAR uint8_t *buf = dev->d_buf;
+  bool more;
+
+  do
+    {
+      /* Collect a batch of packets, then send all of them.  A full ring
+       * means that there may be more packets to send.  A timer poll stops
+       * one descriptor short of that and then only updates the remaining
+       * TCP connections, so a normal poll follows it.
+       */
+
+      if (delay > 0)
+        {
+          more  = devif_timer_batch(dev, &g_tx_ring, delay) + 1 >=
+                  g_tx_ring.nr_size;
+          delay = 0;
+        }
+      else
+        {
+          more  = devif_poll_batch(dev, &g_tx_ring) == g_tx_ring.nr_size;
+        }
+
+      while (!NETDEV_RING_EMPTY(&g_tx_ring))
+        {
+          desc       = NETDEV_RING_HEAD(&g_tx_ring);
+          dev->d_buf = desc->nd_buf;
+          dev->d_len = desc->nd_len;
+          netdriver_send(dev);
+          NETDEV_RING_GET(&g_tx_ring);
+        }
+    }
+  while (more);
+
+  dev->d_buf = buf;
+  dev->d_len = 0;
+}
+#endif
 
 static void netdriver_timer_work(FAR void *arg)
 {
@@ -276,7 +412,11 @@ static void netdriver_timer_work(FAR void *arg)
   if (IFF_IS_UP(dev->d_flags))
     {
       work_queue(LPWORK, &g_timer_work, netdriver_timer_work, dev, CLK_TCK);
+#ifdef CONFIG_NET_BATCH
+      netdriver_txbatch(dev, CLK_TCK);
+#else
       devif_timer(dev, CLK_TCK, netdriver_txpoll);
+#endif
     }
 
   net_unlock();
@@ -292,6 +432,10 @@ static int netdriver_ifup(FAR struct net_driver_s *dev)
 static int netdriver_ifdown(FAR struct net_driver_s *dev)
 {
   work_cancel(LPWORK, &g_timer_work);
+#ifdef CONFIG_NETDEV_NAPI
+  netdev_napi_cancel(dev);
+  g_rx_enabled = true;
+#endif
   netdev_ifdown();
   return OK;
 }
@@ -303,7 +447,11 @@ static void netdriver_txavail_work(FAR void *arg)
   net_lock();
   if (IFF_IS_UP(dev->d_flags))
     {
+#ifdef CONFIG_NET_BATCH
+      netdriver_txbatch(dev, 0);
+#else
       devif_poll(dev, netdriver_txpoll);
+#endif
     }
 
   net_unlock();
@@ -328,6 +476,9 @@ int netdriver_init(void)
   FAR struct net_driver_s *dev = &g_sim_dev;
   void *pktbuf;
   int pktsize;
+#ifdef CONFIG_NET_BATCH
+  int i;
+#endif
 
   /* Internal initialization */
 
@@ -338,6 +489,16 @@ int netdriver_init(void)
   pktsize = dev->d_pktsize ? dev->d_pktsize :
             (MAX_NETDEV_PKTSIZE + CONFIG_NET_GUARDSIZE);
 
+#ifdef CONFIG_NET_GSO
+  /* Let TCP build super-segments that are split by devif_gso_send() */
+
+  if (pktsize < SIM_NETDEV_OFFLOADSIZE)
+    {
+      pktsize        = SIM_NETDEV_OFFLOADSIZE;
+      dev->d_gsosize = SIM_NETDEV_OFFLOADSIZE;
+    }
+#endif
+
   /* Allocate packet buffer */
 
   pktbuf = kmm_malloc(pktsize);
@@ -346,6 +507,44 @@ int netdriver_init(void)
       return -ENOMEM;
     }
 
+#ifdef CONFIG_NET_GRO
+  /* Allocate the receive aggregation buffer */
+
+  dev->d_gro.ng_buf = kmm_malloc(SIM_NETDEV_OFFLOADSIZE);
+  if (dev->d_gro.ng_buf == NULL)
+    {
+      kmm_free(pktbuf);
+      return -ENOMEM;
+    }
+
+  dev->d_gro.ng_bufsize = SIM_NETDEV_OFFLOADSIZE;
+#endif
+
+#ifdef CONFIG_NET_BATCH
+  /* Allocate the buffers of the transmit ring */
+
+  for (i = 0; i < CONFIG_NET_BATCH_NPKTS; i++)
+    {
+      g_tx_desc[i].nd_buf = kmm_malloc(pktsize);
+      if (g_tx_desc[i].nd_buf == NULL)
+        {
+          while (--i >= 0)
+            {
+              kmm_free(g_tx_desc[i].nd_buf);
+            }
+
+#ifdef CONFIG_NET_GRO
+          kmm_free(dev->d_gro.ng_buf);
+#endif
+          kmm_free(pktbuf);
+          return -ENOMEM;
+        }
+    }
+
+  g_tx_ring.nr_desc = g_tx_desc;
+  g_tx_ring.nr_size = CONFIG_NET_BATCH_NPKTS;
+#endif
+
   /* Set callbacks */
 
   dev->d_buf     = pktbuf;
@@ -353,6 +552,10 @@ int netdriver_init(void)
   dev->d_ifdown  = netdriver_ifdown;
   dev->d_txavail = netdriver_txavail;
 
+#ifdef CONFIG_NETDEV_NAPI
+  netdev_napi_init(dev, netdriver_recv, netdriver_rxint, 0);
+#endif
+
   /* Register the device with the OS so that socket IOCTLs can be performed */
 
   return netdev_register(dev, NET_LL_ETHERNET);
@@ -370,8 +573,20 @@ void netdriver_setmtu(int mtu)
 
 void netdriver_loop(void)
 {
+#ifdef CONFIG_NETDEV_NAPI
+  /* A received frame acts as the receive interrupt:  Stop watching for
+   * frames until the polling has drained the host queue.
+   */
+
+  if (g_rx_enabled && netdev_avail())
+    {
+      g_rx_enabled = false;
+      netdev_napi_schedule(&g_sim_dev);
+    }
+#else
   if (work_available(&g_recv_work) && netdev_avail())
     {
       work_queue(LPWORK, &g_recv_work, netdriver_recv_work, &g_sim_dev, 0);
     }
+#endif
 }
@@ -130,6 +130,17 @@
 
 #define ENCWORK LPWORK
 
+/* With budgeted receive polling, received packets are not handled by the
+ * interrupt worker:  It disables the packet interrupt and schedules the
+ * polling instead.  The pending packet flag is then ignored by the worker.
+ */
+
+#ifdef CONFIG_NETDEV_NAPI
+#  define ENC_EIRINTS (EIR_ALLINTS & ~EIR_PKTIF)
+#else
+#  define ENC_EIRINTS EIR_ALLINTS
+#endif
+
 /* CONFIG_ENC28J60_DUMPPACKET will dump the contents of each packet. */
 
 #ifdef CONFIG_ENC28J60_DUMPPACKET
@@ -329,6 +340,10 @@ static void enc_txerif(FAR struct enc_driver_s *priv);
 static void enc_rxerif(FAR struct enc_driver_s *priv);
 static void enc_rxdispatch(FAR struct enc_driver_s *priv);
 static void enc_pktif(FAR struct enc_driver_s *priv);
+#ifdef CONFIG_NETDEV_NAPI
+static int  enc_rxpoll(FAR struct net_driver_s *dev, int budget);
+static void enc_rxint(FAR struct net_driver_s *dev);
+#endif
 static void enc_irqworker(FAR void *arg);
 static int  enc_interrupt(int irq, FAR void *context, FAR void *arg);
 
@@ -1606,6 +1621,82 @@ static void enc_pktif(FAR struct enc_driver_s *priv)
   enc_bfsgreg(priv, ENC_ECON2, ECON2_PKTDEC);
 }
 
+/****************************************************************************
+ * Name: enc_rxpoll
+ *
+ * Description:
+ *   Budgeted receive polling:  Receive up to 'budget' packets from the
+ *   receive buffer.
+ *
+ * Input Parameters:
+ *   dev    - Reference to the NuttX driver state structure
+ *   budget - The maximum number of packets to receive
+ *
+ * Returned Value:
+ *   The number of packets received
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static int enc_rxpoll(FAR struct net_driver_s *dev, int budget)
+{
+  FAR struct enc_driver_s *priv = (FAR struct enc_driver_s *)dev->d_private;
+  int npkts = 0;
+
+  enc_lock(priv);
+
+  if (priv->ifstate == ENCSTATE_UP)
+    {
+      while (npkts < budget && enc_rdbreg(priv, ENC_EPKTCNT) > 0)
+        {
+          enc_pktif(priv);
+          npkts++;
+        }
+    }
+
+  enc_unlock(priv);
+  return npkts;
+}
+#endif
+
+/****************************************************************************
+ * Name: enc_rxint
+ *
+ * Description:
+ *   Budgeted receive polling:  The receive buffer has been drained,
+ *   re-enable the packet interrupt.  If another packet was received in the
+ *   meantime, PKTIF is already set and the interrupt is raised immediately.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static void enc_rxint(FAR struct net_driver_s *dev)
+{
+  FAR struct enc_driver_s *priv = (FAR struct enc_driver_s *)dev->d_private;
+
+  enc_lock(priv);
+
+  if (priv->ifstate == ENCSTATE_UP)
+    {
+      enc_bfsgreg(priv, ENC_EIE, EIE_PKTIE);
+    }
+
+  enc_unlock(priv);
+}
+#endif
+
 /****************************************************************************
  * Name: enc_irqworker
  *
@@ -1651,7 +1742,7 @@ static void enc_irqworker(FAR void *arg)
    * interrupts, we are just broken.
    */
 
-  while ((eir = enc_rdgreg(priv, ENC_EIR) & EIR_ALLINTS) != 0)
+  while ((eir = enc_rdgreg(priv, ENC_EIR) & ENC_EIRINTS) != 0)
     {
       /* Handle interrupts according to interrupt register register bit
        * settings.
@@ -1771,6 +1862,7 @@ static void enc_irqworker(FAR void *arg)
        * automatically be cleared.
        */
 
+#ifndef CONFIG_NETDEV_NAPI
 #if 0
       /* Ignore PKTIF because is unreliable. Use EPKTCNT instead */
 
@@ -1787,6 +1879,7 @@ static void enc_irqworker(FAR void *arg)
               enc_pktif(priv);
             }
         }
+#endif
 
       /* RXERIF: The Receive Error Interrupt Flag (RXERIF) is used to
        * indicate a receive buffer overflow condition. Alternately, this
@@ -1815,6 +1908,18 @@ static void enc_irqworker(FAR void *arg)
         }
     }
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Received packets are handled by budgeted polling.  Disable the packet
+   * interrupt until enc_rxint() is called when the buffer has drained.
+   */
+
+  if (enc_rdbreg(priv, ENC_EPKTCNT) > 0)
+    {
+      enc_bfcgreg(priv, ENC_EIE, EIE_PKTIE);
+      netdev_napi_schedule(&priv->dev);
+    }
+#endif
+
   /* Enable GPIO interrupts */
 
   priv->lower->enable(priv->lower);
@@ -2170,6 +2275,12 @@ static int enc_ifdown(struct net_driver_s *dev)
   wd_cancel(&priv->txpoll);
   wd_cancel(&priv->txtimeout);
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Cancel any pending receive polling */
+
+  netdev_napi_cancel(&priv->dev);
+#endif
+
   /* Reset the device and leave in the power save state */
 
   ret = enc_reset(priv);
@@ -2656,6 +2767,12 @@ int enc_initialize(FAR struct spi_dev_s *spi,
   priv->spi           = spi;          /* Save the SPI instance */
   priv->lower         = lower;        /* Save the low-level MCU interface */
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Receive packets with budgeted polling */
+
+  netdev_napi_init(&priv->dev, enc_rxpoll, enc_rxint, 0);
+#endif
+
   /* The interface should be in the down state.  However, this function is
    * called too early in initialization to perform the ENC28J60 reset in
    * enc_ifdown.  We are depending upon the fact that the application level
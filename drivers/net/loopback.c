@@ -81,6 +81,10 @@
 
 #define LO_WDDELAY   (1*CLK_TCK)
 
+/* The buffers of the packet batches are kept 32-bit aligned */
+
+#define LO_BATCHBUFSIZE ((NET_LO_PKTSIZE + CONFIG_NET_GUARDSIZE + 3) & ~3)
+
 /* This is a helper pointer for accessing the contents of the IP header */
 
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)priv->lo_dev.d_buf)
@@ -98,8 +102,14 @@ struct lo_driver_s
 {
   bool lo_bifup;               /* true:ifup false:ifdown */
   bool lo_txdone;              /* One RX packet was looped back */
+#ifdef CONFIG_NET_LOOPBACK_FASTPATH
+  bool lo_polling;             /* A TX poll is in progress */
+#endif
   struct wdog_s lo_polldog;    /* TX poll timer */
   struct work_s lo_work;       /* For deferring poll work to the work queue */
+#ifdef CONFIG_NET_BATCH
+  struct netdev_ring_s lo_ring; /* Batch of packets being looped back */
+#endif
 
   /* This holds the information visible to the NuttX network */
 
@@ -113,6 +123,11 @@ struct lo_driver_s
 static struct lo_driver_s g_loopback;
 static uint8_t g_iobuffer[NET_LO_PKTSIZE + CONFIG_NET_GUARDSIZE];
 
+#ifdef CONFIG_NET_BATCH
+static uint32_t g_batchbuffer[CONFIG_NET_BATCH_NPKTS][LO_BATCHBUFSIZE / 4];
+static struct netdev_desc_s g_batchdesc[CONFIG_NET_BATCH_NPKTS];
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -120,6 +135,9 @@ static uint8_t g_iobuffer[NET_LO_PKTSIZE + CONFIG_NET_GUARDSIZE];
 /* Polling logic */
 
 static int  lo_txpoll(FAR struct net_driver_s *dev);
+#ifdef CONFIG_NET_BATCH
+static void lo_txbatch(FAR struct lo_driver_s *priv);
+#endif
 static void lo_poll_work(FAR void *arg);
 static void lo_poll_expiry(wdparm_t arg);
 
@@ -212,6 +230,45 @@ static int lo_txpoll(FAR struct net_driver_s *dev)
   return 0;
 }
 
+/****************************************************************************
+ * Name: lo_txbatch
+ *
+ * Description:
+ *   Collect a batch of outgoing packets from the network and loop all of
+ *   them back.  Any packets sent in response are looped back immediately by
+ *   lo_txpoll().
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BATCH
+static void lo_txbatch(FAR struct lo_driver_s *priv)
+{
+  int npkts;
+
+  npkts = devif_poll_batch(&priv->lo_dev, &priv->lo_ring);
+  if (npkts > 0)
+    {
+      devif_input_batch(&priv->lo_dev, &priv->lo_ring, lo_txpoll);
+      priv->lo_txdone = true;
+
+      while (npkts-- > 0)
+        {
+          NETDEV_TXPACKETS(&priv->lo_dev);
+          NETDEV_TXDONE(&priv->lo_dev);
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: lo_poll_work
  *
@@ -236,6 +293,9 @@ static void lo_poll_work(FAR void *arg)
   /* Perform the poll */
 
   net_lock();
+#ifdef CONFIG_NET_LOOPBACK_FASTPATH
+  priv->lo_polling = true;
+#endif
   priv->lo_txdone = false;
   devif_timer(&priv->lo_dev, LO_WDDELAY, lo_txpoll);
 
@@ -246,9 +306,17 @@ static void lo_poll_work(FAR void *arg)
       /* Yes, poll again for more TX data */
 
       priv->lo_txdone = false;
+#ifdef CONFIG_NET_BATCH
+      lo_txbatch(priv);
+#else
       devif_poll(&priv->lo_dev, lo_txpoll);
+#endif
     }
 
+#ifdef CONFIG_NET_LOOPBACK_FASTPATH
+  priv->lo_polling = false;
+#endif
+
   /* Setup the watchdog poll timer again */
 
   wd_start(&priv->lo_polldog, LO_WDDELAY, lo_poll_expiry, (wdparm_t)priv);
@@ -367,7 +435,8 @@ static int lo_ifdown(FAR struct net_driver_s *dev)
  *   None
  *
  * Assumptions:
- *   Called on the higher priority worker thread.
+ *   Called on the higher priority worker thread or, with
+ *   CONFIG_NET_LOOPBACK_FASTPATH, directly by lo_txavail().
  *
  ****************************************************************************/
 
@@ -380,14 +449,26 @@ static void lo_txavail_work(FAR void *arg)
   net_lock();
   if (priv->lo_bifup)
     {
+#ifdef CONFIG_NET_LOOPBACK_FASTPATH
+      priv->lo_polling = true;
+#endif
+
       do
         {
           /* If so, then poll the network for new XMIT data */
 
           priv->lo_txdone = false;
+#ifdef CONFIG_NET_BATCH
+          lo_txbatch(priv);
+#else
           devif_poll(&priv->lo_dev, lo_txpoll);
+#endif
         }
       while (priv->lo_txdone);
+
+#ifdef CONFIG_NET_LOOPBACK_FASTPATH
+      priv->lo_polling = false;
+#endif
     }
 
   net_unlock();
@@ -416,6 +497,32 @@ static int lo_txavail(FAR struct net_driver_s *dev)
 {
   FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)dev->d_private;
 
+#ifdef CONFIG_NET_LOOPBACK_FASTPATH
+  /* Poll directly in the context of the caller, unless this is an
+   * interrupt handler.
+   */
+
+  if (!up_interrupt_context())
+    {
+      net_lock();
+      if (priv->lo_polling)
+        {
+          /* We were called back from the poll in progress on this thread.
+           * Just make that poll run once more.
+           */
+
+          priv->lo_txdone = true;
+        }
+      else
+        {
+          lo_txavail_work(priv);
+        }
+
+      net_unlock();
+      return OK;
+    }
+#endif
+
   /* Is our single work structure available?  It may not be if there are
    * pending interrupt actions and we will have to ignore the Tx
    * availability action.
@@ -506,6 +613,9 @@ static int lo_rmmac(FAR struct net_driver_s *dev, FAR const uint8_t *mac)
 int localhost_initialize(void)
 {
   FAR struct lo_driver_s *priv;
+#ifdef CONFIG_NET_BATCH
+  int i;
+#endif
 
   /* Get the interface structure associated with this interface number. */
 
@@ -524,6 +634,18 @@ int localhost_initialize(void)
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = priv;         /* Used to recover private state from dev */
 
+#ifdef CONFIG_NET_BATCH
+  /* Attach the buffers of the packet batches */
+
+  for (i = 0; i < CONFIG_NET_BATCH_NPKTS; i++)
+    {
+      g_batchdesc[i].nd_buf = (FAR uint8_t *)g_batchbuffer[i];
+    }
+
+  priv->lo_ring.nr_desc  = g_batchdesc;
+  priv->lo_ring.nr_size  = CONFIG_NET_BATCH_NPKTS;
+#endif
+
   /* Register the loopabck device with the OS so that socket IOCTLs can b
    * performed.
    */
@@ -544,9 +666,11 @@ int localhost_initialize(void)
   net_ipv6addr_copy(priv->lo_dev.d_ipv6netmask, g_lo_ipv6mask);
 #endif
 
-  /* Put the network in the UP state */
+  /* Put the network in the UP state.  Packets never leave the local host
+   * and cannot be corrupted in transit, so checksums are not needed.
+   */
 
-  priv->lo_dev.d_flags = IFF_UP;
+  priv->lo_dev.d_flags = IFF_UP | IFF_NOCHKSUM;
   return lo_ifup(&priv->lo_dev);
 }
 
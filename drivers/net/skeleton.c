@@ -164,7 +164,12 @@ static int  skel_txpoll(FAR struct net_driver_s *dev);
 /* Interrupt handling */
 
 static void skel_reply(struct skel_driver_s *priv)
+static void skel_rxframe(FAR struct skel_driver_s *priv);
 static void skel_receive(FAR struct skel_driver_s *priv);
+#ifdef CONFIG_NETDEV_NAPI
+static int  skel_rxpoll(FAR struct net_driver_s *dev, int budget);
+static void skel_rxint(FAR struct net_driver_s *dev);
+#endif
 static void skel_txdone(FAR struct skel_driver_s *priv);
 
 static void skel_interrupt_work(FAR void *arg);
@@ -384,10 +389,10 @@ static void skel_reply(struct skel_driver_s *priv)
 }
 
 /****************************************************************************
- * Name: skel_receive
+ * Name: skel_rxframe
  *
  * Description:
- *   An interrupt was received indicating the availability of a new RX packet
+ *   Receive the next RX packet and dispatch it to the network
  *
  * Input Parameters:
  *   priv - Reference to the driver state structure
@@ -400,94 +405,182 @@ static void skel_reply(struct skel_driver_s *priv)
  *
  ****************************************************************************/
 
-static void skel_receive(FAR struct skel_driver_s *priv)
+static void skel_rxframe(FAR struct skel_driver_s *priv)
 {
-  do
-    {
-      /* Check for errors and update statistics */
+  /* Check for errors and update statistics */
 
-      /* Check if the packet is a valid size for the network buffer
-       * configuration.
-       */
+  /* Check if the packet is a valid size for the network buffer
+   * configuration.
+   */
 
-      /* Copy the data data from the hardware to priv->sk_dev.d_buf.  Set
-       * amount of data in priv->sk_dev.d_len
-       */
+  /* Copy the data data from the hardware to priv->sk_dev.d_buf.  Set
+   * amount of data in priv->sk_dev.d_len
+   */
 
 #ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the tap */
+  /* When packet sockets are enabled, feed the frame into the tap */
 
-       pkt_input(&priv->sk_dev);
+  pkt_input(&priv->sk_dev);
 #endif
 
 #ifdef CONFIG_NET_IPv4
-      /* Check for an IPv4 packet */
+  /* Check for an IPv4 packet */
 
-      if (BUF->type == HTONS(ETHTYPE_IP))
-        {
-          ninfo("IPv4 frame\n");
-          NETDEV_RXIPV4(&priv->sk_dev);
+  if (BUF->type == HTONS(ETHTYPE_IP))
+    {
+      ninfo("IPv4 frame\n");
+      NETDEV_RXIPV4(&priv->sk_dev);
 
-          /* Handle ARP on input, then dispatch IPv4 packet to the network
-           * layer.
-           */
+      /* Handle ARP on input, then dispatch IPv4 packet to the network
+       * layer.
+       */
 
-          arp_ipin(&priv->sk_dev);
-          ipv4_input(&priv->sk_dev);
+      arp_ipin(&priv->sk_dev);
+      ipv4_input(&priv->sk_dev);
 
-          /* Check for a reply to the IPv4 packet */
+      /* Check for a reply to the IPv4 packet */
 
-          skel_reply(priv);
-        }
-      else
+      skel_reply(priv);
+    }
+  else
 #endif
 #ifdef CONFIG_NET_IPv6
-      /* Check for an IPv6 packet */
+  /* Check for an IPv6 packet */
 
-      if (BUF->type == HTONS(ETHTYPE_IP6))
-        {
-          ninfo("IPv6 frame\n");
-          NETDEV_RXIPV6(&priv->sk_dev);
+  if (BUF->type == HTONS(ETHTYPE_IP6))
+    {
+      ninfo("IPv6 frame\n");
+      NETDEV_RXIPV6(&priv->sk_dev);
 
-          /* Dispatch IPv6 packet to the network layer */
+      /* Dispatch IPv6 packet to the network layer */
 
-          ipv6_input(&priv->sk_dev);
+      ipv6_input(&priv->sk_dev);
 
-          /* Check for a reply to the IPv6 packet */
+      /* Check for a reply to the IPv6 packet */
 
-          skel_reply(priv);
-        }
-      else
+      skel_reply(priv);
+    }
+  else
 #endif
 #ifdef CONFIG_NET_ARP
-      /* Check for an ARP packet */
+  /* Check for an ARP packet */
 
-      if (BUF->type == htons(ETHTYPE_ARP))
-        {
-          /* Dispatch ARP packet to the network layer */
+  if (BUF->type == htons(ETHTYPE_ARP))
+    {
+      /* Dispatch ARP packet to the network layer */
 
-          arp_arpin(&priv->sk_dev);
-          NETDEV_RXARP(&priv->sk_dev);
+      arp_arpin(&priv->sk_dev);
+      NETDEV_RXARP(&priv->sk_dev);
 
-          /* If the above function invocation resulted in data that should be
-           * sent out on the network, the field  d_len will set to a value
-           * > 0.
-           */
+      /* If the above function invocation resulted in data that should be
+       * sent out on the network, the field  d_len will set to a value
+       * > 0.
+       */
 
-          if (priv->sk_dev.d_len > 0)
-            {
-              skel_transmit(priv);
-            }
-        }
-      else
-#endif
+      if (priv->sk_dev.d_len > 0)
         {
-          NETDEV_RXDROPPED(&priv->sk_dev);
+          skel_transmit(priv);
         }
     }
+  else
+#endif
+    {
+      NETDEV_RXDROPPED(&priv->sk_dev);
+    }
+}
+
+/****************************************************************************
+ * Name: skel_receive
+ *
+ * Description:
+ *   An interrupt was received indicating the availability of a new RX packet
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void skel_receive(FAR struct skel_driver_s *priv)
+{
+  do
+    {
+      skel_rxframe(priv);
+    }
   while (); /* While there are more packets to be processed */
 }
 
+/****************************************************************************
+ * Name: skel_rxpoll
+ *
+ * Description:
+ *   Budgeted receive polling:  Receive up to 'budget' RX packets.  This is
+ *   called on the work queue after skel_interrupt_work() disabled the RX
+ *   interrupts and scheduled the polling.
+ *
+ * Input Parameters:
+ *   dev    - Reference to the NuttX driver state structure
+ *   budget - The maximum number of packets to receive
+ *
+ * Returned Value:
+ *   The number of packets received
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static int skel_rxpoll(FAR struct net_driver_s *dev, int budget)
+{
+  FAR struct skel_driver_s *priv =
+    (FAR struct skel_driver_s *)dev->d_private;
+  int nframes = 0;
+
+  while (nframes < budget)
+    {
+      /* Stop if there are no more packets to be processed */
+
+      skel_rxframe(priv);
+      nframes++;
+    }
+
+  return nframes;
+}
+#endif
+
+/****************************************************************************
+ * Name: skel_rxint
+ *
+ * Description:
+ *   Budgeted receive polling:  All RX packets have been received, re-enable
+ *   the RX interrupts.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+static void skel_rxint(FAR struct net_driver_s *dev)
+{
+  /* Re-enable RX interrupts.  The interrupt must fire if a packet was
+   * received since the last poll.
+   */
+}
+#endif
+
 /****************************************************************************
  * Name: skel_txdone
  *
@@ -565,7 +658,16 @@ static void skel_interrupt_work(FAR void *arg)
 
   /* Check if we received an incoming packet, if so, call skel_receive() */
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Or, with budgeted receive polling, disable further RX interrupts and
+   * let the network poll for the received packets.  skel_rxint() re-enables
+   * the RX interrupts when all of the packets have been received.
+   */
+
+  netdev_napi_schedule(&priv->sk_dev);
+#else
   skel_receive(priv);
+#endif
 
   /* Check if a packet transmission just completed.  If so, call skel_txdone.
    * This may disable further Tx interrupts if there are no pending
@@ -868,6 +970,12 @@ static int skel_ifdown(FAR struct net_driver_s *dev)
   wd_cancel(&priv->sk_txpoll);
   wd_cancel(&priv->sk_txtimeout);
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Cancel any pending RX polling */
+
+  netdev_napi_cancel(&priv->sk_dev);
+#endif
+
   /* Put the EMAC in its reset, non-operational state.  This should be
    * a known configuration that will guarantee the skel_ifup() always
    * successfully brings the interface back up.
@@ -1190,6 +1298,12 @@ int skel_initialize(int intf)
 #endif
   priv->sk_dev.d_private = g_skel;        /* Used to recover private state from dev */
 
+#ifdef CONFIG_NETDEV_NAPI
+  /* Receive packets with budgeted polling */
+
+  netdev_napi_init(&priv->sk_dev, skel_rxpoll, skel_rxint, 0);
+#endif
+
   /* Put the interface in the down state.  This usually amounts to resetting
    * the device and/or calling skel_ifdown().
    */
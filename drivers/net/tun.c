@@ -111,6 +111,19 @@
 
 #define TUN_WDDELAY  (1 * CLK_TCK)
 
+/* Outgoing packets wait in the read buffer until they are read by the
+ * application.  With CONFIG_NET_BATCH the read buffer is a ring of packet
+ * buffers that is filled by one poll of the network.
+ */
+
+#ifdef CONFIG_NET_BATCH
+#  define TUN_READ_PENDING(p) (!NETDEV_RING_EMPTY(&(p)->read_ring))
+#  define TUN_READ_ROOM(p)    (!NETDEV_RING_FULL(&(p)->read_ring))
+#else
+#  define TUN_READ_PENDING(p) ((p)->read_d_len != 0)
+#  define TUN_READ_ROOM(p)    ((p)->read_d_len == 0)
+#endif
+
 /* This is a helper pointer for accessing the contents of the Ethernet
  * header.
  */
@@ -143,14 +156,23 @@ struct tun_device_s
   sem_t             waitsem;
   sem_t             read_wait_sem;
   sem_t             write_wait_sem;
+#ifdef CONFIG_NET_BATCH
+  struct netdev_ring_s read_ring;
+  struct netdev_desc_s read_desc[CONFIG_NET_BATCH_NPKTS];
+#else
   size_t            read_d_len;
+#endif
   size_t            write_d_len;
 
   /* These packet buffer arrays required 16-bit alignment.  That alignment
    * is assured only by the preceding wide data types.
    */
 
+#ifdef CONFIG_NET_BATCH
+  uint8_t           read_buf[CONFIG_NET_BATCH_NPKTS][NET_TUN_PKTSIZE];
+#else
   uint8_t           read_buf[NET_TUN_PKTSIZE];
+#endif
   uint8_t           write_buf[NET_TUN_PKTSIZE];
 
   /* This holds the information visible to the NuttX network */
@@ -174,11 +196,15 @@ static void tun_unlock(FAR struct tun_device_s *priv);
 /* Common TX logic */
 
 static void tun_fd_transmit(FAR struct tun_device_s *priv);
+#ifdef CONFIG_NET_BATCH
+static void tun_txbatch(FAR struct tun_device_s *priv, int delay);
+#else
 static int  tun_txpoll(FAR struct net_driver_s *dev);
 #ifdef CONFIG_NET_ETHERNET
 static int  tun_txpoll_tap(FAR struct net_driver_s *dev);
 #endif
 static int  tun_txpoll_tun(FAR struct net_driver_s *dev);
+#endif
 
 /* Interrupt handling */
 
@@ -344,6 +370,54 @@ static void tun_fd_transmit(FAR struct tun_device_s *priv)
   tun_pollnotify(priv, POLLIN);
 }
 
+/****************************************************************************
+ * Name: tun_txbatch
+ *
+ * Description:
+ *   Poll the network for a batch of outgoing packets.  The packets are
+ *   built directly in the free buffers of the read ring, where they wait
+ *   to be read by the application.
+ *
+ * Input Parameters:
+ *   priv  - Reference to the driver state structure
+ *   delay - The time elapsed since the last timer poll; zero for a normal
+ *           TX poll
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BATCH
+static void tun_txbatch(FAR struct tun_device_s *priv, int delay)
+{
+  int npkts;
+
+  if (delay > 0)
+    {
+      npkts = devif_timer_batch(&priv->dev, &priv->read_ring, delay);
+    }
+  else
+    {
+      npkts = devif_poll_batch(&priv->dev, &priv->read_ring);
+    }
+
+  if (npkts > 0)
+    {
+      while (npkts-- > 0)
+        {
+          NETDEV_TXPACKETS(&priv->dev);
+        }
+
+      tun_pollnotify(priv, POLLIN);
+    }
+}
+#endif
+
+#ifndef CONFIG_NET_BATCH
 /****************************************************************************
  * Name: tun_txpoll
  *
@@ -512,6 +586,7 @@ static int tun_txpoll_tun(FAR struct net_driver_s *dev)
 
   return 0;
 }
+#endif /* !CONFIG_NET_BATCH */
 
 /****************************************************************************
  * Name: tun_net_receive
@@ -756,8 +831,17 @@ static void tun_txdone(FAR struct tun_device_s *priv)
 
   /* Then poll the network for new XMIT data */
 
+#ifdef CONFIG_NET_BATCH
+  /* Wait until the application has read the whole batch */
+
+  if (!TUN_READ_PENDING(priv))
+    {
+      tun_txbatch(priv, 0);
+    }
+#else
   priv->dev.d_buf = priv->read_buf;
   devif_poll(&priv->dev, tun_txpoll);
+#endif
 }
 
 /****************************************************************************
@@ -797,17 +881,25 @@ static void tun_poll_work(FAR void *arg)
 
   net_lock();
 
+#ifdef CONFIG_NET_BATCH
+  /* The batched timer poll keeps the delay in the ring until there is room
+   * for it, so it is called on every tick.
+   */
+
+  tun_txbatch(priv, TUN_WDDELAY);
+#else
   /* Check if there is room in the send another TX packet.  We cannot perform
    * the TX poll if he are unable to accept another packet for transmission.
    */
 
-  if (priv->read_d_len == 0)
+  if (TUN_READ_ROOM(priv))
     {
       /* If so, poll the network for new XMIT data. */
 
       priv->dev.d_buf = priv->read_buf;
       devif_timer(&priv->dev, TUN_WDDELAY, tun_txpoll);
     }
+#endif
 
   /* Setup the watchdog poll timer again */
 
@@ -953,7 +1045,7 @@ static void tun_txavail_work(FAR void *arg)
 
   /* Check if there is room to hold another network packet. */
 
-  if (priv->read_d_len != 0)
+  if (!TUN_READ_ROOM(priv))
     {
       tun_unlock(priv);
       return;
@@ -964,8 +1056,12 @@ static void tun_txavail_work(FAR void *arg)
     {
       /* Poll the network for new XMIT data */
 
+#ifdef CONFIG_NET_BATCH
+      tun_txbatch(priv, 0);
+#else
       priv->dev.d_buf = priv->read_buf;
       devif_poll(&priv->dev, tun_txpoll);
+#endif
     }
 
   net_unlock();
@@ -1078,6 +1174,9 @@ static int tun_dev_init(FAR struct tun_device_s *priv,
                         FAR struct file *filep,
                         FAR const char *devfmt, bool tun)
 {
+#ifdef CONFIG_NET_BATCH
+  int i;
+#endif
   int ret;
 
   /* Initialize the driver structure */
@@ -1092,6 +1191,18 @@ static int tun_dev_init(FAR struct tun_device_s *priv,
 #endif
   priv->dev.d_private = priv;         /* Used to recover private state from dev */
 
+#ifdef CONFIG_NET_BATCH
+  /* Attach the read buffers to the read ring */
+
+  for (i = 0; i < CONFIG_NET_BATCH_NPKTS; i++)
+    {
+      priv->read_desc[i].nd_buf = priv->read_buf[i];
+    }
+
+  priv->read_ring.nr_desc = priv->read_desc;
+  priv->read_ring.nr_size = CONFIG_NET_BATCH_NPKTS;
+#endif
+
   /* Initialize the mutual exlcusion and wait semaphore */
 
   nxsem_init(&priv->waitsem, 0, 1);
@@ -1297,8 +1408,21 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
 
       /* Check if there are data to read in read buffer */
 
-      if (priv->read_d_len > 0)
+      if (TUN_READ_PENDING(priv))
         {
+#ifdef CONFIG_NET_BATCH
+          FAR struct netdev_desc_s *desc = NETDEV_RING_HEAD(&priv->read_ring);
+
+          if (buflen < desc->nd_len)
+            {
+              nread = -EINVAL;
+              break;
+            }
+
+          memcpy(buffer, desc->nd_buf, desc->nd_len);
+          nread = desc->nd_len;
+          NETDEV_RING_GET(&priv->read_ring);
+#else
           if (buflen < priv->read_d_len)
             {
               nread = -EINVAL;
@@ -1308,6 +1432,7 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
           memcpy(buffer, priv->read_buf, priv->read_d_len);
           nread = priv->read_d_len;
           priv->read_d_len = 0;
+#endif
 
           net_lock();
           tun_txdone(priv);
@@ -1378,7 +1503,7 @@ int tun_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
        * So check it too.
        */
 
-      if (priv->read_d_len != 0 || priv->write_d_len != 0)
+      if (TUN_READ_PENDING(priv) || priv->write_d_len != 0)
         {
           eventset |= (fds->events & POLLIN);
         }
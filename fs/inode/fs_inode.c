@@ -29,7 +29,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
-#include <nuttx/semaphore.h>
+#include <nuttx/rwlock.h>
 
 #include "inode/inode.h"
 
@@ -49,12 +49,15 @@
  * removed.  In that case umount() holds the inode semaphore, but the block
  * driver may callback to unregister_blockdriver() after the un-mount,
  * requiring the semaphore again.
+ *
+ * The exclusive access is the write side of a reader/writer lock.  Look-ups
+ * that do not modify the tree take the read side and run in parallel.
  */
 
 struct inode_sem_s
 {
-  sem_t   sem;     /* The semaphore */
-  pid_t   holder;  /* The current holder of the semaphore */
+  rwlock_t lock;   /* The reader/writer lock */
+  pid_t   holder;  /* The current holder of the write lock */
   int16_t count;   /* Number of counts held */
 };
 
@@ -79,11 +82,9 @@ static struct inode_sem_s g_inode_sem;
 
 void inode_initialize(void)
 {
-  /* Initialize the semaphore to one (to support one-at-a-time access to the
-   * inode tree).
-   */
+  /* Initialize the lock of the inode tree */
 
-  nxsem_init(&g_inode_sem.sem, 0, 1);
+  nxrwlock_init(&g_inode_sem.lock);
   g_inode_sem.holder = NO_HOLDER;
   g_inode_sem.count  = 0;
 
@@ -129,7 +130,7 @@ int inode_semtake(void)
 
   else
     {
-      ret = nxsem_wait_uninterruptible(&g_inode_sem.sem);
+      ret = nxrwlock_wrlock(&g_inode_sem.lock);
       if (ret >= 0)
         {
           /* No we hold the semaphore */
@@ -169,6 +170,47 @@ void inode_semgive(void)
     {
       g_inode_sem.holder = NO_HOLDER;
       g_inode_sem.count  = 0;
-      nxsem_post(&g_inode_sem.sem);
+      nxrwlock_wrunlock(&g_inode_sem.lock);
+    }
+}
+
+/****************************************************************************
+ * Name: inode_rdlock
+ *
+ * Description:
+ *   Get shared access to the in-memory inode tree for a look-up that does
+ *   not modify the tree.  If the caller already has exclusive access, this
+ *   just takes another count of it.
+ *
+ ****************************************************************************/
+
+int inode_rdlock(void)
+{
+  if (g_inode_sem.holder == getpid())
+    {
+      return inode_semtake();
+    }
+
+  return nxrwlock_rdlock(&g_inode_sem.lock);
+}
+
+/****************************************************************************
+ * Name: inode_rdunlock
+ *
+ * Description:
+ *   Relinquish the access to the in-memory inode tree taken by
+ *   inode_rdlock().
+ *
+ ****************************************************************************/
+
+void inode_rdunlock(void)
+{
+  if (g_inode_sem.holder == getpid())
+    {
+      inode_semgive();
+    }
+  else
+    {
+      nxrwlock_rdunlock(&g_inode_sem.lock);
     }
 }
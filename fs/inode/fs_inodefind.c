@@ -27,6 +27,8 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 
 #include "inode/inode.h"
@@ -49,13 +51,17 @@
 
 int inode_find(FAR struct inode_search_s *desc)
 {
+#ifndef CONFIG_ARCH_HAVE_FETCHADD
+  irqstate_t flags;
+#endif
   int ret;
 
   /* Find the node matching the path.  If found, increment the count of
-   * references on the node.
+   * references on the node.  The search does not modify the tree so it
+   * may run in parallel with other searches.
    */
 
-  ret = inode_semtake();
+  ret = inode_rdlock();
   if (ret < 0)
     {
       return ret;
@@ -69,11 +75,19 @@ int inode_find(FAR struct inode_search_s *desc)
       FAR struct inode *node = desc->node;
       DEBUGASSERT(node != NULL);
 
-      /* Increment the reference count on the inode */
+      /* Increment the reference count on the inode.  Other readers may
+       * do the same at the same time.
+       */
 
+#ifdef CONFIG_ARCH_HAVE_FETCHADD
+      up_fetchadd16((FAR volatile int16_t *)&node->i_crefs, 1);
+#else
+      flags = enter_critical_section();
       node->i_crefs++;
+      leave_critical_section(flags);
+#endif
     }
 
-  inode_semgive();
+  inode_rdunlock();
   return ret;
 }
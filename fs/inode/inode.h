@@ -166,6 +166,28 @@ int inode_semtake(void);
 
 void inode_semgive(void);
 
+/****************************************************************************
+ * Name: inode_rdlock
+ *
+ * Description:
+ *   Get shared access to the in-memory inode tree.  Several threads may
+ *   search the tree in parallel but they must not modify it.  The access is
+ *   not recursive.
+ *
+ ****************************************************************************/
+
+int inode_rdlock(void);
+
+/****************************************************************************
+ * Name: inode_rdunlock
+ *
+ * Description:
+ *   Relinquish shared access to the in-memory inode tree.
+ *
+ ****************************************************************************/
+
+void inode_rdunlock(void);
+
 /****************************************************************************
  * Name: inode_checkflags
  *
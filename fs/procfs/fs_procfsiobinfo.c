@@ -151,6 +151,12 @@ static FAR const char *g_iob_user_names[] =
 #ifdef CONFIG_NET_IPFORWARD
   "ipforward",
 #endif
+#ifdef CONFIG_NET_ARP_PENDING
+  "arp_pending",
+#endif
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+  "neighbor_pending",
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   "rad802154",
 #endif
@@ -199,6 +205,17 @@ const struct procfs_operations iobinfo_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iobinfo_hitrate
+ ****************************************************************************/
+
+static unsigned int iobinfo_hitrate(uint32_t hits, uint32_t misses)
+{
+  uint64_t total = (uint64_t)hits + misses;
+
+  return total > 0 ? (unsigned int)(100 * (uint64_t)hits / total) : 0;
+}
+
 /****************************************************************************
  * Name: iobinfo_open
  ****************************************************************************/
@@ -275,6 +292,7 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct iobinfo_file_s *iobfile;
   FAR struct iob_userstats_s *userstats;
+  FAR struct iob_cpustats_s *cpustats;
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -352,6 +370,49 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
       totalsize += copysize;
     }
 
+  /* Then the allocation statistics of each CPU */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
+                            "\n%-8s%12s%6s%12s%6s%12s%12s\n",
+                            "CPU", "ALLOCS", "HIT%", "FREES", "HIT%",
+                            "WAITS", "THROTTLED");
+
+      copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; (cpustats = iob_getcpustats(i)) != NULL; i++)
+    {
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
+                                "%-8d%12lu%6u%12lu%6u%12lu%12lu\n", i,
+                                (unsigned long)cpustats->allochits +
+                                cpustats->allocmisses,
+                                iobinfo_hitrate(cpustats->allochits,
+                                                cpustats->allocmisses),
+                                (unsigned long)cpustats->freehits +
+                                cpustats->freemisses,
+                                iobinfo_hitrate(cpustats->freehits,
+                                                cpustats->freemisses),
+                                (unsigned long)cpustats->waits,
+                                (unsigned long)cpustats->throttlewaits);
+
+          copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                     &offset);
+          totalsize += copysize;
+        }
+    }
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -31,6 +31,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <math.h>
+#include <fixedmath.h>
 
 #include <assert.h>
 
@@ -65,6 +66,10 @@
 #define ONE_BY_SQRT3_F     (0.57735f)
 #define TWO_BY_SQRT3_F     (1.15470f)
 
+#define SQRT3_BY_TWO_B16   (0x0000ddb4)
+#define ONE_BY_SQRT3_B16   (0x000093cd)
+#define TWO_BY_SQRT3_B16   (0x0001279a)
+
 /* Some lib constants *******************************************************/
 
 /* Motor electrical angle is in range 0.0 to 2*PI */
@@ -222,6 +227,45 @@ struct dq_frame_s
 
 typedef struct dq_frame_s dq_frame_t;
 
+/* Structure-of-arrays views of n frames and phase angles for the batch
+ * functions.  Each member points to an array of n elements, one element per
+ * channel (motor, axis), so that the batch functions can process all of the
+ * channels in a single loop that the compiler can vectorize.
+ */
+
+struct abc_frame_batch_s
+{
+  FAR float *a;                /* A components */
+  FAR float *b;                /* B components */
+  FAR float *c;                /* C components */
+};
+
+typedef struct abc_frame_batch_s abc_frame_batch_t;
+
+struct ab_frame_batch_s
+{
+  FAR float *a;                /* Alpha components */
+  FAR float *b;                /* Beta components */
+};
+
+typedef struct ab_frame_batch_s ab_frame_batch_t;
+
+struct dq_frame_batch_s
+{
+  FAR float *d;                /* Direct components */
+  FAR float *q;                /* Quadrature components */
+};
+
+typedef struct dq_frame_batch_s dq_frame_batch_t;
+
+struct phase_angle_batch_s
+{
+  FAR float *sin;              /* Phase angle sines */
+  FAR float *cos;              /* Phase angle cosines */
+};
+
+typedef struct phase_angle_batch_s phase_angle_batch_t;
+
 /* Space Vector Modulation data for 3-phase system */
 
 struct svm3_state_s
@@ -234,6 +278,99 @@ struct svm3_state_s
   float       d_min;           /* Duty cycle min */
 };
 
+/* Space Vector Modulation data for n 3-phase systems */
+
+struct svm3_batch_s
+{
+  FAR uint8_t *sector;         /* Current space vector sectors */
+  FAR float   *d_u;            /* Duty cycles for phase U */
+  FAR float   *d_v;            /* Duty cycles for phase V */
+  FAR float   *d_w;            /* Duty cycles for phase W */
+  float        d_max;          /* Duty cycle max, common to all */
+  float        d_min;          /* Duty cycle min, common to all */
+};
+
+/* PI controller state for n channels with common saturation limits */
+
+struct pi_controller_batch_s
+{
+  FAR float  *out;             /* Controller outputs */
+  FAR float  *part;            /* Integral parts */
+  FAR float  *KP;              /* Proportional coefficients */
+  FAR float  *KI;              /* Integral coefficients */
+  float_sat_t sat;             /* Output saturation, common to all */
+};
+
+/* Fixed-point (b16) variants of the frames and of the controller and
+ * modulator state, for targets without a floating point unit.
+ */
+
+struct phase_angle_b16_s
+{
+  b16_t angle;                 /* Phase angle in radians <0, 2PI> */
+  b16_t sin;                   /* Phase angle sine */
+  b16_t cos;                   /* Phase angle cosine */
+};
+
+typedef struct phase_angle_b16_s phase_angle_b16_t;
+
+struct abc_frame_b16_s
+{
+  b16_t a;                     /* A component */
+  b16_t b;                     /* B component */
+  b16_t c;                     /* C component */
+};
+
+typedef struct abc_frame_b16_s abc_frame_b16_t;
+
+struct ab_frame_b16_s
+{
+  b16_t a;                     /* Alpha component */
+  b16_t b;                     /* Beta component */
+};
+
+typedef struct ab_frame_b16_s ab_frame_b16_t;
+
+struct dq_frame_b16_s
+{
+  b16_t d;                     /* Direct component */
+  b16_t q;                     /* Quadrature component */
+};
+
+typedef struct dq_frame_b16_s dq_frame_b16_t;
+
+struct b16_sat_s
+{
+  b16_t min;                   /* Lower limit */
+  b16_t max;                   /* Upper limit */
+};
+
+typedef struct b16_sat_s b16_sat_t;
+
+struct pi_controller_b16_s
+{
+  b16_t     out;               /* Controller output */
+  b16_sat_t sat;               /* Output saturation */
+  b16_t     err;               /* Current error value */
+  b16_t     KP;                /* Proportional coefficient */
+  b16_t     KI;                /* Integral coefficient */
+  b16_t     part[2];           /* 0 - proporitonal part
+                                * 1 - integral part
+                                */
+};
+
+typedef struct pi_controller_b16_s pi_controller_b16_t;
+
+struct svm3_state_b16_s
+{
+  uint8_t     sector;          /* Current space vector sector */
+  b16_t       d_u;             /* Duty cycle for phase U */
+  b16_t       d_v;             /* Duty cycle for phase V */
+  b16_t       d_w;             /* Duty cycle for phase W */
+  b16_t       d_max;           /* Duty cycle max */
+  b16_t       d_min;           /* Duty cycle min */
+};
+
 /* Motor open-loop control data */
 
 struct openloop_data_s
@@ -391,6 +528,8 @@ void pid_integral_reset(FAR pid_controller_t *pid);
 void pi_integral_reset(FAR pid_controller_t *pid);
 float pi_controller(FAR pid_controller_t *pid, float err);
 float pid_controller(FAR pid_controller_t *pid, float err);
+void pi_controller_batch(FAR struct pi_controller_batch_s *pi,
+                         FAR float *err, size_t n);
 
 /* Transformation functions */
 
@@ -401,6 +540,17 @@ void park_transform(FAR phase_angle_t *angle, FAR ab_frame_t *ab,
 void inv_park_transform(FAR phase_angle_t *angle, FAR dq_frame_t *dq,
                         FAR ab_frame_t *ab);
 
+void clarke_transform_batch(FAR abc_frame_batch_t *abc,
+                            FAR ab_frame_batch_t *ab, size_t n);
+void inv_clarke_transform_batch(FAR ab_frame_batch_t *ab,
+                                FAR abc_frame_batch_t *abc, size_t n);
+void park_transform_batch(FAR phase_angle_batch_t *angle,
+                          FAR ab_frame_batch_t *ab,
+                          FAR dq_frame_batch_t *dq, size_t n);
+void inv_park_transform_batch(FAR phase_angle_batch_t *angle,
+                              FAR dq_frame_batch_t *dq,
+                              FAR ab_frame_batch_t *ab, size_t n);
+
 /* Phase angle related functions */
 
 void angle_norm(FAR float *angle, float per, float bottom, float top);
@@ -413,6 +563,8 @@ void svm3_init(FAR struct svm3_state_s *s, float min, float max);
 void svm3(FAR struct svm3_state_s *s, FAR ab_frame_t *ab);
 void svm3_current_correct(FAR struct svm3_state_s *s,
                           int32_t *c0, int32_t *c1, int32_t *c2);
+void svm3_batch(FAR struct svm3_batch_s *s, FAR ab_frame_batch_t *v_ab,
+                size_t n);
 
 /* Field Oriented control */
 
@@ -467,6 +619,28 @@ void motor_phy_params_init(FAR struct motor_phy_params_s *phy, uint8_t poles,
 void motor_phy_params_temp_set(FAR struct motor_phy_params_s *phy,
                                float res_alpha, float res_temp_ref);
 
+/* Fixed-point (b16) variants */
+
+void phase_angle_update_b16(FAR phase_angle_b16_t *angle, b16_t val);
+
+void clarke_transform_b16(FAR abc_frame_b16_t *abc,
+                          FAR ab_frame_b16_t *ab);
+void inv_clarke_transform_b16(FAR ab_frame_b16_t *ab,
+                              FAR abc_frame_b16_t *abc);
+void park_transform_b16(FAR phase_angle_b16_t *angle,
+                        FAR ab_frame_b16_t *ab, FAR dq_frame_b16_t *dq);
+void inv_park_transform_b16(FAR phase_angle_b16_t *angle,
+                            FAR dq_frame_b16_t *dq, FAR ab_frame_b16_t *ab);
+
+void pi_controller_init_b16(FAR pi_controller_b16_t *pi, b16_t KP,
+                            b16_t KI);
+void pi_saturation_set_b16(FAR pi_controller_b16_t *pi, b16_t min,
+                           b16_t max);
+b16_t pi_controller_b16(FAR pi_controller_b16_t *pi, b16_t err);
+
+void svm3_init_b16(FAR struct svm3_state_b16_s *s, b16_t min, b16_t max);
+void svm3_b16(FAR struct svm3_state_b16_s *s, FAR ab_frame_b16_t *v_ab);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -0,0 +1,219 @@
+/****************************************************************************
+ * include/lz4.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_LZ4_H
+#define __INCLUDE_LZ4_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LZ4_HASHLOG          CONFIG_LIBC_LZ4_HASHLOG
+
+/* The largest distance of a match supported by the block format */
+
+#define LZ4_MAX_DISTANCE     65535
+
+/* The largest size of the compressed data of n bytes of input */
+
+#define LZ4_COMPRESSBOUND(n) ((n) + (n) / 255 + 16)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Compression state.  A stream is a sequence of blocks, each of which may
+ * refer back to the data of the blocks compressed before it.  The state
+ * does not copy that data:  The caller must leave the last window bytes
+ * of input unchanged until the next block has been compressed.
+ */
+
+struct lz4_stream_s
+{
+  uint32_t htab[1 << LZ4_HASHLOG]; /* Stream position by hash of 4 bytes */
+  FAR const uint8_t *hist;         /* The previous input still referenced */
+  uint32_t histlen;                /* Length of hist */
+  uint32_t pos;                    /* Stream position of the end of hist */
+  uint32_t window;                 /* Largest distance of a match */
+};
+
+/* Decompression state.  As with compression, the caller must leave the last
+ * window bytes of output unchanged until the next block has been
+ * decompressed.
+ */
+
+struct lz4_dstream_s
+{
+  FAR const uint8_t *hist;         /* The previous output still referenced */
+  uint32_t histlen;                /* Length of hist */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: lz4_stream_init
+ *
+ * Description:
+ *   Start a new compression stream.
+ *
+ * Input Parameters:
+ *   stream - The compression state
+ *   window - The largest distance of a match and the amount of previous
+ *            input that must be kept unchanged.  Zero or a larger value
+ *            selects LZ4_MAX_DISTANCE.  The decompressor needs to keep the
+ *            same amount of previous output.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void lz4_stream_init(FAR struct lz4_stream_s *stream, size_t window);
+
+/****************************************************************************
+ * Name: lz4_compress_continue
+ *
+ * Description:
+ *   Compress in_len bytes at in_data into a block of the LZ4 block format
+ *   at out_data, using the previous input of the stream as dictionary.
+ *
+ *   The input is best placed directly behind the previous block, e.g. the
+ *   next lines of a log in a ring buffer.  Matches may then extend over the
+ *   boundary of the blocks.  If the ring wraps, the previous input is still
+ *   referenced where it is; the caller must not overwrite the window bytes
+ *   before the new input.
+ *
+ *   The buffers must not overlap.  LZ4_COMPRESSBOUND(in_len) bytes of
+ *   output are always enough.
+ *
+ * Input Parameters:
+ *   stream   - The compression state
+ *   in_data  - The data to compress
+ *   in_len   - The number of bytes to compress
+ *   out_data - The buffer that receives the block
+ *   out_len  - The size of out_data
+ *
+ * Returned Value:
+ *   The size of the block.  Zero is returned if it does not fit into
+ *   out_len bytes; the stream may then be continued with other data.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress_continue(FAR struct lz4_stream_s *stream,
+                             FAR const void *in_data, size_t in_len,
+                             FAR void *out_data, size_t out_len);
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes at in_data into an independent block.  The
+ *   caller provides the compression state, which may be allocated in the
+ *   most efficient way for the application.
+ *
+ * Returned Value:
+ *   The size of the block or zero if it does not fit into out_len bytes.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len,
+                    FAR struct lz4_stream_s *stream);
+
+/****************************************************************************
+ * Name: lz4_dstream_init
+ *
+ * Description:
+ *   Start a new decompression stream.
+ *
+ ****************************************************************************/
+
+void lz4_dstream_init(FAR struct lz4_dstream_s *stream);
+
+/****************************************************************************
+ * Name: lz4_decompress_continue
+ *
+ * Description:
+ *   Decompress the next block of a stream into out_data.  Matches may refer
+ *   to the output of the previous blocks, which must be where it was
+ *   decompressed to and unchanged.  Nothing is allocated or copied besides
+ *   the output.
+ *
+ * Input Parameters:
+ *   stream   - The decompression state
+ *   in_data  - The block
+ *   in_len   - The size of the block
+ *   out_data - The buffer that receives the data
+ *   out_len  - The size of out_data
+ *
+ * Returned Value:
+ *   The number of decompressed bytes.  If the output buffer is not large
+ *   enough, zero is returned and errno is set to E2BIG.  If the block is
+ *   malformed, zero is returned and errno is set to EINVAL.  The stream is
+ *   not changed on errors.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress_continue(FAR struct lz4_dstream_s *stream,
+                               FAR const void *in_data, size_t in_len,
+                               FAR void *out_data, size_t out_len);
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress an independent block.
+ *
+ * Returned Value:
+ *   As lz4_decompress_continue().
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_LIBC_LZ4 */
+#endif /* __INCLUDE_LZ4_H */
@@ -59,24 +59,28 @@
 #define IFF_UP             (1 << 1) /* Interface is up */
 #define IFF_RUNNING        (1 << 2) /* Carrier is available */
 #define IFF_IPv6           (1 << 3) /* Configured for IPv6 packet (vs ARP or IPv4) */
+#define IFF_NOCHKSUM       (1 << 4) /* Checksums are offloaded or not needed */
 #define IFF_NOARP          (1 << 7) /* ARP is not required for this packet */
 
 /* Interface flag helpers */
 
-#define IFF_SET_DOWN(f)    do { (f) |= IFF_DOWN; } while (0)
-#define IFF_SET_UP(f)      do { (f) |= IFF_UP; } while (0)
-#define IFF_SET_RUNNING(f) do { (f) |= IFF_RUNNING; } while (0)
-#define IFF_SET_NOARP(f)   do { (f) |= IFF_NOARP; } while (0)
-
-#define IFF_CLR_DOWN(f)    do { (f) &= ~IFF_DOWN; } while (0)
-#define IFF_CLR_UP(f)      do { (f) &= ~IFF_UP; } while (0)
-#define IFF_CLR_RUNNING(f) do { (f) &= ~IFF_RUNNING; } while (0)
-#define IFF_CLR_NOARP(f)   do { (f) &= ~IFF_NOARP; } while (0)
-
-#define IFF_IS_DOWN(f)     (((f) & IFF_DOWN) != 0)
-#define IFF_IS_UP(f)       (((f) & IFF_UP) != 0)
-#define IFF_IS_RUNNING(f)  (((f) & IFF_RUNNING) != 0)
-#define IFF_IS_NOARP(f)    (((f) & IFF_NOARP) != 0)
+#define IFF_SET_DOWN(f)     do { (f) |= IFF_DOWN; } while (0)
+#define IFF_SET_UP(f)       do { (f) |= IFF_UP; } while (0)
+#define IFF_SET_RUNNING(f)  do { (f) |= IFF_RUNNING; } while (0)
+#define IFF_SET_NOARP(f)    do { (f) |= IFF_NOARP; } while (0)
+#define IFF_SET_NOCHKSUM(f) do { (f) |= IFF_NOCHKSUM; } while (0)
+
+#define IFF_CLR_DOWN(f)     do { (f) &= ~IFF_DOWN; } while (0)
+#define IFF_CLR_UP(f)       do { (f) &= ~IFF_UP; } while (0)
+#define IFF_CLR_RUNNING(f)  do { (f) &= ~IFF_RUNNING; } while (0)
+#define IFF_CLR_NOARP(f)    do { (f) &= ~IFF_NOARP; } while (0)
+#define IFF_CLR_NOCHKSUM(f) do { (f) &= ~IFF_NOCHKSUM; } while (0)
+
+#define IFF_IS_DOWN(f)      (((f) & IFF_DOWN) != 0)
+#define IFF_IS_UP(f)        (((f) & IFF_UP) != 0)
+#define IFF_IS_RUNNING(f)   (((f) & IFF_RUNNING) != 0)
+#define IFF_IS_NOARP(f)     (((f) & IFF_NOARP) != 0)
+#define IFF_IS_NOCHKSUM(f)  (((f) & IFF_NOCHKSUM) != 0)
 
 /* We only need to manage the IPv6 bit if both IPv6 and IPv4 are supported.  Otherwise,
  * we can save a few bytes by ignoring it.
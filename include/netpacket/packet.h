@@ -47,6 +47,57 @@
 #include <nuttx/config.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Packet socket options (level SOL_PACKET) */
+
+#define SOL_PACKET          263
+
+#define PACKET_RX_RING      5  /* Set up the receive ring (struct
+                                * tpacket_req).  getsockopt() returns the
+                                * ring address.
+                                */
+#define PACKET_TX_RING      13 /* Set up the transmit ring (struct
+                                * tpacket_req).  getsockopt() returns the
+                                * ring address.
+                                */
+#define PACKET_RX_WAKEUP    64 /* Number of frames filled in the receive ring
+                                * before poll() waiters are notified (int).
+                                * NuttX-specific.
+                                */
+
+/* Frame status values (tp_status) */
+
+#define TP_STATUS_KERNEL        0        /* RX: Frame owned by the network */
+#define TP_STATUS_USER          (1 << 0) /* RX: Frame owned by the user */
+#define TP_STATUS_LOSING        (1 << 2) /* RX: Frames were dropped */
+#define TP_STATUS_AVAILABLE     0        /* TX: Frame free for the user */
+#define TP_STATUS_SEND_REQUEST  (1 << 0) /* TX: Frame ready to be sent */
+#define TP_STATUS_SENDING       (1 << 1) /* TX: Frame being sent */
+#define TP_STATUS_WRONG_FORMAT  (1 << 2) /* TX: Frame could not be sent */
+
+/* To transmit from the ring, the application writes the frame after the
+ * header of the next available frame, sets tp_len and then tp_status to
+ * TP_STATUS_SEND_REQUEST.  A send() without data, e.g.
+ *
+ *   send(sd, NULL, 0, 0);
+ *
+ * then sends all requested frames in ring order and returns the number of
+ * bytes sent.  The ring cannot be changed while it is being sent from;
+ * setsockopt() fails with EBUSY.
+ */
+
+/* Frames are laid out back to back in each block.  The frame data follows
+ * the aligned frame header.
+ */
+
+#define TPACKET_ALIGNMENT   16
+#define TPACKET_ALIGN(x)    (((x) + TPACKET_ALIGNMENT - 1) & \
+                             ~(TPACKET_ALIGNMENT - 1))
+#define TPACKET_HDRLEN      TPACKET_ALIGN(sizeof(struct tpacket_hdr))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -58,4 +109,30 @@ struct sockaddr_ll
   int16_t  sll_ifindex;
 };
 
+/* Ring geometry passed with PACKET_RX_RING and PACKET_TX_RING.
+ * tp_block_size must be a multiple of tp_frame_size and
+ * tp_frame_nr must be equal to the number of frames in all blocks.
+ */
+
+struct tpacket_req
+{
+  unsigned int tp_block_size;   /* Minimal size of contiguous block */
+  unsigned int tp_block_nr;     /* Number of blocks */
+  unsigned int tp_frame_size;   /* Size of frame */
+  unsigned int tp_frame_nr;     /* Total number of frames */
+};
+
+/* Header at the beginning of each frame of the ring */
+
+struct tpacket_hdr
+{
+  volatile unsigned long tp_status; /* Frame owner and state */
+  unsigned int   tp_len;            /* Length of the frame on the wire */
+  unsigned int   tp_snaplen;        /* Number of bytes stored in the ring */
+  unsigned short tp_mac;            /* Offset of the frame from the header */
+  unsigned short tp_net;            /* Offset of the network header */
+  unsigned int   tp_sec;            /* Receive time */
+  unsigned int   tp_usec;
+};
+
 #endif /* __INCLUDE_NETPACKET_PACKET_H */
@@ -99,6 +99,7 @@
 #define _RPTUNBASE      (0x2b00) /* Remote processor tunnel ioctl commands */
 #define _NOTECTLBASE    (0x2c00) /* Note filter control ioctl commands*/
 #define _NOTERAMBASE    (0x2d00) /* Noteram device ioctl commands*/
+#define _USRSOCKBASE    (0x2e00) /* User-space socket daemon ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -539,6 +540,13 @@
 #define _NOTERAMIOCVALID(c) (_IOC_TYPE(c) == _NOTERAMBASE)
 #define _NOTERAMIOC(nr)     _IOC(_NOTERAMBASE, nr)
 
+/* Usrsock device ***********************************************************/
+
+/* (see nuttx/include/nuttx/net/usrsock.h */
+
+#define _USRSOCKIOCVALID(c) (_IOC_TYPE(c) == _USRSOCKBASE)
+#define _USRSOCKIOC(nr)     _IOC(_USRSOCKBASE, nr)
+
 /* Wireless driver network ioctl definitions ********************************/
 
 /* (see nuttx/include/wireless/wireless.h */
@@ -83,6 +83,8 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stddef.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -600,6 +602,17 @@ double      scalbn(double x, int n);
 long double scalbnl(long double x, int n);
 #endif
 
+/* Non-standard Array Functions *********************************************/
+
+/* y[i] = f(x[i]) for n elements.  y may be the same array as x.  The loops
+ * have no branches and can be vectorized by the compiler.
+ */
+
+void        vsinf (FAR float *y, FAR const float *x, size_t n);
+void        vcosf (FAR float *y, FAR const float *x, size_t n);
+void        vexpf (FAR float *y, FAR const float *x, size_t n);
+void        vlogf (FAR float *y, FAR const float *x, size_t n);
+
 #define FP_INFINITE     0
 #define FP_NAN          1
 #define FP_NORMAL       2
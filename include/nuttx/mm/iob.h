@@ -203,6 +203,12 @@ enum iob_user_e
 #ifdef CONFIG_NET_IPFORWARD
   IOBUSER_NET_IPFORWARD,
 #endif
+#ifdef CONFIG_NET_ARP_PENDING
+  IOBUSER_NET_ARP,
+#endif
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+  IOBUSER_NET_NEIGHBOR,
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   IOBUSER_WIRELESS_RAD802154,
 #endif
@@ -234,6 +240,18 @@ struct iob_userstats_s
   int totalproduced;
 };
 
+/* Per-CPU allocation statistics */
+
+struct iob_cpustats_s
+{
+  uint32_t allochits;            /* Allocations served by the CPU cache */
+  uint32_t allocmisses;          /* Allocations served by the global pool */
+  uint32_t freehits;             /* Frees absorbed by the CPU cache */
+  uint32_t freemisses;           /* Frees returned to the global pool */
+  uint32_t waits;                /* Allocations that waited for an IOB */
+  uint32_t throttlewaits;        /* Throttled allocations that waited */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -607,5 +625,25 @@ void iob_dump(FAR const char *msg, FAR struct iob_s *iob, unsigned int len,
 FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid);
 #endif
 
+/****************************************************************************
+ * Name: iob_getcpustats
+ *
+ * Description:
+ *   Return a reference to the IOB allocation statistics of a CPU
+ *
+ * Input Parameters:
+ *   cpu - The index of the CPU
+ *
+ * Returned Value:
+ *   A reference to the statistics, or NULL if 'cpu' is not a valid CPU
+ *   index.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+FAR struct iob_cpustats_s *iob_getcpustats(int cpu);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* _INCLUDE_NUTTX_MM_IOB_H */
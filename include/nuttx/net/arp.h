@@ -78,6 +78,21 @@
  * Public Types
  ****************************************************************************/
 
+#if defined(CONFIG_NET_ARP) && defined(CONFIG_NET_STATISTICS)
+/* The structure holding the ARP table statistics */
+
+struct arp_stats_s
+{
+  net_stats_t hits;       /* Number of lookups of a resolved address */
+  net_stats_t misses;     /* Number of lookups of an unresolved address */
+  net_stats_t added;      /* Number of entries added to the table */
+  net_stats_t evicted;    /* Number of entries evicted to make room */
+  net_stats_t queued;     /* Number of packets queued during resolution */
+  net_stats_t sent;       /* Number of queued packets sent */
+  net_stats_t dropped;    /* Number of queued packets discarded */
+};
+#endif
+
 /* One entry in the ARP table (volatile!) */
 
 struct arp_entry_s
@@ -102,6 +102,21 @@ struct neighbor_entry_s
   clock_t                ne_time;    /* For aging, units of tick */
 };
 
+#ifdef CONFIG_NET_STATISTICS
+/* The structure holding the Neighbor Table statistics */
+
+struct neighbor_stats_s
+{
+  net_stats_t hits;       /* Number of lookups of a resolved address */
+  net_stats_t misses;     /* Number of lookups of an unresolved address */
+  net_stats_t added;      /* Number of entries added to the table */
+  net_stats_t evicted;    /* Number of entries evicted to make room */
+  net_stats_t queued;     /* Number of packets queued during resolution */
+  net_stats_t sent;       /* Number of queued packets sent */
+  net_stats_t dropped;    /* Number of queued packets discarded */
+};
+#endif
+
 #ifdef __cplusplus
 #define EXTERN extern "C"
 extern "C"
@@ -1082,6 +1082,33 @@ ssize_t nx_recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
 
 #define nx_recv(psock,buf,len,flags) nx_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_recvrelease and net_recvrelease
+ *
+ * Description:
+ *   Return the I/O buffer chain lent by a MSG_ZEROCOPY receive operation.
+ *   recv() or recvfrom() with the MSG_ZEROCOPY flag take a buffer for a
+ *   single 'FAR struct iob_s *' and return the I/O buffer chain holding
+ *   the received data there instead of copying the data.  The data begins
+ *   at io_offset of each I/O buffer of the chain.  The caller owns the
+ *   chain until it is released.
+ *
+ * Input Parameters:
+ *   psock  - The socket that received the chain (psock_recvrelease)
+ *   sockfd - The socket descriptor that received the chain
+ *            (net_recvrelease)
+ *   iob    - The I/O buffer chain to release (may be NULL)
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+int psock_recvrelease(FAR struct socket *psock, FAR struct iob_s *iob);
+int net_recvrelease(int sockfd, FAR struct iob_s *iob);
+#endif
+
 /****************************************************************************
  * Name: psock_getsockopt
  *
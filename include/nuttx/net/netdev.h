@@ -50,6 +50,7 @@
 #include <nuttx/config.h>
 
 #include <sys/ioctl.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <queue.h>
 
@@ -68,6 +69,10 @@
 #  include <nuttx/net/mld.h>
 #endif
 
+#ifdef CONFIG_NETDEV_NAPI
+#  include <nuttx/wqueue.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -107,7 +112,17 @@
        } \
      while (0)
 
-#  define NETDEV_RXPACKETS(dev)   _NETDEV_STATISTIC(dev,rx_packets)
+#  ifdef CONFIG_NET_LATENCY
+#    define NETDEV_RXPACKETS(dev) \
+       do \
+         { \
+           (dev)->d_statistics.rx_packets++; \
+           NETDEV_RXSTAMP(dev); \
+         } \
+       while (0)
+#  else
+#    define NETDEV_RXPACKETS(dev) _NETDEV_STATISTIC(dev,rx_packets)
+#  endif
 #  define NETDEV_RXFRAGMENTS(dev) _NETDEV_STATISTIC(dev,rx_fragments)
 #  define NETDEV_RXERRORS(dev)    _NETDEV_ERROR(dev,rx_errors)
 #  ifdef CONFIG_NET_IPv4
@@ -136,7 +151,7 @@
 
 #else
 #  define NETDEV_RESET_STATISTICS(dev)
-#  define NETDEV_RXPACKETS(dev)
+#  define NETDEV_RXPACKETS(dev)   NETDEV_RXSTAMP(dev)
 #  define NETDEV_RXFRAGMENTS(dev)
 #  define NETDEV_RXERRORS(dev)
 #  define NETDEV_RXIPV4(dev)
@@ -152,6 +167,48 @@
 #  define NETDEV_ERRORS(dev)
 #endif
 
+/* Helper macros for network latency instrumentation.  The driver time
+ * stamps each packet when it is received.
+ */
+
+#ifdef CONFIG_NET_LATENCY
+#  define NETDEV_RXSTAMP(dev) ((dev)->d_rxstamp = net_latency_stamp())
+#  define NETDEV_TXSTAMP(dev) \
+     do \
+       { \
+         if ((dev)->d_txstamp == 0) \
+           { \
+             (dev)->d_txstamp = net_latency_stamp(); \
+           } \
+       } \
+     while (0)
+#else
+#  define NETDEV_RXSTAMP(dev)
+#  define NETDEV_TXSTAMP(dev)
+#endif
+
+#ifdef CONFIG_NET_BATCH
+/* Helpers for the packet descriptor rings of batched drivers.
+ * NETDEV_RING_HEAD is the oldest packet in the ring and NETDEV_RING_TAIL the
+ * first free descriptor.  NETDEV_RING_PUT adds the packet in the tail
+ * descriptor to the ring and NETDEV_RING_GET removes the head packet.
+ */
+
+#  define NETDEV_RING_EMPTY(r) ((r)->nr_count == 0)
+#  define NETDEV_RING_FULL(r)  ((r)->nr_count >= (r)->nr_size)
+#  define NETDEV_RING_HEAD(r)  (&(r)->nr_desc[(r)->nr_head])
+#  define NETDEV_RING_TAIL(r) \
+     (&(r)->nr_desc[((r)->nr_head + (r)->nr_count) % (r)->nr_size])
+#  define NETDEV_RING_PUT(r)   ((r)->nr_count++)
+#  define NETDEV_RING_GET(r) \
+     do \
+       { \
+         (r)->nr_head = ((r)->nr_head + 1) % (r)->nr_size; \
+         (r)->nr_count--; \
+       } \
+     while (0)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -179,6 +236,11 @@ struct netdev_statistics_s
   uint32_t rx_arp;         /* Number of Rx ARP packets received */
 #endif
   uint32_t rx_dropped;     /* Unsupported Rx packets received */
+#ifdef CONFIG_NETDEV_NAPI
+  uint32_t rx_interrupts;  /* Number of receive interrupts */
+  uint32_t rx_intframes;   /* Number of frames that raised an interrupt */
+  uint32_t rx_pollframes;  /* Number of frames found by polling */
+#endif
 
   /* Tx Status */
 
@@ -214,6 +276,75 @@ struct netdev_varaddr_s
 };
 #endif
 
+#ifdef CONFIG_NET_GRO
+/* Generic receive offload (GRO) state.  While a driver processes a batch of
+ * received frames, consecutive in-order TCP segments of the same flow are
+ * accumulated in a driver-provided buffer and passed to the network as a
+ * single, larger segment.  See devif_gro_input() and devif_gro_flush().
+ */
+
+struct netdev_gro_s
+{
+  FAR uint8_t *ng_buf;     /* Aggregation buffer provided by the driver */
+  uint16_t ng_bufsize;     /* Size of the aggregation buffer in bytes */
+  uint16_t ng_len;         /* Length of the held frame (0: none held) */
+  uint16_t ng_hdrlen;      /* Link layer + IP + TCP header length */
+  uint16_t ng_sum;         /* One's complement sum of the merged payload */
+  uint16_t ng_nsegs;       /* Number of segments merged into the frame */
+};
+#endif
+
+#ifdef CONFIG_NET_BATCH
+/* Batched packet I/O.  A driver that can transfer several packets per poll
+ * cycle describes its packet buffers with a ring of descriptors.
+ * devif_poll_batch() fills the free descriptors with outgoing packets and
+ * devif_input_batch() passes the received packets held in a ring to the
+ * network.  Each buffer must hold at least d_pktsize bytes plus the
+ * configured guard size.
+ */
+
+struct netdev_desc_s
+{
+  FAR uint8_t *nd_buf;     /* Packet buffer provided by the driver */
+  uint16_t nd_len;         /* Length of the packet in the buffer */
+};
+
+struct netdev_ring_s
+{
+  FAR struct netdev_desc_s *nr_desc; /* Array of nr_size descriptors */
+  uint16_t nr_size;        /* Number of descriptors in the ring */
+  uint16_t nr_head;        /* Index of the oldest packet */
+  uint16_t nr_count;       /* Number of descriptors holding a packet */
+  bool nr_timer;           /* A timer poll is filling the ring */
+  int nr_delay;            /* Timer delay not yet passed to the network */
+};
+#endif
+
+#ifdef CONFIG_NETDEV_NAPI
+/* Budgeted receive polling (NAPI).  On a receive interrupt the driver
+ * disables its receive interrupt and calls netdev_napi_schedule().  The
+ * driver poll function is then called on the low priority work queue with
+ * the network locked to receive up to nn_budget frames.  The poll is
+ * repeated while the budget is exhausted; once fewer frames are found, the
+ * receive interrupt is re-enabled with the nn_rxint callback.
+ */
+
+struct net_driver_s; /* Forward reference */
+
+typedef CODE int (*netdev_rxpoll_t)(FAR struct net_driver_s *dev,
+                                    int budget);
+typedef CODE void (*netdev_rxint_t)(FAR struct net_driver_s *dev);
+
+struct netdev_napi_s
+{
+  struct work_s nn_work;   /* Deferred receive polling */
+  netdev_rxpoll_t nn_poll; /* Receive up to 'budget' frames */
+  netdev_rxint_t nn_rxint; /* Re-enable the receive interrupt */
+  uint16_t nn_budget;      /* Maximum number of frames per poll */
+  bool nn_irq;             /* The next poll follows an interrupt */
+};
+#endif
+
 /* This structure collects information that is specific to a specific network
  * interface driver.  If the hardware platform supports only a single instance
  * of this structure.
@@ -252,6 +383,17 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NET_GSO
+  /* Generic segmentation offload (GSO).  If d_gsosize is larger than
+   * d_pktsize, then d_buf must be at least d_gsosize bytes and TCP may build
+   * outgoing super-segments of up to d_gsosize bytes.  These are split into
+   * segments of at most d_gsomss bytes of payload by devif_gso_send().
+   */
+
+  uint16_t d_gsosize;           /* Maximum super-segment size (0: no GSO) */
+  uint16_t d_gsomss;            /* Segment size of the current packet */
+#endif
+
   /* Link layer address */
 
   union
@@ -358,6 +500,33 @@ struct net_driver_s
   struct netdev_statistics_s d_statistics;
 #endif
 
+#ifdef CONFIG_NET_LATENCY
+  /* Time stamps of the packet being received and of the oldest pending TX
+   * notification (see net_latency_stamp()).  Zero means no time stamp.
+   */
+
+  uint32_t d_rxstamp;
+  uint32_t d_txstamp;
+#endif
+
+#ifdef CONFIG_NET_GRO
+  /* Generic receive offload state */
+
+  struct netdev_gro_s d_gro;
+#endif
+
+#ifdef CONFIG_NETDEV_NAPI
+  /* Budgeted receive polling state */
+
+  struct netdev_napi_s d_napi;
+#endif
+
+#ifdef CONFIG_NET_BATCH
+  /* The descriptor ring being filled by devif_poll_batch() */
+
+  FAR struct netdev_ring_s *d_txring;
+#endif
+
   /* Application callbacks:
    *
    * Network device event handlers are retained in a 'list' and are called
@@ -591,6 +760,169 @@ void neighbor_out(FAR struct net_driver_s *dev);
 
 int devif_loopback(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: devif_gso_send
+ *
+ * Description:
+ *   This function should be called by drivers that support generic
+ *   segmentation offload (d_gsosize > d_pktsize) in place of transmitting
+ *   the packet in d_buf directly, after the link layer header has been
+ *   added (arp_out(), neighbor_out()) and after devif_loopback().
+ *
+ *   If the packet in d_buf is a TCP super-segment larger than d_pktsize,
+ *   it is split in place into MSS-sized segments.  Headers, sequence
+ *   numbers, lengths and checksums are fixed up and the callback is
+ *   invoked once per segment with d_buf and d_len describing that segment.
+ *   Otherwise the callback is invoked once for the unmodified packet.
+ *
+ *   The callback must transmit (or copy) the segment before returning and
+ *   must not replace d_buf.  d_buf is restored and d_len is set to zero
+ *   when this function returns.
+ *
+ * Input Parameters:
+ *   dev      - The network device holding the packet to be sent
+ *   callback - Driver function that transmits one segment
+ *
+ * Returned Value:
+ *   The value returned by the last invocation of the callback.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_GSO
+int devif_gso_send(FAR struct net_driver_s *dev,
+                   devif_poll_callback_t callback);
+#endif
+
+/****************************************************************************
+ * Name: devif_gro_input and devif_gro_flush
+ *
+ * Description:
+ *   Generic receive offload.  Drivers that receive frames in batches may
+ *   pass each received IPv4 or IPv6 frame (after arp_ipin() and pkt_input())
+ *   to devif_gro_input() before handing it to ipv4_input()/ipv6_input().
+ *   TCP data segments destined for this host are then held in the
+ *   d_gro.ng_buf buffer and consecutive in-order segments of the same flow
+ *   are merged.  devif_gro_input() returns a non-zero value if the frame
+ *   was consumed in this way; otherwise the driver must process the frame
+ *   as usual.
+ *
+ *   devif_gro_flush() must be called at the end of each receive batch.  It
+ *   passes any held frame to the network.  If that results in a response,
+ *   the callback is called with d_buf set to the aggregation buffer to
+ *   send it.  The callback is also used by devif_gro_input() when a held
+ *   frame must be flushed to preserve ordering.
+ *
+ *   d_gro.ng_buf and d_gro.ng_bufsize must be set by the driver before the
+ *   device is brought up; GRO is disabled if ng_buf is NULL.  The callback
+ *   must transmit (or copy) the response before returning and must not
+ *   replace d_buf.
+ *
+ * Input Parameters:
+ *   dev      - The network device that received the frame
+ *   callback - Driver function that sends any response in d_buf
+ *
+ * Returned Value:
+ *   devif_gro_input() returns a non-zero value if the frame in d_buf was
+ *   consumed; zero if the caller must pass it to the network itself.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_GRO
+int devif_gro_input(FAR struct net_driver_s *dev,
+                    devif_poll_callback_t callback);
+void devif_gro_flush(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback);
+#endif
+
+/****************************************************************************
+ * Name: devif_poll_batch and devif_timer_batch
+ *
+ * Description:
+ *   Batched versions of devif_poll() and devif_timer().  Instead of calling
+ *   a driver callback for each outgoing packet, the packets are built
+ *   directly in the buffers of the free descriptors of 'ring' and added to
+ *   the ring.  For Ethernet devices the link layer header is completed by
+ *   arp_out() or neighbor_out(); packets addressed to the device itself are
+ *   looped back through the input path at once and not added, so they may
+ *   overtake the packets in the ring.  Polling stops when the ring is full.
+ *
+ *   The driver then transmits the packets from the head of the ring at its
+ *   own pace, removing each with NETDEV_RING_GET().  d_buf is not modified
+ *   by these functions.  Nothing is polled if the ring is full.
+ *
+ *   A timer poll must reach every TCP connection, so it does not stop when
+ *   the ring fills up.  It leaves the last descriptor free and drops the
+ *   TCP segments that do not fit; they are resent by retransmission.  If
+ *   fewer than two descriptors are free, the delay is kept in the ring and
+ *   passed on by the next devif_poll_batch() or devif_timer_batch() call.
+ *   The ring must therefore have at least two descriptors, and the driver
+ *   should call devif_timer_batch() on every timer tick, even if the ring
+ *   is full.
+ *
+ * Input Parameters:
+ *   dev   - The network device to be polled
+ *   ring  - The ring that receives the outgoing packets
+ *   delay - The time elapsed since the last timer poll (devif_timer_batch)
+ *
+ * Returned Value:
+ *   The number of packets added to the ring.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BATCH
+int devif_poll_batch(FAR struct net_driver_s *dev,
+                     FAR struct netdev_ring_s *ring);
+int devif_timer_batch(FAR struct net_driver_s *dev,
+                      FAR struct netdev_ring_s *ring, int delay);
+#endif
+
+/****************************************************************************
+ * Name: devif_input_batch
+ *
+ * Description:
+ *   Pass all of the received packets held in 'ring' to the network,
+ *   oldest first, removing them from the ring.  The packets are dispatched
+ *   by the link layer type of the device:  Ethernet frames by their type
+ *   field (IPv4, IPv6 or ARP), the packets of devices without a link layer
+ *   header by their IP version.
+ *
+ *   If the network responds to a packet, the callback is called with the
+ *   response in d_buf.  For Ethernet devices the link layer header has
+ *   already been completed.  The callback must transmit (or copy) the
+ *   response before returning and must not replace d_buf.  d_buf is
+ *   restored when this function returns.
+ *
+ *   Drivers that use generic receive offload must continue to use
+ *   devif_gro_input() on their per-frame receive path.
+ *
+ * Input Parameters:
+ *   dev      - The network device that received the packets
+ *   ring     - The ring holding the received packets
+ *   callback - Driver function that sends any response in d_buf
+ *
+ * Returned Value:
+ *   The number of packets passed to the network.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BATCH
+int devif_input_batch(FAR struct net_driver_s *dev,
+                      FAR struct netdev_ring_s *ring,
+                      devif_poll_callback_t callback);
+#endif
+
 /****************************************************************************
  * Carrier detection
  *
@@ -605,6 +937,100 @@ int devif_loopback(FAR struct net_driver_s *dev);
 int netdev_carrier_on(FAR struct net_driver_s *dev);
 int netdev_carrier_off(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_napi_init
+ *
+ * Description:
+ *   Prepare budgeted receive polling for a network device.  This must be
+ *   called by the driver before the device is brought up.
+ *
+ * Input Parameters:
+ *   dev    - The network device
+ *   poll   - Driver function that receives and dispatches up to 'budget'
+ *            frames and returns the number of frames received.  It is
+ *            called on the low priority work queue with the network locked.
+ *   rxint  - Driver function that re-enables the receive interrupt.  If a
+ *            frame arrived after the last poll, the interrupt must fire
+ *            when it is re-enabled.
+ *   budget - The maximum number of frames per poll, or zero for the
+ *            default CONFIG_NETDEV_NAPI_BUDGET
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+void netdev_napi_init(FAR struct net_driver_s *dev, netdev_rxpoll_t poll,
+                      netdev_rxint_t rxint, int budget);
+#endif
+
+/****************************************************************************
+ * Name: netdev_napi_schedule
+ *
+ * Description:
+ *   Schedule the receive polling of a device.  This is called from the
+ *   receive interrupt handler (or its deferred work) after the driver has
+ *   disabled the receive interrupt.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+void netdev_napi_schedule(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: netdev_napi_cancel
+ *
+ * Description:
+ *   Cancel any pending receive polling of a device.  This is called when
+ *   the device is taken down.  The receive interrupt is not re-enabled.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+void netdev_napi_cancel(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: net_latency_stamp
+ *
+ * Description:
+ *   Return a time stamp for the network latency instrumentation.  This is
+ *   normally used through NETDEV_RXPACKETS() which stamps each received
+ *   packet.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The current time in microseconds.  The value is never zero, zero is
+ *   reserved to mean "no time stamp".
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LATENCY
+uint32_t net_latency_stamp(void);
+#endif
+
 /****************************************************************************
  * Name: net_ioctl_arglen
  *
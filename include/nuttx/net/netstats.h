@@ -69,6 +69,12 @@
 #ifdef CONFIG_NET_MLD
 #  include <nuttx/net/mld.h>
 #endif
+#ifdef CONFIG_NET_ARP
+#  include <nuttx/net/arp.h>
+#endif
+#ifdef CONFIG_NET_IPv6
+#  include <nuttx/net/neighbor.h>
+#endif
 
 #ifdef CONFIG_NET_STATISTICS
 
@@ -80,6 +86,49 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_IPFORWARD
+/* The structure holding the IP forwarding statistics */
+
+struct ipfwd_stats_s
+{
+  net_stats_t forwarded;  /* Number of packets forwarded */
+  net_stats_t inplace;    /* Number forwarded from the receive buffer */
+  net_stats_t flowhits;   /* Number of flow cache hits */
+  net_stats_t flowmisses; /* Number of flow cache misses */
+  net_stats_t dropped;    /* Number of packets that could not be forwarded */
+};
+#endif
+
+#ifdef CONFIG_NET_LATENCY
+/* The stages of the network latency instrumentation.  The receive stages
+ * are measured from the reception of the packet by the driver.
+ */
+
+enum net_latency_e
+{
+  NET_LATENCY_IPIN = 0,         /* Driver to ipv4_input() or ipv6_input() */
+  NET_LATENCY_L4IN,             /* Driver to tcp_input() or udp_input() */
+  NET_LATENCY_WAKEUP,           /* Driver to the receiving thread */
+  NET_LATENCY_TXPOLL,           /* TX notification to devif_poll() output */
+  NET_LATENCY_NSTAGES
+};
+
+/* Bucket n of a latency histogram counts the samples of less than 2^n
+ * microseconds that did not fit in the previous bucket.  The last bucket
+ * holds all of the longer samples.
+ */
+
+#define NET_LATENCY_NBUCKETS 16
+
+struct net_latency_s
+{
+  uint32_t nsamples;            /* Number of samples */
+  uint64_t total;               /* Sum of the samples (microseconds) */
+  uint32_t max;                 /* Longest sample (microseconds) */
+  uint32_t bucket[NET_LATENCY_NBUCKETS]; /* Histogram of the samples */
+};
+#endif
+
 /* The structure holding the networking statistics that are gathered if
  * CONFIG_NET_STATISTICS is defined.
  */
@@ -94,6 +143,18 @@ struct net_stats_s
   struct ipv6_stats_s ipv6;     /* IPv6 statistics */
 #endif
 
+#ifdef CONFIG_NET_ARP
+  struct arp_stats_s  arp;      /* ARP table statistics */
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD
+  struct ipfwd_stats_s ipfwd;   /* IP forwarding statistics */
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  struct neighbor_stats_s neighbor; /* Neighbor Table statistics */
+#endif
+
 #ifdef CONFIG_NET_ICMP
   struct icmp_stats_s icmp;     /* ICMP statistics */
 #endif
@@ -127,9 +188,39 @@ struct net_stats_s
 
 extern struct net_stats_s g_netstats;
 
+#ifdef CONFIG_NET_LATENCY
+/* This is the array in which the latency histograms are gathered. */
+
+extern struct net_latency_s g_netlatency[NET_LATENCY_NSTAGES];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_latency_record
+ *
+ * Description:
+ *   Add the time elapsed since a time stamp to the histogram of a stage of
+ *   the network latency instrumentation.
+ *
+ * Input Parameters:
+ *   stage - See enum net_latency_e
+ *   stamp - The time stamp returned by net_latency_stamp().  Nothing is
+ *           recorded if it is zero.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LATENCY
+void net_latency_record(int stage, uint32_t stamp);
+#endif
+
 #endif /* CONFIG_NET_STATISTICS */
 #endif /* __INCLUDE_NUTTX_NET_NETSTATS_H */
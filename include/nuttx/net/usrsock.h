@@ -47,6 +47,7 @@
 
 #include <nuttx/net/netconfig.h>
 #include <nuttx/compiler.h>
+#include <nuttx/fs/ioctl.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -74,6 +75,43 @@
 #define USRSOCK_MESSAGE_REQ_COMPLETED(flags) \
                           (!USRSOCK_MESSAGE_REQ_IN_PROGRESS(flags))
 
+/* /dev/usrsock ioctl commands
+ *
+ * USRSOCKIOC_FEATURES
+ *   Description: Enable protocol extensions for this daemon.  The
+ *                extensions stay enabled until /dev/usrsock is closed.
+ *   Argument:    A bit set of USRSOCK_FEATURE_* values.
+ *   Return:      Zero (OK) on success, -ENOTSUP if an extension is not
+ *                supported.
+ */
+
+#define USRSOCKIOC_FEATURES          _USRSOCKIOC(0x0001)
+
+/* Protocol extensions
+ *
+ * USRSOCK_FEATURE_PIPELINE
+ *   A request is removed from /dev/usrsock as soon as the daemon has read
+ *   all of it, instead of when its response arrives, so that requests of
+ *   other sockets can be read while the daemon works on it.  read() may
+ *   return several queued requests back to back; the daemon must split
+ *   them using the request headers.
+ *
+ * USRSOCK_FEATURE_SHM
+ *   Payloads are not copied through /dev/usrsock.  The daemon shares the
+ *   address space of the kernel (CONFIG_NET_USRSOCK_SHM), so the payload of
+ *   a sendto request is replaced by a struct usrsock_request_shm_s giving
+ *   the address of the data, and a recvfrom request is followed by a
+ *   struct usrsock_request_shm_s giving the address of the receive buffer.
+ *   The daemon copies the received data to that buffer itself and writes
+ *   only the address value after the data response header.
+ *
+ * Independently of these extensions, a single write() to /dev/usrsock may
+ * carry any number of response and event messages.
+ */
+
+#define USRSOCK_FEATURE_PIPELINE     (1 << 0)
+#define USRSOCK_FEATURE_SHM          (1 << 1)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -228,6 +266,13 @@ begin_packed_struct struct usrsock_request_ioctl_s
   uint16_t arglen;
 } end_packed_struct;
 
+/* Payload reference (USRSOCK_FEATURE_SHM) */
+
+begin_packed_struct struct usrsock_request_shm_s
+{
+  uintptr_t addr;
+} end_packed_struct;
+
 /* Response/event message structures (kernel <= /dev/usrsock <= daemon) */
 
 begin_packed_struct struct usrsock_message_common_s
@@ -0,0 +1,214 @@
+/****************************************************************************
+ * include/nuttx/rwlock.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RWLOCK_H
+#define __INCLUDE_NUTTX_RWLOCK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <semaphore.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Readers are counted per CPU so that readers on different CPUs do not
+ * contend for the same counter.
+ */
+
+#ifdef CONFIG_SMP
+#  define RWLOCK_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define RWLOCK_NCPUS 1
+#endif
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* A kernel reader/writer lock.  Readers take the lock by incrementing the
+ * counter of their CPU; they only block while a writer holds or waits for
+ * the lock.  Writers are preferred:  A waiting writer keeps new readers out
+ * until it has had the lock.
+ *
+ * A reader may release the lock on another CPU than the one that took it.
+ * The individual counters may then become negative but their sum is always
+ * the number of readers.
+ */
+
+struct rwlock_s
+{
+  volatile int32_t readers[RWLOCK_NCPUS]; /* Per-CPU count of readers */
+  volatile bool writer;   /* A writer holds or waits for the lock */
+  bool    drain;          /* The writer waits for the readers to leave */
+  int16_t nrdwait;        /* Number of readers waiting for the writer */
+  sem_t   wrsem;          /* Serializes the writers */
+  sem_t   rdwait;         /* Readers wait here while there is a writer */
+  sem_t   wrwait;         /* The writer waits here for the readers */
+};
+
+typedef struct rwlock_s rwlock_t;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: nxrwlock_init
+ *
+ * Description:
+ *   Initialize a reader/writer lock.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be initialized
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int nxrwlock_init(FAR rwlock_t *rwlock);
+
+/****************************************************************************
+ * Name: nxrwlock_destroy
+ *
+ * Description:
+ *   Destroy a reader/writer lock that is not held.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be destroyed
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int nxrwlock_destroy(FAR rwlock_t *rwlock);
+
+/****************************************************************************
+ * Name: nxrwlock_rdlock
+ *
+ * Description:
+ *   Take the lock for reading, waiting while a writer holds or waits for
+ *   it.  The lock is not recursive:  A reader must not take the lock again
+ *   since a writer may be waiting in between.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure:  -ECANCELED if the thread was canceled while waiting.
+ *
+ ****************************************************************************/
+
+int nxrwlock_rdlock(FAR rwlock_t *rwlock);
+
+/****************************************************************************
+ * Name: nxrwlock_tryrdlock
+ *
+ * Description:
+ *   Take the lock for reading if no writer holds or waits for it.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  -EAGAIN is returned if there is a
+ *   writer.
+ *
+ ****************************************************************************/
+
+int nxrwlock_tryrdlock(FAR rwlock_t *rwlock);
+
+/****************************************************************************
+ * Name: nxrwlock_rdunlock
+ *
+ * Description:
+ *   Release the lock taken for reading.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be released
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxrwlock_rdunlock(FAR rwlock_t *rwlock);
+
+/****************************************************************************
+ * Name: nxrwlock_wrlock
+ *
+ * Description:
+ *   Take the lock for writing, waiting for the other writers and for the
+ *   readers to leave.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure:  -ECANCELED if the thread was canceled while waiting.
+ *
+ ****************************************************************************/
+
+int nxrwlock_wrlock(FAR rwlock_t *rwlock);
+
+/****************************************************************************
+ * Name: nxrwlock_wrunlock
+ *
+ * Description:
+ *   Release the lock taken for writing.  The lock is handed over to the
+ *   next waiting writer, if any, otherwise the waiting readers are woken
+ *   up.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be released
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxrwlock_wrunlock(FAR rwlock_t *rwlock);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_RWLOCK_H */
@@ -147,6 +147,10 @@ enum note_type_e
   NOTE_IRQ_ENTER       = 20,
   NOTE_IRQ_LEAVE       = 21
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_NET
+  ,
+  NOTE_NET_LATENCY     = 22
+#endif
 };
 
 /* This structure provides the common header of each note */
@@ -318,6 +322,17 @@ struct note_irqhandler_s
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER */
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_NET
+/* This is the specific form of the NOTE_NET_LATENCY note */
+
+struct note_netlatency_s
+{
+  struct note_common_s nnl_cmn; /* Common note parameters */
+  uint8_t nnl_stage;            /* See enum net_latency_e */
+  uint8_t nnl_elapsed[4];       /* Latency of the stage (microseconds) */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_NET */
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
 
 /* This is the type of the argument passed to the NOTECTL_GETMODE and
@@ -439,6 +454,12 @@ void sched_note_irqhandler(int irq, FAR void *handler, bool enter);
 #  define sched_note_irqhandler(i,h,e)
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_NET
+void sched_note_netlatency(int stage, uint32_t elapsed);
+#else
+#  define sched_note_netlatency(s,e)
+#endif
+
 #if defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT)
 
 /****************************************************************************
@@ -561,6 +582,7 @@ void sched_note_filter_irq(struct note_filter_irq_s *oldf,
 #  define sched_note_syscall_enter(n,a...)
 #  define sched_note_syscall_leave(n,r)
 #  define sched_note_irqhandler(i,h,e)
+#  define sched_note_netlatency(s,e)
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
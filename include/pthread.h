@@ -336,6 +336,10 @@ struct pthread_mutex_s
   uint8_t type;     /* Type of the mutex.  See PTHREAD_MUTEX_* definitions */
   int16_t nlocks;   /* The number of recursive locks held */
 #endif
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  volatile int32_t nlockers; /* Threads holding or waiting for the mutex */
+  int16_t nabandoned;        /* Waiters that gave up, still in nlockers */
+#endif
 };
 
 #ifndef __PTHREAD_MUTEX_T_DEFINED
@@ -351,6 +355,16 @@ typedef struct pthread_mutex_s pthread_mutex_t;
 #  endif
 #endif
 
+/* With the fast path, the semaphore holds no count.  It only queues the
+ * threads that wait for a contended mutex.
+ */
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+#  define __PTHREAD_MUTEX_SEMCOUNT 0
+#else
+#  define __PTHREAD_MUTEX_SEMCOUNT 1
+#endif
+
 #if defined(CONFIG_PTHREAD_MUTEX_TYPES) && !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
 #  define PTHREAD_MUTEX_INITIALIZER {NULL, SEM_INITIALIZER(1), -1, \
                                      __PTHREAD_MUTEX_DEFAULT_FLAGS, \
@@ -360,16 +374,17 @@ typedef struct pthread_mutex_s pthread_mutex_t;
                                      __PTHREAD_MUTEX_DEFAULT_FLAGS, \
                                      PTHREAD_MUTEX_RECURSIVE, 0}
 #elif defined(CONFIG_PTHREAD_MUTEX_TYPES)
-#  define PTHREAD_MUTEX_INITIALIZER {SEM_INITIALIZER(1), -1, \
-                                     PTHREAD_MUTEX_DEFAULT, 0}
+#  define PTHREAD_MUTEX_INITIALIZER \
+     {SEM_INITIALIZER(__PTHREAD_MUTEX_SEMCOUNT), -1, PTHREAD_MUTEX_DEFAULT, 0}
 #  define PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP \
-                                     {SEM_INITIALIZER(1), -1, \
-                                     PTHREAD_MUTEX_RECURSIVE, 0}
+     {SEM_INITIALIZER(__PTHREAD_MUTEX_SEMCOUNT), -1, \
+      PTHREAD_MUTEX_RECURSIVE, 0}
 #elif !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
 #  define PTHREAD_MUTEX_INITIALIZER {NULL, SEM_INITIALIZER(1), -1,\
                                      __PTHREAD_MUTEX_DEFAULT_FLAGS}
 #else
-#  define PTHREAD_MUTEX_INITIALIZER {SEM_INITIALIZER(1), -1}
+#  define PTHREAD_MUTEX_INITIALIZER \
+     {SEM_INITIALIZER(__PTHREAD_MUTEX_SEMCOUNT), -1}
 #endif
 
 struct pthread_barrierattr_s
@@ -138,6 +138,8 @@
 #define MSG_ERRQUEUE   0x2000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL   0x4000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE       0x8000 /* Sender will send more.  */
+#define MSG_ZEROCOPY   0x4000000 /* Lend the received I/O buffers (NuttX
+                                  * receive extension, FLAT build only).  */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -214,6 +216,10 @@
 #define SO_TIMESTAMP    16 /* Generates a timestamp for each incoming packet
                             * arg: integer value
                             */
+#define SO_REUSEPORT    17 /* Allow several sockets to bind the same port.
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -258,6 +264,10 @@
 
 /* Definitions associated with sendmsg/recvmsg */
 
+/* Socket-level control message types (cmsg_level == SOL_SOCKET) */
+
+#define SCM_RIGHTS      0x01 /* Array of passed file descriptors */
+
 #define CMSG_NXTHDR(mhdr, cmsg) cmsg_nxthdr((mhdr), (cmsg))
 
 #define CMSG_ALIGN(len) \
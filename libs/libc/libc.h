@@ -140,10 +140,13 @@ int lib_mode2oflags(FAR const char *mode);
 
 /* Defined in lib_libfwrite.c */
 
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream);
 ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream);
 
 /* Defined in lib_libfread.c */
 
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream);
 ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream);
 
 /* Defined in lib_libfgets.c */
@@ -153,6 +156,7 @@ FAR char *lib_fgets(FAR char *buf, size_t buflen, FILE *stream,
 
 /* Defined in lib_libfflush.c */
 
+ssize_t lib_fflush_unlocked(FAR FILE *stream, bool bforce);
 ssize_t lib_fflush(FAR FILE *stream, bool bforce);
 
 /* Defined in lib_rdflush.c */
@@ -182,7 +186,6 @@ int lib_checkbase(int base, FAR const char **pptr);
 /* Defined in lib_expi.c */
 
 #ifdef CONFIG_LIBM
-float  lib_expif(size_t n);
 double lib_expi(size_t n);
 #endif
 
@@ -0,0 +1,77 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_LZ4_LZ4_H
+#define __LIBS_LIBC_LZ4_LZ4_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The LZ4 block format is a sequence of sequences:
+ *
+ *   token        ; LLLLMMMM, L literals, M + 4 bytes of match
+ *   [255...] n   ; L + 255 * k + n literals if L is 15
+ *   literals
+ *   offset       ; 2 bytes, little-endian, distance of the match
+ *   [255...] n   ; M + 255 * k + n if M is 15
+ *
+ * The last sequence has no offset and match.  A block ends with at least
+ * LZ4_LASTLITERALS literals and the last match starts at least
+ * LZ4_MFLIMIT bytes before its end.
+ */
+
+#define LZ4_MINMATCH      4
+#define LZ4_LASTLITERALS  5
+#define LZ4_MFLIMIT       12
+#define LZ4_RUNMASK       15
+
+/* The step of the search for a match grows by one for each 2^SKIPSTRENGTH
+ * positions without one, so that incompressible data is skipped quickly.
+ */
+
+#define LZ4_SKIPSTRENGTH  6
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/* Read 4 bytes of unaligned data.  The compiler turns this into a single
+ * load where the architecture permits it.
+ */
+
+static inline uint32_t lz4_read32(FAR const uint8_t *p)
+{
+  uint32_t v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+#endif /* __LIBS_LIBC_LZ4_LZ4_H */
@@ -0,0 +1,375 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_c.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include <lz4.h>
+
+#include "lz4/lz4.h"
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_hash
+ *
+ * Description:
+ *   Return the hash table index of 4 bytes of input.
+ *
+ ****************************************************************************/
+
+static inline uint32_t lz4_hash(uint32_t seq)
+{
+  return (seq * 2654435761u) >> (32 - LZ4_HASHLOG);
+}
+
+/****************************************************************************
+ * Name: lz4_putlen
+ *
+ * Description:
+ *   Write the continuation bytes of a length that did not fit into the
+ *   token.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *lz4_putlen(FAR uint8_t *op, size_t len)
+{
+  while (len >= 255)
+    {
+      *op++ = 255;
+      len  -= 255;
+    }
+
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+/****************************************************************************
+ * Name: lz4_putseq
+ *
+ * Description:
+ *   Write a sequence of litlen literals followed by a match of mlen bytes
+ *   at the distance offset.  A zero mlen writes the last literals of the
+ *   block.
+ *
+ * Returned Value:
+ *   The end of the sequence in the output or NULL if it does not fit.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *lz4_putseq(FAR uint8_t *op, FAR uint8_t *oend,
+                               FAR const uint8_t *lit, size_t litlen,
+                               uint32_t offset, size_t mlen)
+{
+  FAR uint8_t *token;
+  size_t need;
+
+  need = 1 + litlen + (litlen >= LZ4_RUNMASK ?
+                       (litlen - LZ4_RUNMASK) / 255 + 1 : 0);
+  if (mlen != 0)
+    {
+      mlen -= LZ4_MINMATCH;
+      need += 2 + (mlen >= LZ4_RUNMASK ?
+                   (mlen - LZ4_RUNMASK) / 255 + 1 : 0);
+    }
+
+  if (need > (size_t)(oend - op))
+    {
+      return NULL;
+    }
+
+  token = op++;
+  if (litlen >= LZ4_RUNMASK)
+    {
+      *token = LZ4_RUNMASK << 4;
+      op     = lz4_putlen(op, litlen - LZ4_RUNMASK);
+    }
+  else
+    {
+      *token = (uint8_t)(litlen << 4);
+    }
+
+  memcpy(op, lit, litlen);
+  op += litlen;
+
+  if (need > (size_t)(op - token))
+    {
+      *op++ = (uint8_t)offset;
+      *op++ = (uint8_t)(offset >> 8);
+
+      if (mlen >= LZ4_RUNMASK)
+        {
+          *token |= LZ4_RUNMASK;
+          op      = lz4_putlen(op, mlen - LZ4_RUNMASK);
+        }
+      else
+        {
+          *token |= (uint8_t)mlen;
+        }
+    }
+
+  return op;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_stream_init
+ *
+ * Description:
+ *   Start a new compression stream.
+ *
+ ****************************************************************************/
+
+void lz4_stream_init(FAR struct lz4_stream_s *stream, size_t window)
+{
+  DEBUGASSERT(stream != NULL);
+
+  memset(stream->htab, 0, sizeof(stream->htab));
+
+  stream->hist    = NULL;
+  stream->histlen = 0;
+  stream->pos     = 0;
+  stream->window  = window == 0 || window > LZ4_MAX_DISTANCE ?
+                    LZ4_MAX_DISTANCE : (uint32_t)window;
+}
+
+/****************************************************************************
+ * Name: lz4_compress_continue
+ *
+ * Description:
+ *   Compress the next block of a stream.
+ *
+ *   The hash table maps 4 bytes of input to the stream position where they
+ *   were last seen.  A position is used only if it is within the window and
+ *   the data that is still referenced, and only if the bytes there match,
+ *   so that stale entries and collisions cost nothing but the comparison.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress_continue(FAR struct lz4_stream_s *stream,
+                             FAR const void *in_data, size_t in_len,
+                             FAR void *out_data, size_t out_len)
+{
+  FAR const uint8_t *src = (FAR const uint8_t *)in_data;
+  FAR const uint8_t *iend = src + in_len;
+  FAR const uint8_t *ip = src;
+  FAR const uint8_t *anchor = src;
+  FAR const uint8_t *histend;
+  FAR const uint8_t *match;
+  FAR const uint8_t *ref;
+  FAR const uint8_t *limit;
+  FAR uint8_t *op = (FAR uint8_t *)out_data;
+  FAR uint8_t *oend = op + out_len;
+  uint32_t base;
+  uint32_t cur;
+  uint32_t dist;
+  uint32_t off;
+  uint32_t seq;
+  uint32_t h;
+  unsigned int step;
+  size_t histlen;
+  bool prefix;
+  bool inhist;
+
+  DEBUGASSERT(stream != NULL && (in_data != NULL || in_len == 0) &&
+              out_data != NULL);
+
+  /* The previous input is a prefix of this block if it is directly in
+   * front of it.  Matches may then run from one into the other.
+   */
+
+  histend = stream->hist + stream->histlen;
+  base    = stream->pos;
+  prefix  = stream->histlen > 0 && histend == src;
+
+  if (in_len > LZ4_MFLIMIT)
+    {
+      FAR const uint8_t *mflimit = iend - LZ4_MFLIMIT;
+      FAR const uint8_t *matchlimit = iend - LZ4_LASTLITERALS;
+
+      for (; ; )
+        {
+          /* Look for a match, skipping ahead faster the longer there has
+           * been none.
+           */
+
+          step = 1 << LZ4_SKIPSTRENGTH;
+          for (; ; )
+            {
+              if (ip > mflimit)
+                {
+                  goto last_literals;
+                }
+
+              off  = (uint32_t)(ip - src);
+              cur  = base + off;
+              seq  = lz4_read32(ip);
+              h    = lz4_hash(seq);
+              dist = cur - stream->htab[h];
+              stream->htab[h] = cur;
+
+              if (dist - 1 < stream->window &&
+                  dist <= off + stream->histlen)
+                {
+                  if (dist <= off)
+                    {
+                      ref    = ip - dist;
+                      inhist = false;
+                    }
+                  else
+                    {
+                      ref    = histend - (dist - off);
+                      inhist = true;
+
+                      /* Do not read beyond a detached dictionary */
+
+                      if (!prefix && dist - off < LZ4_MINMATCH)
+                        {
+                          ref = NULL;
+                        }
+                    }
+
+                  if (ref != NULL && lz4_read32(ref) == seq)
+                    {
+                      break;
+                    }
+                }
+
+              ip += step++ >> LZ4_SKIPSTRENGTH;
+            }
+
+          /* Extend the match backwards over the pending literals */
+
+          limit = inhist || prefix ? stream->hist : src;
+          while (ip > anchor && ref > limit && ip[-1] == ref[-1])
+            {
+              ip--;
+              ref--;
+            }
+
+          /* And forwards, up to the end of a detached dictionary */
+
+          limit = matchlimit;
+          if (inhist && !prefix && histend - ref < matchlimit - ip)
+            {
+              limit = ip + (histend - ref);
+            }
+
+          match = ip;
+          ip   += LZ4_MINMATCH;
+          ref  += LZ4_MINMATCH;
+
+          while (ip + 4 <= limit && lz4_read32(ip) == lz4_read32(ref))
+            {
+              ip  += 4;
+              ref += 4;
+            }
+
+          while (ip < limit && *ip == *ref)
+            {
+              ip++;
+              ref++;
+            }
+
+          op = lz4_putseq(op, oend, anchor, match - anchor, dist,
+                          ip - match);
+          if (op == NULL)
+            {
+              return 0;
+            }
+
+          anchor = ip;
+          if (ip > mflimit)
+            {
+              break;
+            }
+
+          /* Index a position inside of the match as well */
+
+          stream->htab[lz4_hash(lz4_read32(ip - 2))] =
+            base + (uint32_t)(ip - 2 - src);
+        }
+    }
+
+last_literals:
+  op = lz4_putseq(op, oend, anchor, iend - anchor, 0, 0);
+  if (op == NULL)
+    {
+      return 0;
+    }
+
+  /* Keep the window of input that the next block may refer to */
+
+  if (in_len > 0)
+    {
+      if (prefix)
+        {
+          histlen = stream->histlen + in_len;
+        }
+      else
+        {
+          histlen = in_len;
+        }
+
+      if (histlen > stream->window)
+        {
+          histlen = stream->window;
+        }
+
+      stream->hist    = iend - histlen;
+      stream->histlen = (uint32_t)histlen;
+      stream->pos     = base + (uint32_t)in_len;
+    }
+
+  return op - (FAR uint8_t *)out_data;
+}
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes at in_data into an independent block.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len,
+                    FAR struct lz4_stream_s *stream)
+{
+  lz4_stream_init(stream, 0);
+  return lz4_compress_continue(stream, in_data, in_len, out_data, out_len);
+}
+
+#endif /* CONFIG_LIBC_LZ4 */
@@ -0,0 +1,303 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_d.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <lz4.h>
+
+#include "lz4/lz4.h"
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_getlen
+ *
+ * Description:
+ *   Add the continuation bytes of a length to len.
+ *
+ * Returned Value:
+ *   The position after the length or NULL if the input ends before it.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *lz4_getlen(FAR const uint8_t *ip,
+                                     FAR const uint8_t *iend,
+                                     FAR size_t *len)
+{
+  uint8_t b;
+
+  do
+    {
+      if (ip >= iend)
+        {
+          return NULL;
+        }
+
+      b     = *ip++;
+      *len += b;
+    }
+  while (b == 255);
+
+  return ip;
+}
+
+/****************************************************************************
+ * Name: lz4_copymatch
+ *
+ * Description:
+ *   Copy len bytes from offset bytes back in the output.  The source may
+ *   overlap the destination, which repeats the last offset bytes.
+ *
+ ****************************************************************************/
+
+static inline void lz4_copymatch(FAR uint8_t *op, size_t offset, size_t len)
+{
+  FAR const uint8_t *ref = op - offset;
+
+  if (offset >= len)
+    {
+      memcpy(op, ref, len);
+    }
+  else
+    {
+      while (len-- > 0)
+        {
+          *op++ = *ref++;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_dstream_init
+ *
+ * Description:
+ *   Start a new decompression stream.
+ *
+ ****************************************************************************/
+
+void lz4_dstream_init(FAR struct lz4_dstream_s *stream)
+{
+  DEBUGASSERT(stream != NULL);
+
+  stream->hist    = NULL;
+  stream->histlen = 0;
+}
+
+/****************************************************************************
+ * Name: lz4_decompress_continue
+ *
+ * Description:
+ *   Decompress the next block of a stream.  Every length and offset is
+ *   checked against the input, the output and the previous output so that
+ *   a malformed block never reads or writes out of bounds.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress_continue(FAR struct lz4_dstream_s *stream,
+                               FAR const void *in_data, size_t in_len,
+                               FAR void *out_data, size_t out_len)
+{
+  FAR const uint8_t *ip = (FAR const uint8_t *)in_data;
+  FAR const uint8_t *iend = ip + in_len;
+  FAR const uint8_t *histend;
+  FAR uint8_t *dst = (FAR uint8_t *)out_data;
+  FAR uint8_t *op = dst;
+  FAR uint8_t *oend = op + out_len;
+  size_t histlen;
+  size_t offset;
+  size_t back;
+  size_t len;
+  size_t n;
+  unsigned int token;
+  bool prefix;
+
+  DEBUGASSERT(stream != NULL && in_data != NULL && out_data != NULL);
+
+  /* Matches may refer to the previous output, which is contiguous with
+   * this output if it was written directly in front of it.
+   */
+
+  histend = stream->hist + stream->histlen;
+  prefix  = stream->histlen > 0 && histend == dst;
+
+  for (; ; )
+    {
+      if (ip >= iend)
+        {
+          goto errout_with_einval;
+        }
+
+      token = *ip++;
+
+      /* Copy the literals */
+
+      len = token >> 4;
+      if (len == LZ4_RUNMASK)
+        {
+          ip = lz4_getlen(ip, iend, &len);
+          if (ip == NULL)
+            {
+              goto errout_with_einval;
+            }
+        }
+
+      if (len > (size_t)(iend - ip))
+        {
+          goto errout_with_einval;
+        }
+
+      if (len > (size_t)(oend - op))
+        {
+          goto errout_with_e2big;
+        }
+
+      memcpy(op, ip, len);
+      ip += len;
+      op += len;
+
+      /* The last sequence of the block has no match */
+
+      if (ip == iend)
+        {
+          break;
+        }
+
+      if (iend - ip < 2)
+        {
+          goto errout_with_einval;
+        }
+
+      offset = ip[0] | (ip[1] << 8);
+      ip    += 2;
+
+      len = (token & LZ4_RUNMASK) + LZ4_MINMATCH;
+      if (len == LZ4_RUNMASK + LZ4_MINMATCH)
+        {
+          ip = lz4_getlen(ip, iend, &len);
+          if (ip == NULL)
+            {
+              goto errout_with_einval;
+            }
+        }
+
+      if (len > (size_t)(oend - op))
+        {
+          goto errout_with_e2big;
+        }
+
+      /* Copy the match, which may start in the previous output */
+
+      if (offset == 0)
+        {
+          goto errout_with_einval;
+        }
+
+      if (offset > (size_t)(op - dst))
+        {
+          back = offset - (op - dst);
+          if (back > stream->histlen)
+            {
+              goto errout_with_einval;
+            }
+
+          if (!prefix)
+            {
+              /* Copy the part in the previous output, the rest follows at
+               * the start of this output.
+               */
+
+              n = back < len ? back : len;
+              memcpy(op, histend - back, n);
+              op  += n;
+              len -= n;
+            }
+        }
+
+      lz4_copymatch(op, offset, len);
+      op += len;
+    }
+
+  /* Keep the window of output that the next block may refer to */
+
+  if (op > dst)
+    {
+      histlen = op - dst;
+      if (prefix)
+        {
+          histlen += stream->histlen;
+        }
+
+      if (histlen > LZ4_MAX_DISTANCE)
+        {
+          histlen = LZ4_MAX_DISTANCE;
+        }
+
+      stream->hist    = op - histlen;
+      stream->histlen = (uint32_t)histlen;
+    }
+
+  return op - dst;
+
+errout_with_e2big:
+  set_errno(E2BIG);
+  return 0;
+
+errout_with_einval:
+  set_errno(EINVAL);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress an independent block.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len)
+{
+  struct lz4_dstream_s stream;
+
+  lz4_dstream_init(&stream);
+  return lz4_decompress_continue(&stream, in_data, in_len, out_data,
+                                 out_len);
+}
+
+#endif /* CONFIG_LIBC_LZ4 */
@@ -29,13 +29,41 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
+#include <stddef.h>
 #include <math.h>
 
+#include "lib_mathf.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cosf
+ *
+ * Description:
+ *   Return the cosine of x.  The error is at most 2.33 ULP for
+ *   |x| <= 6400.
+ *
+ ****************************************************************************/
+
 float cosf(float x)
 {
-  return sinf(x + M_PI_2_F);
+  return mathf_sincos(x, 1);
+}
+
+/****************************************************************************
+ * Name: vcosf
+ *
+ * Description:
+ *   Compute the cosine of n elements:  y[i] = cosf(x[i]).  y may be the
+ *   same array as x.
+ *
+ ****************************************************************************/
+
+void vcosf(FAR float *y, FAR const float *x, size_t n)
+{
+  mathf_vsincos(y, x, n, 1);
 }
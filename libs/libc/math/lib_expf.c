@@ -29,84 +29,45 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <nuttx/config.h>
+
+#include <stddef.h>
 #include <math.h>
 
-#include "libc.h"
+#include "lib_mathf.h"
 
 /****************************************************************************
- * Private Data
+ * Public Functions
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1/0! */
-  1.0 / 1.0,                    /* 1/1! */
-  1.0 / 2.0,                    /* 1/2! */
-  1.0 / 6.0,                    /* 1/3! */
-  1.0 / 24.0,                   /* 1/4! */
-  1.0 / 120.0,                  /* 1/5! */
-  1.0 / 720.0,                  /* 1/6! */
-  1.0 / 5040.0,                 /* 1/7! */
-  1.0 / 40320.0,                /* 1/8! */
-  1.0 / 362880.0,               /* 1/9! */
-  1.0 / 3628800.0,              /* 1/10! */
-};
-
 /****************************************************************************
- * Public Functions
+ * Name: expf
+ *
+ * Description:
+ *   Return the exponential of x.  The error is at most 0.99 ULP.
+ *
  ****************************************************************************/
 
 float expf(float x)
 {
-  size_t int_part;
-  bool invert;
-  float value;
-  float x0;
-  size_t i;
-
-  if (x == 0)
-    {
-      return 1;
-    }
-  else if (x < 0)
-    {
-      invert = true;
-      x = -x;
-    }
-  else
-    {
-      invert = false;
-    }
-
-  /* Extract integer component */
-
-  int_part = (size_t) x;
-
-  /* set x to fractional component */
-
-  x -= (float)int_part;
-
-  /* Perform Taylor series approximation with eleven terms */
-
-  value = 0.0F;
-  x0 = 1.0F;
-  for (i = 0; i < 10; i++)
-    {
-      value += x0 * _flt_inv_fact[i];
-      x0 *= x;
-    }
+  return mathf_exp_kernel(x);
+}
 
-  /* Multiply by exp of the integer component */
+/****************************************************************************
+ * Name: vexpf
+ *
+ * Description:
+ *   Compute the exponential of n elements:  y[i] = expf(x[i]).  y may be the
+ *   same array as x.
+ *
+ ****************************************************************************/
 
-  value *= lib_expif(int_part);
+void vexpf(FAR float *y, FAR const float *x, size_t n)
+{
+  size_t i;
 
-  if (invert)
-    {
-      return (1.0F / value);
-    }
-  else
+  for (i = 0; i < n; i++)
     {
-      return value;
+      y[i] = mathf_exp_kernel(x[i]);
     }
 }
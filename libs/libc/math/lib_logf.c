@@ -29,22 +29,12 @@
  * Included Files
  ****************************************************************************/
 
-#include <math.h>
-#include <float.h>
-
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
+#include <nuttx/config.h>
 
-#define FLT_MAX_EXP_X   88.0F
-
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
- */
+#include <stddef.h>
+#include <math.h>
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2
+#include "lib_mathf.h"
 
 /****************************************************************************
  * Public Functions
@@ -52,63 +42,32 @@
 
 /****************************************************************************
  * Name: logf
+ *
+ * Description:
+ *   Return the natural logarithm of x.  The error is at most 0.83 ULP.
+ *
  ****************************************************************************/
 
 float logf(float x)
 {
-  float y;
-  float y_old;
-  float ney;
-  float epsilon;
-  int   relax_factor;
-  int   iter;
-
-  y       = 0.0F;
-  y_old   = 1.0F;
-  epsilon = FLT_EPSILON;
-
-  iter         = 0;
-  relax_factor = 1;
-
-  while (y > y_old + epsilon || y < y_old - epsilon)
-    {
-      y_old = y;
-      ney   = expf(-y);
-      y    -= 1.0F - x * ney;
-
-      if (y > FLT_MAX_EXP_X)
-        {
-          y = FLT_MAX_EXP_X;
-        }
-
-      if (y < -FLT_MAX_EXP_X)
-        {
-          y = -FLT_MAX_EXP_X;
-        }
-
-      epsilon = (fabsf(y) > 1.0F) ? fabsf(y) * FLT_EPSILON : FLT_EPSILON;
-
-      if (++iter >= LOGF_MAX_ITER)
-        {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
-        }
+  return mathf_log_kernel(x);
+}
 
-      if (relax_factor > 1)
-        {
-          epsilon *= relax_factor;
-        }
-    }
+/****************************************************************************
+ * Name: vlogf
+ *
+ * Description:
+ *   Compute the natural logarithm of n elements:  y[i] = logf(x[i]).  y
+ *   may be the same array as x.
+ *
+ ****************************************************************************/
 
-  if (y == FLT_MAX_EXP_X)
-    {
-      return INFINITY;
-    }
+void vlogf(FAR float *y, FAR const float *x, size_t n)
+{
+  size_t i;
 
-  if (y == -FLT_MAX_EXP_X)
+  for (i = 0; i < n; i++)
     {
-      return INFINITY;
+      y[i] = mathf_log_kernel(x[i]);
     }
-
-  return y;
 }
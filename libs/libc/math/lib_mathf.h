@@ -0,0 +1,307 @@
+/****************************************************************************
+ * libs/libc/math/lib_mathf.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_MATH_LIB_MATHF_H
+#define __LIBS_LIBC_MATH_LIB_MATHF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Adding and subtracting 1.5 * 2^23 rounds a float of magnitude below 2^22
+ * to the nearest integer without a call or a branch.
+ */
+
+#define MATHF_ROUND_SHIFT   12582912.0F
+
+/* pi/2 split into parts of 12 significant bits (and the rest).  k * part is
+ * exact for k < 2^12, so the reduction x - k * pi/2 is accurate for
+ * |x| <= MATHF_SINCOS_LIMIT.
+ */
+
+#define MATHF_PIO2_1        1.5703125F
+#define MATHF_PIO2_2        4.837512969970703e-04F
+#define MATHF_PIO2_3        7.549533620476723e-08F
+#define MATHF_PIO2_4        2.5633440682570896e-12F
+
+#define MATHF_SINCOS_LIMIT  6400.0F
+
+/* ln(2) split into a part with few significant bits and the rest */
+
+#define MATHF_LN2_HI        0.693359375F
+#define MATHF_LN2_LO        -2.12194440e-4F
+
+/* Outside of this range expf() over- or underflows */
+
+#define MATHF_EXP_MAX       89.0F
+#define MATHF_EXP_MIN       -104.0F
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Union which permits us to convert between a float and a 32 bit int */
+
+typedef union
+{
+  float    value;
+  uint32_t word;
+}
+mathf_shape_t;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+static inline uint32_t mathf_asuint(float x)
+{
+  mathf_shape_t u;
+
+  u.value = x;
+  return u.word;
+}
+
+static inline float mathf_asfloat(uint32_t i)
+{
+  mathf_shape_t u;
+
+  u.word = i;
+  return u.value;
+}
+
+/****************************************************************************
+ * Name: mathf_sincos_kernel
+ *
+ * Description:
+ *   Return sin(x) for quadrant 0 or cos(x) for quadrant 1.  x is reduced
+ *   to r in [-pi/4, pi/4] and the quadrant selects between the minimax
+ *   polynomials of sin(r) and cos(r) and their sign.
+ *
+ *   The error is at most 2.34 ULP over all x with |x| <=
+ *   MATHF_SINCOS_LIMIT.  The result is meaningless for larger or non-finite
+ *   x but the kernel has no branches so that loops calling it can be
+ *   vectorized.
+ *
+ ****************************************************************************/
+
+static inline float mathf_sincos_kernel(float x, int32_t quadrant)
+{
+  float kf;
+  float r;
+  float z;
+  float s;
+  float c;
+  int32_t q;
+
+  kf = x * (float)M_2_PI + MATHF_ROUND_SHIFT;
+  kf = kf - MATHF_ROUND_SHIFT;
+  q  = (int32_t)kf + quadrant;
+
+  r  = x - kf * MATHF_PIO2_1;
+  r  = r - kf * MATHF_PIO2_2;
+  r  = r - kf * MATHF_PIO2_3;
+  r  = r - kf * MATHF_PIO2_4;
+  z  = r * r;
+
+  s  = ((-1.9515295891e-4F * z + 8.3321608736e-3F) * z -
+        1.6666654611e-1F) * z * r + r;
+  c  = ((2.443315711809948e-5F * z - 1.388731625493765e-3F) * z +
+        4.166664568298827e-2F) * z * z - 0.5F * z + 1.0F;
+
+  s  = (q & 1) != 0 ? c : s;
+  return (q & 2) != 0 ? -s : s;
+}
+
+/****************************************************************************
+ * Name: mathf_sincos
+ *
+ * Description:
+ *   Return sin(x) for quadrant 0 or cos(x) for quadrant 1, for any x.
+ *   Arguments beyond MATHF_SINCOS_LIMIT are reduced in double precision if
+ *   available, otherwise with fmodf() and a loss of accuracy that grows
+ *   with the magnitude of x.
+ *
+ ****************************************************************************/
+
+static inline float mathf_sincos(float x, int32_t quadrant)
+{
+  if (x <= MATHF_SINCOS_LIMIT && x >= -MATHF_SINCOS_LIMIT)
+    {
+      return mathf_sincos_kernel(x, quadrant);
+    }
+
+  if (isnan(x) || isinf_f(x))
+    {
+      return NAN_F;
+    }
+
+#ifdef CONFIG_HAVE_DOUBLE
+  return quadrant == 0 ? (float)sin((double)x) : (float)cos((double)x);
+#else
+  return mathf_sincos_kernel(fmodf(x, 2 * M_PI_F), quadrant);
+#endif
+}
+
+/****************************************************************************
+ * Name: mathf_vsincos
+ *
+ * Description:
+ *   Compute sin() (quadrant 0) or cos() (quadrant 1) of n elements.  If all
+ *   of the arguments are in the range of the kernel, which is the usual
+ *   case, the loop has no branches and can be vectorized by the compiler.
+ *   y may be the same array as x.
+ *
+ ****************************************************************************/
+
+static inline void mathf_vsincos(FAR float *y, FAR const float *x, size_t n,
+                                 int32_t quadrant)
+{
+  size_t nlarge = 0;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      nlarge += !(islessequal(x[i], MATHF_SINCOS_LIMIT) &
+                  islessequal(-MATHF_SINCOS_LIMIT, x[i]));
+    }
+
+  if (nlarge == 0)
+    {
+      for (i = 0; i < n; i++)
+        {
+          y[i] = mathf_sincos_kernel(x[i], quadrant);
+        }
+    }
+  else
+    {
+      for (i = 0; i < n; i++)
+        {
+          y[i] = mathf_sincos(x[i], quadrant);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mathf_exp_kernel
+ *
+ * Description:
+ *   Return exp(x) as 2^k * exp(r) with r = x - k * ln(2) in
+ *   [-ln(2)/2, ln(2)/2].  The error is at most 0.99 ULP over all x.  Large
+ *   arguments overflow to infinity and small ones underflow to zero; a NaN
+ *   argument returns a NaN.
+ *
+ ****************************************************************************/
+
+static inline float mathf_exp_kernel(float x)
+{
+  float xc;
+  float kf;
+  float r;
+  float p;
+  int32_t k;
+  int32_t k1;
+
+  /* Clamp x (a NaN becomes MATHF_EXP_MIN) so that k stays in range */
+
+  xc = x > MATHF_EXP_MIN ? x : MATHF_EXP_MIN;
+  xc = xc < MATHF_EXP_MAX ? xc : MATHF_EXP_MAX;
+
+  kf = xc * (float)M_LOG2E + MATHF_ROUND_SHIFT;
+  kf = kf - MATHF_ROUND_SHIFT;
+  k  = (int32_t)kf;
+
+  r  = xc - kf * MATHF_LN2_HI;
+  r  = r - kf * MATHF_LN2_LO;
+
+  p  = (((((1.9875691500e-4F * r + 1.3981999507e-3F) * r +
+           8.3334519073e-3F) * r + 4.1665795894e-2F) * r +
+           1.6666665459e-1F) * r + 5.0000001201e-1F) * r * r + r + 1.0F;
+
+  /* Scale by 2^k in two steps so that each factor is a normal float */
+
+  k1 = k >> 1;
+  p  = p * mathf_asfloat((uint32_t)(k1 + 127) << 23) *
+           mathf_asfloat((uint32_t)(k - k1 + 127) << 23);
+
+  return x == x ? p : x;
+}
+
+/****************************************************************************
+ * Name: mathf_log_kernel
+ *
+ * Description:
+ *   Return log(x) as e * ln(2) + log(m) with x = m * 2^e and m in
+ *   [sqrt(1/2), sqrt(2)).  The error is at most 0.83 ULP over all x.  The
+ *   special cases are selected without branches:  log(0) is -infinity,
+ *   log(infinity) is infinity and a negative or NaN argument returns a NaN.
+ *
+ ****************************************************************************/
+
+static inline float mathf_log_kernel(float x)
+{
+  uint32_t ix;
+  int32_t e;
+  float xs;
+  float ef;
+  float f;
+  float z;
+  float y;
+
+  /* Normalize subnormal arguments */
+
+  xs = x < 1.17549435e-38F ? x * 8388608.0F : x;
+  ef = x < 1.17549435e-38F ? -23.0F : 0.0F;
+
+  /* Split off the exponent such that m is in [sqrt(1/2), sqrt(2)) */
+
+  ix = mathf_asuint(xs);
+  e  = (int32_t)(ix - 0x3f3504f3) >> 23;
+  f  = mathf_asfloat(ix - ((uint32_t)e << 23)) - 1.0F;
+  ef = ef + (float)e;
+
+  z  = f * f;
+  y  = ((((((((7.0376836292e-2F * f - 1.1514610310e-1F) * f +
+              1.1676998740e-1F) * f - 1.2420140846e-1F) * f +
+              1.4249322787e-1F) * f - 1.6668057665e-1F) * f +
+              2.0000714765e-1F) * f - 2.4999993993e-1F) * f +
+              3.3333331174e-1F) * f * z;
+
+  y  = y + MATHF_LN2_LO * ef - 0.5F * z;
+  y  = f + y + MATHF_LN2_HI * ef;
+
+  /* Special cases */
+
+  y  = x == INFINITY_F ? x : y;
+  y  = x == 0.0F ? -INFINITY_F : y;
+  return x < 0.0F || x != x ? NAN_F : y;
+}
+
+#endif /* __LIBS_LIBC_MATH_LIB_MATHF_H */
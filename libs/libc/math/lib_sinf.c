@@ -29,76 +29,40 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <nuttx/config.h>
+
+#include <stddef.h>
 #include <math.h>
 
+#include "lib_mathf.h"
+
 /****************************************************************************
- * Private Data
+ * Public Functions
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1 / 1! */
-  1.0 / 6.0,                    /* 1 / 3! */
-  1.0 / 120.0,                  /* 1 / 5! */
-  1.0 / 5040.0,                 /* 1 / 7! */
-  1.0 / 362880.0,               /* 1 / 9! */
-  1.0 / 39916800.0,             /* 1 / 11! */
-};
-
 /****************************************************************************
- * Public Functions
+ * Name: sinf
+ *
+ * Description:
+ *   Return the sine of x.  The error is at most 2.34 ULP for |x| <= 6400.
+ *
  ****************************************************************************/
 
 float sinf(float x)
 {
-  float x_squared;
-  float sin_x;
-  size_t i;
-
-  /* Move x to [-pi, pi) */
-
-  x = fmodf(x, 2 * M_PI_F);
-  if (x >= M_PI_F)
-    {
-      x -= 2 * M_PI_F;
-    }
-
-  if (x < -M_PI_F)
-    {
-      x += 2 * M_PI_F;
-    }
-
-  /* Move x to [-pi/2, pi/2) */
-
-  if (x >= M_PI_2_F)
-    {
-      x = M_PI_F - x;
-    }
-
-  if (x < -M_PI_2_F)
-    {
-      x = -M_PI_F - x;
-    }
-
-  x_squared = x * x;
-  sin_x = 0.0F;
-
-  /* Perform Taylor series approximation for sin(x) with six terms */
-
-  for (i = 0; i < 6; i++)
-    {
-      if (i % 2 == 0)
-        {
-          sin_x += x * _flt_inv_fact[i];
-        }
-      else
-        {
-          sin_x -= x * _flt_inv_fact[i];
-        }
+  return mathf_sincos(x, 0);
+}
 
-      x *= x_squared;
-    }
+/****************************************************************************
+ * Name: vsinf
+ *
+ * Description:
+ *   Compute the sine of n elements:  y[i] = sinf(x[i]).  y may be the
+ *   same array as x.
+ *
+ ****************************************************************************/
 
-  return sin_x;
+void vsinf(FAR float *y, FAR const float *x, size_t n)
+{
+  mathf_vsincos(y, x, n, 0);
 }
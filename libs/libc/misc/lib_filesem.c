@@ -47,10 +47,6 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 
-#ifdef CONFIG_SMP
-#  include <nuttx/irq.h>
-#endif
-
 #include "libc.h"
 
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
@@ -81,14 +77,13 @@ void lib_sem_initialize(FAR struct file_struct *stream)
 
 void lib_take_semaphore(FAR struct file_struct *stream)
 {
-#ifdef CONFIG_SMP
-  irqstate_t flags = enter_critical_section();
-#endif
-
   pid_t my_pid = getpid();
   int ret;
 
-  /* Do I already have the semaphore? */
+  /* Do I already have the semaphore?  Only the holder sets fs_holder to its
+   * own pid and it does so while holding the semaphore, so this check needs
+   * no critical section:  No other thread can see its pid here.
+   */
 
   if (stream->fs_holder == my_pid)
     {
@@ -116,10 +111,38 @@ void lib_take_semaphore(FAR struct file_struct *stream)
       stream->fs_holder = my_pid;
       stream->fs_counts = 1;
     }
+}
+
+/****************************************************************************
+ * lib_trytake_semaphore
+ ****************************************************************************/
 
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
+int lib_trytake_semaphore(FAR struct file_struct *stream)
+{
+  pid_t my_pid = getpid();
+
+  /* Do I already have the semaphore? */
+
+  if (stream->fs_holder == my_pid)
+    {
+      /* Yes, just increment the number of references that I have */
+
+      stream->fs_counts++;
+    }
+  else
+    {
+      /* Take the semaphore if nobody holds it */
+
+      if (_SEM_TRYWAIT(&stream->fs_sem) < 0)
+        {
+          return -EAGAIN;
+        }
+
+      stream->fs_holder = my_pid;
+      stream->fs_counts = 1;
+    }
+
+  return OK;
 }
 
 /****************************************************************************
@@ -128,10 +151,6 @@ void lib_take_semaphore(FAR struct file_struct *stream)
 
 void lib_give_semaphore(FAR struct file_struct *stream)
 {
-#ifdef CONFIG_SMP
-  irqstate_t flags = enter_critical_section();
-#endif
-
   /* I better be holding at least one reference to the semaphore */
 
   DEBUGASSERT(stream->fs_holder == getpid());
@@ -152,10 +171,6 @@ void lib_give_semaphore(FAR struct file_struct *stream)
       stream->fs_counts = 0;
       DEBUGVERIFY(_SEM_POST(&stream->fs_sem));
     }
-
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
 }
 
 #endif /* CONFIG_STDIO_DISABLE_BUFFERING */
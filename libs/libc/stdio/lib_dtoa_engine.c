@@ -54,6 +54,11 @@
 #define MIN_MANT_INT  ((uint64_t)MIN_MANT)
 #define MIN_MANT_EXP  DBL_DIG
 
+/* The mantissa is converted to decimal in halves of this many digits */
+
+#define DTOA_HALF_DIGITS 8
+#define DTOA_HALF_DIV    100000000
+
 #define MAX(a, b)     ((a) > (b) ? (a) : (b))
 #define MIN(a, b)     ((a) < (b) ? (a) : (b))
 
@@ -148,6 +153,40 @@ int __dtoa_engine(double x, FAR struct dtoa_s *dtoa, int max_digits,
       /* Now convert mantissa to decimal. */
 
       uint64_t mant = (uint64_t) x;
+
+#if MIN_MANT_EXP < DTOA_HALF_DIGITS * 2
+      /* The mantissa has at most 16 digits.  Split it into two halves of
+       * eight digits which are then converted with 32-bit arithmetic and
+       * divisions by a constant:  A 64-bit division is a slow library call
+       * on most 32-bit targets.
+       */
+
+      char digits[2 * DTOA_HALF_DIGITS];
+      uint32_t half;
+      int j;
+
+      half = (uint32_t)(mant / DTOA_HALF_DIV);
+      for (j = DTOA_HALF_DIGITS - 1; j >= 0; j--)
+        {
+          digits[j] = half % 10 + '0';
+          half /= 10;
+        }
+
+      half = (uint32_t)(mant % DTOA_HALF_DIV);
+      for (j = 2 * DTOA_HALF_DIGITS - 1; j >= DTOA_HALF_DIGITS; j--)
+        {
+          digits[j] = half % 10 + '0';
+          half /= 10;
+        }
+
+      /* Skip the leading zeros if the mantissa has less than 16 digits */
+
+      j = 2 * DTOA_HALF_DIGITS - (MIN_MANT_EXP + 1);
+      for (i = 0; i < max_digits; i++)
+        {
+          dtoa->digits[i] = digits[j + i];
+        }
+#else
       uint64_t decimal = MIN_MANT_INT;
 
       /* Compute digits */
@@ -158,6 +197,7 @@ int __dtoa_engine(double x, FAR struct dtoa_s *dtoa, int max_digits,
           mant %= decimal;
           decimal /= 10;
         }
+#endif
     }
 
   dtoa->digits[max_digits] = '\0';
@@ -101,3 +101,50 @@ int fflush(FAR FILE *stream)
 
   return OK;
 }
+
+/****************************************************************************
+ * Name: fflush_unlocked
+ *
+ * Description:
+ *  The same as fflush() but the caller must hold the lock of the stream,
+ *  see flockfile().
+ *
+ * Returned Value:
+ *  OK on success EOF on failure (with errno set appropriately)
+ *
+ ****************************************************************************/
+
+int fflush_unlocked(FAR FILE *stream)
+{
+  int ret;
+
+  /* Is the stream argument NULL? */
+
+  if (!stream)
+    {
+      /* Yes... then this is a request to flush all streams */
+
+      ret = lib_flushall(nxsched_get_streams());
+    }
+  else
+    {
+      ret = lib_fflush_unlocked(stream, true);
+    }
+
+  /* Check the return value */
+
+  if (ret < 0)
+    {
+      /* An error occurred during the flush AND/OR we were unable to flush
+       * all of the buffered write data. Set the errno value.
+       */
+
+      set_errno(-ret);
+
+      /* And return EOF on failure. */
+
+      return EOF;
+    }
+
+  return OK;
+}
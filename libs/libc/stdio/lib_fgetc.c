@@ -44,6 +44,26 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * fgetc_unlocked
+ ****************************************************************************/
+
+int fgetc_unlocked(FAR FILE *stream)
+{
+  unsigned char ch;
+  ssize_t ret;
+
+  ret = lib_fread_unlocked(&ch, 1, stream);
+  if (ret > 0)
+    {
+      return ch;
+    }
+  else
+    {
+      return EOF;
+    }
+}
+
 /****************************************************************************
  * fgetc
  ****************************************************************************/
@@ -0,0 +1,96 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_flockfile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <assert.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: flockfile
+ *
+ * Description:
+ *   Take the lock of a stream, waiting if another thread holds it.  The
+ *   lock is recursive.  While the lock is held, the *_unlocked functions
+ *   may be used on the stream without the cost of locking each call.
+ *
+ * Input Parameters:
+ *   stream - The stream to be locked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void flockfile(FAR FILE *stream)
+{
+  DEBUGASSERT(stream != NULL);
+  lib_take_semaphore(stream);
+}
+
+/****************************************************************************
+ * Name: ftrylockfile
+ *
+ * Description:
+ *   Take the lock of a stream if no other thread holds it.
+ *
+ * Input Parameters:
+ *   stream - The stream to be locked
+ *
+ * Returned Value:
+ *   Zero if the lock was taken, non-zero otherwise.
+ *
+ ****************************************************************************/
+
+int ftrylockfile(FAR FILE *stream)
+{
+  DEBUGASSERT(stream != NULL);
+  return lib_trytake_semaphore(stream) < 0 ? -1 : 0;
+}
+
+/****************************************************************************
+ * Name: funlockfile
+ *
+ * Description:
+ *   Release the lock of a stream taken with flockfile() or ftrylockfile().
+ *
+ * Input Parameters:
+ *   stream - The stream to be unlocked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void funlockfile(FAR FILE *stream)
+{
+  DEBUGASSERT(stream != NULL);
+  lib_give_semaphore(stream);
+}
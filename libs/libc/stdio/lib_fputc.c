@@ -38,6 +38,8 @@
  ****************************************************************************/
 
 #include <stdio.h>
+#include <errno.h>
+
 #include "libc.h"
 
 /****************************************************************************
@@ -45,22 +47,22 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: fputc
+ * Name: fputc_unlocked
  ****************************************************************************/
 
-int fputc(int c, FAR FILE *stream)
+int fputc_unlocked(int c, FAR FILE *stream)
 {
   unsigned char buf = (unsigned char)c;
   int ret;
 
-  ret = lib_fwrite(&buf, 1, stream);
+  ret = lib_fwrite_unlocked(&buf, 1, stream);
   if (ret > 0)
     {
       /* Flush the buffer if a newline is output */
 
       if (c == '\n' && (stream->fs_flags & __FS_FLAG_LBF) != 0)
         {
-          ret = lib_fflush(stream, true);
+          ret = lib_fflush_unlocked(stream, true);
           if (ret < 0)
             {
               return EOF;
@@ -74,3 +76,26 @@ int fputc(int c, FAR FILE *stream)
       return EOF;
     }
 }
+
+/****************************************************************************
+ * Name: fputc
+ ****************************************************************************/
+
+int fputc(int c, FAR FILE *stream)
+{
+  int ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return EOF;
+    }
+
+  /* Write the character and flush the line with one lock of the stream */
+
+  lib_take_semaphore(stream);
+  ret = fputc_unlocked(c, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -71,22 +71,26 @@
 
 int fseek(FAR FILE *stream, long int offset, int whence)
 {
-#ifdef CONFIG_DEBUG_FEATURES
-  /* Verify that we were provided with a stream */
+  int ret = OK;
 
-  if (!stream)
+  /* Verify that we were provided with a stream before it is locked */
+
+  if (stream == NULL)
     {
       set_errno(EBADF);
       return ERROR;
     }
-#endif
+
+  /* Get exclusive access to the stream */
+
+  lib_take_semaphore(stream);
 
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
-  /* Flush any valid read/write data in the buffer (also verifies stream) */
+  /* Flush any valid read/write data in the buffer */
 
   if (lib_rdflush(stream) < 0 || lib_wrflush(stream) < 0)
     {
-      return ERROR;
+      ret = ERROR;
     }
 #endif
 
@@ -98,5 +102,11 @@ int fseek(FAR FILE *stream, long int offset, int whence)
 
   /* Perform the fseek on the underlying file descriptor */
 
-  return lseek(stream->fs_fd, offset, whence) == (off_t)-1 ? ERROR : OK;
+  if (ret == OK && lseek(stream->fs_fd, offset, whence) == (off_t)-1)
+    {
+      ret = ERROR;
+    }
+
+  lib_give_semaphore(stream);
+  return ret;
 }
@@ -32,3 +32,8 @@ int getchar(void)
 {
   return fgetc(stdin);
 }
+
+int getchar_unlocked(void)
+{
+  return fgetc_unlocked(stdin);
+}
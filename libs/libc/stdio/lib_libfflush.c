@@ -54,12 +54,12 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fflush
+ * Name: lib_fflush_unlocked
  *
  * Description:
- *  The function lib_fflush() forces a write of all user-space buffered data for
- *  the given output or update stream via the stream's underlying write
- *  function.  The open status of the stream is unaffected.
+ *  The function lib_fflush_unlocked() forces a write of all user-space
+ *  buffered data for the given output or update stream via the stream's
+ *  underlying write function.  The open status of the stream is unaffected.
  *
  * Input Parameters:
  *  stream - the stream to flush
@@ -69,15 +69,18 @@
  *  A negated errno value on failure, otherwise the number of bytes remaining
  *  in the buffer.
  *
+ * Assumptions:
+ *  The caller holds the stream lock or otherwise knows that no other
+ *  thread uses the stream.
+ *
  ****************************************************************************/
 
-ssize_t lib_fflush(FAR FILE *stream, bool bforce)
+ssize_t lib_fflush_unlocked(FAR FILE *stream, bool bforce)
 {
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
   FAR const unsigned char *src;
   ssize_t bytes_written;
   ssize_t nbuffer;
-  int ret;
 
   /* Return EBADF if the file is not opened for writing */
 
@@ -86,18 +89,13 @@ ssize_t lib_fflush(FAR FILE *stream, bool bforce)
       return -EBADF;
     }
 
-  /* Make sure that we have exclusive access to the stream */
-
-  lib_take_semaphore(stream);
-
   /* Check if there is an allocated I/O buffer */
 
   if (stream->fs_bufstart == NULL)
     {
       /* No, then there can be nothing remaining in the buffer. */
 
-      ret = 0;
-      goto errout_with_sem;
+      return 0;
    }
 
   /* Make sure that the buffer holds valid data */
@@ -114,8 +112,7 @@ ssize_t lib_fflush(FAR FILE *stream, bool bforce)
            * remaining in the buffer."
            */
 
-          ret = 0;
-          goto errout_with_sem;
+          return 0;
         }
 
       /* How many bytes of write data are used in the buffer now */
@@ -137,8 +134,7 @@ ssize_t lib_fflush(FAR FILE *stream, bool bforce)
                */
 
               stream->fs_flags |= __FS_FLAG_ERROR;
-              ret = _NX_GETERRVAL(bytes_written);
-              goto errout_with_sem;
+              return _NX_GETERRVAL(bytes_written);
             }
 
           /* Handle partial writes.  fflush() must either return with
@@ -167,20 +163,35 @@ ssize_t lib_fflush(FAR FILE *stream, bool bforce)
        }
     }
 
-  /* Restore normal access to the stream and return the number of bytes
-   * remaining in the buffer.
-   */
+  /* Return the number of bytes remaining in the buffer */
 
-  lib_give_semaphore(stream);
   return stream->fs_bufpos - stream->fs_bufstart;
 
-errout_with_sem:
-  lib_give_semaphore(stream);
-  return ret;
-
 #else
   /* Return no bytes remaining in the buffer */
 
   return 0;
 #endif
 }
+
+/****************************************************************************
+ * Name: lib_fflush
+ *
+ * Description:
+ *  The same as lib_fflush_unlocked() but with exclusive access to the
+ *  stream.
+ *
+ ****************************************************************************/
+
+ssize_t lib_fflush(FAR FILE *stream, bool bforce)
+{
+  ssize_t ret;
+
+  /* Make sure that we have exclusive access to the stream */
+
+  lib_take_semaphore(stream);
+  ret = lib_fflush_unlocked(stream, bforce);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
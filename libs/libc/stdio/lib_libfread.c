@@ -40,10 +40,15 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fread
+ * Name: lib_fread_unlocked
+ *
+ * Description:
+ *   Read from a stream without taking the stream lock.  The caller must
+ *   hold the lock or otherwise know that no other thread uses the stream.
+ *
  ****************************************************************************/
 
-ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream)
 {
   FAR unsigned char *dest = (FAR unsigned char *)ptr;
   ssize_t bytes_read;
@@ -60,10 +65,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
     }
   else
     {
-      /* The stream must be stable until we complete the read */
-
-      lib_take_semaphore(stream);
-
 #if CONFIG_NUNGET_CHARS > 0
       /* First, re-read any previously ungotten characters */
 
@@ -96,7 +97,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
           ret = lib_wrflush(stream);
           if (ret < 0)
             {
-              lib_give_semaphore(stream);
               return ret;
             }
 
@@ -267,8 +267,6 @@ shortread:
         {
           stream->fs_flags |= __FS_FLAG_EOF;
         }
-
-      lib_give_semaphore(stream);
     }
 
   return count - remaining;
@@ -277,6 +275,28 @@ shortread:
 
 errout_with_errno:
   stream->fs_flags |= __FS_FLAG_ERROR;
-  lib_give_semaphore(stream);
   return -get_errno();
 }
+
+/****************************************************************************
+ * Name: lib_fread
+ ****************************************************************************/
+
+ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return 0;
+    }
+
+  /* The stream must be stable until we complete the read */
+
+  lib_take_semaphore(stream);
+  ret = lib_fread_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -55,10 +55,16 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fwrite
+ * Name: lib_fwrite_unlocked
+ *
+ * Description:
+ *   Write to a stream without taking the stream lock.  The caller must hold
+ *   the lock or otherwise know that no other thread uses the stream.
+ *
  ****************************************************************************/
 
-ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream)
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
 {
   FAR const unsigned char *start = ptr;
@@ -98,10 +104,6 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
      goto errout;
    }
 
-  /* Get exclusive access to the stream */
-
-  lib_take_semaphore(stream);
-
   /* If the buffer is currently being used for read access, then
    * discard all of the read-ahead data.  We do not support concurrent
    * buffered read/write access.
@@ -109,7 +111,7 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   if (lib_rdflush(stream) < 0)
     {
-      goto errout_with_semaphore;
+      goto errout;
     }
 
   /* Loop until all of the bytes have been buffered */
@@ -152,10 +154,10 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
         {
           /* Flush the buffered data to the IO stream */
 
-          int bytes_buffered = lib_fflush(stream, false);
+          int bytes_buffered = lib_fflush_unlocked(stream, false);
           if (bytes_buffered < 0)
             {
-              goto errout_with_semaphore;
+              goto errout;
             }
         }
     }
@@ -164,9 +166,6 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   ret = (uintptr_t)src - (uintptr_t)start;
 
-errout_with_semaphore:
-  lib_give_semaphore(stream);
-
 errout:
   if (ret < 0)
     {
@@ -187,3 +186,26 @@ errout:
   return ret;
 }
 #endif /* CONFIG_STDIO_DISABLE_BUFFERING */
+
+/****************************************************************************
+ * Name: lib_fwrite
+ ****************************************************************************/
+
+ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  /* Get exclusive access to the stream */
+
+  lib_take_semaphore(stream);
+  ret = lib_fwrite_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
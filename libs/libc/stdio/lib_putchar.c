@@ -32,3 +32,8 @@ int putchar(int c)
 {
   return fputc(c, stdout);
 }
+
+int putchar_unlocked(int c)
+{
+  return fputc_unlocked(c, stdout);
+}
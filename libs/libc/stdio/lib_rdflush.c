@@ -59,6 +59,10 @@
  *   Flush read data from the I/O buffer and adjust the file pointer to
  *   account for the unread data
  *
+ * Assumptions:
+ *   The caller holds the stream lock or otherwise knows that no other
+ *   thread uses the stream.
+ *
  ****************************************************************************/
 
 int lib_rdflush(FAR FILE *stream)
@@ -78,10 +82,6 @@ int lib_rdflush(FAR FILE *stream)
       return OK;
     }
 
-  /* Get exclusive access to the stream */
-
-  lib_take_semaphore(stream);
-
   /* If the buffer is currently being used for read access, then discard all
    * of the read-ahead data.  We do not support concurrent buffered read/write
    * access.
@@ -110,12 +110,10 @@ int lib_rdflush(FAR FILE *stream)
 
       if (fseek(stream, -rdoffset, SEEK_CUR) < 0)
         {
-          lib_give_semaphore(stream);
           return ERROR;
         }
     }
 
-  lib_give_semaphore(stream);
   return OK;
 }
 
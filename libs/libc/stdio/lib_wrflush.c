@@ -56,6 +56,10 @@
  *   This is simply a version of fflush that does not report an error if
  *   the file is not open for writing.
  *
+ * Assumptions:
+ *   The caller holds the stream lock or otherwise knows that no other
+ *   thread uses the stream.
+ *
  ****************************************************************************/
 
 int lib_wrflush(FAR FILE *stream)
@@ -97,7 +101,7 @@ int lib_wrflush(FAR FILE *stream)
    * buffered write data was successfully flushed by lib_fflush().
    */
 
-  return lib_fflush(stream, true);
+  return lib_fflush_unlocked(stream, true);
 
 #else
   /* Verify that we were passed a valid (i.e., non-NULL) stream */
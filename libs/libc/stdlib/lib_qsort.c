@@ -47,6 +47,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
 /****************************************************************************
@@ -85,6 +86,18 @@
 
 #define vecswap(a, b, n) if ((n) > 0) swapfunc(a, b, n, swaptype)
 
+/* Arrays smaller than this are sorted by insertion sort */
+
+#define QSORT_INSERTION_THRESHOLD 7
+
+/* When a partition swaps no elements, the parts are probably (nearly)
+ * sorted.  An insertion sort is then tried on them, but it gives up after
+ * this many swaps so that parts that only look sorted cannot make the sort
+ * quadratic.
+ */
+
+#define QSORT_PARTIAL_LIMIT 8
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -93,6 +106,9 @@ static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype);
 static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
                              CODE int (*compar)(FAR const void *,
                              FAR const void *));
+static void qsort_intro(FAR char *base, size_t nel, size_t width,
+                        CODE int (*compar)(FAR const void *,
+                        FAR const void *), int depth);
 
 /****************************************************************************
  * Private Functions
@@ -119,51 +135,81 @@ static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
          (compar(b, c) > 0 ? b : (compar(a, c) < 0 ? a : c));
 }
 
-/****************************************************************************
- * Public Function
- ****************************************************************************/
+static void qsort_siftdown(FAR char *base, size_t root, size_t nel,
+                           size_t width, int swaptype,
+                           CODE int (*compar)(FAR const void *,
+                           FAR const void *))
+{
+  size_t child;
 
-/****************************************************************************
- * Name: qsort
- *
- * Description:
- *   The qsort() function will sort an array of 'nel' objects, the initial
- *   element of which is pointed to by 'base'. The size of each object, in
- *   bytes, is specified by the 'width" argument. If the 'nel' argument has
- *   the value zero, the comparison function pointed to by 'compar' will not
- *   be called and no rearrangement will take place.
- *
- *   The application will ensure that the comparison function pointed to by
- *   'compar' does not alter the contents of the array. The implementation
- *   may reorder elements of the array between calls to the comparison
- *   function, but will not alter the contents of any individual element.
- *
- *   When the same objects (consisting of 'width" bytes, irrespective of
- *   their current positions in the array) are passed more than once to
- *   the comparison function, the results will be consistent with one
- *   another. That is, they will define a total ordering on the array.
- *
- *   The contents of the array will be sorted in ascending order according
- *   to a comparison function. The 'compar' argument is a pointer to the
- *   comparison function, which is called with two arguments that point to
- *   the elements being compared. The application will ensure that the
- *   function returns an integer less than, equal to, or greater than 0,
- *   if the first argument is considered respectively less than, equal to,
- *   or greater than the second. If two members compare as equal, their
- *   order in the sorted array is unspecified.
- *
- *   (Based on description from OpenGroup.org).
- *
- * Returned Value:
- *   The qsort() function will not return a value.
- *
- * Notes from the original BSD version:
- *   Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
- *
- ****************************************************************************/
+  while ((child = 2 * root + 1) < nel)
+    {
+      if (child + 1 < nel &&
+          compar(base + child * width, base + (child + 1) * width) < 0)
+        {
+          child++;
+        }
 
-void qsort(FAR void *base, size_t nel, size_t width,
-           CODE int(*compar)(FAR const void *, FAR const void *))
+      if (compar(base + root * width, base + child * width) >= 0)
+        {
+          break;
+        }
+
+      swap(base + root * width, base + child * width);
+      root = child;
+    }
+}
+
+static void qsort_heapsort(FAR char *base, size_t nel, size_t width,
+                           int swaptype,
+                           CODE int (*compar)(FAR const void *,
+                           FAR const void *))
+{
+  size_t i;
+
+  for (i = nel / 2; i > 0; i--)
+    {
+      qsort_siftdown(base, i - 1, nel, width, swaptype, compar);
+    }
+
+  for (i = nel - 1; i > 0; i--)
+    {
+      swap(base, base + i * width);
+      qsort_siftdown(base, 0, i, width, swaptype, compar);
+    }
+}
+
+/* Insertion sort.  If limit is not zero, give up after that many swaps and
+ * return false.
+ */
+
+static bool qsort_insertion(FAR char *base, size_t nel, size_t width,
+                            int swaptype, int limit,
+                            CODE int (*compar)(FAR const void *,
+                            FAR const void *))
+{
+  FAR char *pm;
+  FAR char *pl;
+  int nswaps = 0;
+
+  for (pm = base + width; pm < base + nel * width; pm += width)
+    {
+      for (pl = pm; pl > base && compar(pl - width, pl) > 0; pl -= width)
+        {
+          swap(pl, pl - width);
+          if (limit > 0 && ++nswaps > limit)
+            {
+              return false;
+            }
+        }
+    }
+
+  return true;
+}
+
+static void qsort_intro(FAR char *base, size_t nel, size_t width,
+                        CODE int (*compar)(FAR const void *,
+                        FAR const void *), int depth)
 {
   FAR char *pa;
   FAR char *pb;
@@ -172,6 +218,8 @@ void qsort(FAR void *base, size_t nel, size_t width,
   FAR char *pl;
   FAR char *pm;
   FAR char *pn;
+  size_t nleft;
+  size_t nright;
   int swaptype;
   int swap_cnt;
   int d;
@@ -181,28 +229,25 @@ loop:
   SWAPINIT(base, width);
   swap_cnt = 0;
 
-  if (nel < 7)
+  if (nel < QSORT_INSERTION_THRESHOLD)
     {
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
-        {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
-            {
-              swap(pl, pl - width);
-            }
-        }
+      qsort_insertion(base, nel, width, swaptype, 0, compar);
+      return;
+    }
+
+  /* Too many unbalanced partitions?  Then heapsort what remains. */
 
+  if (depth-- <= 0)
+    {
+      qsort_heapsort(base, nel, width, swaptype, compar);
       return;
-  }
+    }
 
-  pm = (FAR char *)base + (nel / 2) * width;
+  pm = base + (nel / 2) * width;
   if (nel > 7)
     {
       pl = base;
-      pn = (FAR char *)base + (nel - 1) * width;
+      pn = base + (nel - 1) * width;
       if (nel > 40)
         {
           d  = (nel / 8) * width;
@@ -215,9 +260,9 @@ loop:
     }
 
   swap(base, pm);
-  pa = pb = (FAR char *)base + width;
+  pa = pb = base + width;
 
-  pc = pd = (FAR char *)base + (nel - 1) * width;
+  pc = pd = base + (nel - 1) * width;
   for (; ; )
     {
       while (pb <= pc && (r = compar(pb, base)) <= 0)
@@ -255,43 +300,124 @@ loop:
       pc      -= width;
     }
 
+  pn = base + nel * width;
+  r  = min(pa - base, pb - pa);
+  vecswap(base, pb - r, r);
+
+  r  = min(pd - pc, pn - pd - width);
+  vecswap(pb, pn - r, r);
+
+  nleft  = (pb - pa) / width;
+  nright = (pd - pc) / width;
+
+  /* If the partition swapped no elements, the parts are probably already
+   * (nearly) sorted.  Try to finish them with a bounded insertion sort.
+   */
+
   if (swap_cnt == 0)
     {
-      /* Switch to insertion sort */
-
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      if (qsort_insertion(base, nleft, width, swaptype,
+                          QSORT_PARTIAL_LIMIT, compar))
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
-            {
-              swap(pl, pl - width);
-            }
+          nleft = 0;
         }
 
-      return;
+      if (qsort_insertion(pn - nright * width, nright, width, swaptype,
+                          QSORT_PARTIAL_LIMIT, compar))
+        {
+          nright = 0;
+        }
     }
 
-  pn = (FAR char *)base + nel * width;
-  r  = min(pa - (FAR char *)base, pb - pa);
-  vecswap(base, pb - r, r);
+  /* Recurse into the smaller part and iterate over the larger one.  This
+   * bounds the stack usage to O(log n).
+   */
 
-  r  = min(pd - pc, pn - pd - width);
-  vecswap(pb, pn - r, r);
+  if (nleft < nright)
+    {
+      if (nleft > 1)
+        {
+          qsort_intro(base, nleft, width, compar, depth);
+        }
 
-  if ((r = pb - pa) > width)
+      base = pn - nright * width;
+      nel  = nright;
+    }
+  else
     {
-      qsort(base, r / width, width, compar);
+      if (nright > 1)
+        {
+          qsort_intro(pn - nright * width, nright, width, compar, depth);
+        }
+
+      nel = nleft;
     }
 
-  if ((r = pd - pc) > width)
+  if (nel > 1)
     {
-      /* Iterate rather than recurse to save stack space */
-
-      base = pn - r;
-      nel = r / width;
       goto loop;
     }
 }
+
+/****************************************************************************
+ * Public Function
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: qsort
+ *
+ * Description:
+ *   The qsort() function will sort an array of 'nel' objects, the initial
+ *   element of which is pointed to by 'base'. The size of each object, in
+ *   bytes, is specified by the 'width" argument. If the 'nel' argument has
+ *   the value zero, the comparison function pointed to by 'compar' will not
+ *   be called and no rearrangement will take place.
+ *
+ *   The application will ensure that the comparison function pointed to by
+ *   'compar' does not alter the contents of the array. The implementation
+ *   may reorder elements of the array between calls to the comparison
+ *   function, but will not alter the contents of any individual element.
+ *
+ *   When the same objects (consisting of 'width" bytes, irrespective of
+ *   their current positions in the array) are passed more than once to
+ *   the comparison function, the results will be consistent with one
+ *   another. That is, they will define a total ordering on the array.
+ *
+ *   The contents of the array will be sorted in ascending order according
+ *   to a comparison function. The 'compar' argument is a pointer to the
+ *   comparison function, which is called with two arguments that point to
+ *   the elements being compared. The application will ensure that the
+ *   function returns an integer less than, equal to, or greater than 0,
+ *   if the first argument is considered respectively less than, equal to,
+ *   or greater than the second. If two members compare as equal, their
+ *   order in the sorted array is unspecified.
+ *
+ *   (Based on description from OpenGroup.org).
+ *
+ * Returned Value:
+ *   The qsort() function will not return a value.
+ *
+ * Notes from the original BSD version:
+ *   Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ *
+ *   The quicksort is an introsort:  If the partitions get too unbalanced,
+ *   the remaining part is sorted by heapsort.  The worst case is then
+ *   O(n log n).
+ *
+ ****************************************************************************/
+
+void qsort(FAR void *base, size_t nel, size_t width,
+           CODE int(*compar)(FAR const void *, FAR const void *))
+{
+  size_t n;
+  int depth = 0;
+
+  /* Allow 2 * log2(nel) levels of partitioning before heapsort */
+
+  for (n = nel; n > 1; n >>= 1)
+    {
+      depth += 2;
+    }
+
+  qsort_intro(base, nel, width, compar, depth);
+}
@@ -40,6 +40,8 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <ctype.h>
 #include <errno.h>
@@ -50,20 +52,86 @@
  * Pre-processor definitions
  ****************************************************************************/
 
-/* These are predefined with GCC, but could be issues for other compilers. If
- * not defined, an arbitrary big number is put in for now.  These should be
- * added to nuttx/compiler for your compiler.
+/* The digits are accumulated in an integer mantissa as long as another digit
+ * cannot overflow it.  Up to STRTOD_EXTRA_DIGITS further digits are kept
+ * for the correction step, the remaining ones only scale the result and
+ * break ties.
  */
 
-#if !defined(__DBL_MIN_EXP__) || !defined(__DBL_MAX_EXP__)
-#  ifdef CONFIG_CPP_HAVE_WARNING
-#    warning "Size of exponent is unknown"
-#  endif
-#  undef  __DBL_MIN_EXP__
-#  define __DBL_MIN_EXP__ (-1021)
-#  undef  __DBL_MAX_EXP__
-#  define __DBL_MAX_EXP__ (1024)
-#endif
+#define STRTOD_MANT_LIMIT   ((UINT64_MAX - 9) / 10)
+#define STRTOD_EXTRA_DIGITS 19
+
+/* The largest integer and the largest power of ten that are exactly
+ * representable in a double.  If both the mantissa and the power of ten are
+ * exact, a single multiplication or division gives the correctly rounded
+ * result.
+ */
+
+#define STRTOD_EXACT_MANT  ((uint64_t)1 << 53)
+#define STRTOD_EXACT_POW10 22
+
+/* A mantissa of at most 19 digits times 10^exponent overflows above this
+ * exponent and is less than half of the smallest subnormal below the
+ * other.
+ */
+
+#define STRTOD_MAX_EXP10   308
+#define STRTOD_MIN_EXP10   (-343)
+
+/* The correction step compares the decimal value with the midpoint between
+ * two doubles as big integers.  The largest of them is the midpoint times
+ * 5^362, less than 900 bits.
+ */
+
+#define STRTOD_BIG_WORDS   32
+
+/* 5^13 is the largest power of five that fits into 32 bits */
+
+#define STRTOD_POW5_13     1220703125u
+#define STRTOD_POW10_9     1000000000u
+
+/* The double bit patterns used by the correction step */
+
+#define STRTOD_FRAC_BITS   52
+#define STRTOD_FRAC_MASK   (((uint64_t)1 << STRTOD_FRAC_BITS) - 1)
+#define STRTOD_INF_BITS    ((uint64_t)0x7ff << STRTOD_FRAC_BITS)
+#define STRTOD_MIN_NORMAL  ((uint64_t)1 << STRTOD_FRAC_BITS)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Little-endian big integer */
+
+struct strtod_big_s
+{
+  uint32_t word[STRTOD_BIG_WORDS];
+  int nwords;
+};
+
+/* Union which permits us to convert between a double and its bits */
+
+union strtod_shape_u
+{
+  double   value;
+  uint64_t bits;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const double g_strtod_pow10[STRTOD_EXACT_POW10 + 1] =
+{
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const uint32_t g_strtod_pow5[13] =
+{
+  1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625,
+  48828125, 244140625
+};
 
 /****************************************************************************
  * Private Functions
@@ -75,6 +143,458 @@ static inline int is_real(double x)
   return (x < infinite) && (x >= -infinite);
 }
 
+static inline int is_normal(double x)
+{
+  union strtod_shape_u u;
+
+  u.value = x;
+  return (u.bits & STRTOD_INF_BITS) != 0;
+}
+
+/****************************************************************************
+ * Name: strtod_big_set
+ *
+ * Description:
+ *   Set a big integer to a 64-bit value.
+ *
+ ****************************************************************************/
+
+static void strtod_big_set(FAR struct strtod_big_s *big, uint64_t value)
+{
+  big->word[0] = (uint32_t)value;
+  big->word[1] = (uint32_t)(value >> 32);
+  big->nwords  = big->word[1] != 0 ? 2 : 1;
+}
+
+/****************************************************************************
+ * Name: strtod_big_mul
+ *
+ * Description:
+ *   Multiply a big integer by a 32-bit factor.
+ *
+ ****************************************************************************/
+
+static void strtod_big_mul(FAR struct strtod_big_s *big, uint32_t factor)
+{
+  uint64_t carry = 0;
+  int i;
+
+  for (i = 0; i < big->nwords; i++)
+    {
+      carry        += (uint64_t)big->word[i] * factor;
+      big->word[i]  = (uint32_t)carry;
+      carry       >>= 32;
+    }
+
+  if (carry != 0)
+    {
+      big->word[big->nwords++] = (uint32_t)carry;
+    }
+}
+
+/****************************************************************************
+ * Name: strtod_big_add
+ *
+ * Description:
+ *   Add a 64-bit value to a big integer.
+ *
+ ****************************************************************************/
+
+static void strtod_big_add(FAR struct strtod_big_s *big, uint64_t value)
+{
+  uint64_t carry = value;
+  int i;
+
+  for (i = 0; i < big->nwords && carry != 0; i++)
+    {
+      carry        += big->word[i];
+      big->word[i]  = (uint32_t)carry;
+      carry       >>= 32;
+    }
+
+  while (carry != 0)
+    {
+      big->word[big->nwords++] = (uint32_t)carry;
+      carry >>= 32;
+    }
+}
+
+/****************************************************************************
+ * Name: strtod_big_mulpow5
+ *
+ * Description:
+ *   Multiply a big integer by 5^n.
+ *
+ ****************************************************************************/
+
+static void strtod_big_mulpow5(FAR struct strtod_big_s *big, int n)
+{
+  while (n >= 13)
+    {
+      strtod_big_mul(big, STRTOD_POW5_13);
+      n -= 13;
+    }
+
+  if (n > 0)
+    {
+      strtod_big_mul(big, g_strtod_pow5[n]);
+    }
+}
+
+/****************************************************************************
+ * Name: strtod_big_shl
+ *
+ * Description:
+ *   Multiply a big integer by 2^n.
+ *
+ ****************************************************************************/
+
+static void strtod_big_shl(FAR struct strtod_big_s *big, int n)
+{
+  int shift = n / 32;
+  int bits = n % 32;
+  int i;
+
+  if (bits != 0)
+    {
+      big->word[big->nwords] = 0;
+      for (i = big->nwords; i > 0; i--)
+        {
+          big->word[i] = (big->word[i] << bits) |
+                         (big->word[i - 1] >> (32 - bits));
+        }
+
+      big->word[0] <<= bits;
+      if (big->word[big->nwords] != 0)
+        {
+          big->nwords++;
+        }
+    }
+
+  if (shift != 0)
+    {
+      for (i = big->nwords - 1; i >= 0; i--)
+        {
+          big->word[i + shift] = big->word[i];
+        }
+
+      for (i = 0; i < shift; i++)
+        {
+          big->word[i] = 0;
+        }
+
+      big->nwords += shift;
+    }
+}
+
+/****************************************************************************
+ * Name: strtod_big_cmp
+ *
+ * Description:
+ *   Compare two big integers.  Returns <0, 0 or >0 like memcmp().
+ *
+ ****************************************************************************/
+
+static int strtod_big_cmp(FAR const struct strtod_big_s *a,
+                          FAR const struct strtod_big_s *b)
+{
+  int i;
+
+  if (a->nwords != b->nwords)
+    {
+      return a->nwords - b->nwords;
+    }
+
+  for (i = a->nwords - 1; i >= 0; i--)
+    {
+      if (a->word[i] != b->word[i])
+        {
+          return a->word[i] < b->word[i] ? -1 : 1;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: strtod_big_mul64
+ *
+ * Description:
+ *   Set a big integer to another one times a 64-bit factor.
+ *
+ ****************************************************************************/
+
+static void strtod_big_mul64(FAR struct strtod_big_s *dst,
+                             FAR const struct strtod_big_s *src,
+                             uint64_t factor)
+{
+  uint32_t lo = (uint32_t)factor;
+  uint32_t hi = (uint32_t)(factor >> 32);
+  uint64_t carry = 0;
+  int i;
+
+  for (i = 0; i < src->nwords; i++)
+    {
+      carry        += (uint64_t)src->word[i] * lo;
+      dst->word[i]  = (uint32_t)carry;
+      carry       >>= 32;
+    }
+
+  dst->word[i]     = (uint32_t)carry;
+  dst->word[i + 1] = 0;
+
+  /* Add the product with the upper half, one word up.  Each step is at
+   * most (2^32 - 1)^2 + 2 * (2^32 - 1), which fits into 64 bits.
+   */
+
+  carry = 0;
+  for (i = 0; i < src->nwords; i++)
+    {
+      carry            += (uint64_t)src->word[i] * hi + dst->word[i + 1];
+      dst->word[i + 1]  = (uint32_t)carry;
+      carry           >>= 32;
+    }
+
+  dst->word[i + 1] += (uint32_t)carry;
+
+  dst->nwords = src->nwords + 2;
+  while (dst->nwords > 1 && dst->word[dst->nwords - 1] == 0)
+    {
+      dst->nwords--;
+    }
+}
+
+/****************************************************************************
+ * Name: strtod_big_top
+ *
+ * Description:
+ *   Return the upper 64 bits of a non-zero big integer, shifted such that
+ *   bit 63 is set.  Bit 0 is set as well if any of the bits below is, so
+ *   that converting the result to double rounds like the big integer
+ *   would.  *shift receives the power of two of bit 0.
+ *
+ ****************************************************************************/
+
+static uint64_t strtod_big_top(FAR const struct strtod_big_s *big,
+                               FAR int *shift)
+{
+  uint64_t top;
+  uint32_t next;
+  bool sticky = false;
+  int n = big->nwords;
+  int i;
+
+  top  = (uint64_t)big->word[n - 1] << 32;
+  top |= n > 1 ? big->word[n - 2] : 0;
+  next = n > 2 ? big->word[n - 3] : 0;
+
+  for (i = n - 4; i >= 0 && !sticky; i--)
+    {
+      sticky = big->word[i] != 0;
+    }
+
+  *shift = 32 * (n - 2);
+  while ((top >> 63) == 0)
+    {
+      top   = (top << 1) | (next >> 31);
+      next <<= 1;
+      (*shift)--;
+    }
+
+  if (next != 0 || sticky)
+    {
+      top |= 1;
+    }
+
+  return top;
+}
+
+/****************************************************************************
+ * Name: strtod_pow2
+ *
+ * Description:
+ *   Return 2^n for n in the range of normal doubles.
+ *
+ ****************************************************************************/
+
+static double strtod_pow2(int n)
+{
+  union strtod_shape_u u;
+
+  u.bits = (uint64_t)(n + 1023) << STRTOD_FRAC_BITS;
+  return u.value;
+}
+
+/****************************************************************************
+ * Name: strtod_scale
+ *
+ * Description:
+ *   Return x * 2^n.  The result is rounded once, at the second
+ *   multiplication, if it is subnormal or overflows.
+ *
+ ****************************************************************************/
+
+static double strtod_scale(double x, int n)
+{
+  return x * strtod_pow2(n / 2) * strtod_pow2(n - n / 2);
+}
+
+/****************************************************************************
+ * Name: strtod_cmpmid
+ *
+ * Description:
+ *   Compare the decimal value num / den * 2^exponent with the midpoint
+ *   between the positive double given by its bits and the next larger one.
+ *
+ *   With the double being frac * 2^k, the midpoint is (2 * frac + 1) *
+ *   2^(k - 1).  Both sides are made integers by moving den and the powers
+ *   of two to the other side.
+ *
+ * Returned Value:
+ *   <0, 0 or >0 if the decimal value is less than, equal to or greater
+ *   than the midpoint.
+ *
+ ****************************************************************************/
+
+static int strtod_cmpmid(FAR const struct strtod_big_s *num,
+                         FAR const struct strtod_big_s *den,
+                         int exponent, uint64_t bits)
+{
+  struct strtod_big_s lhs;
+  struct strtod_big_s rhs;
+  uint64_t frac;
+  int shift;
+  int k;
+
+  frac = bits & STRTOD_FRAC_MASK;
+  k    = (int)(bits >> STRTOD_FRAC_BITS);
+  if (k == 0)
+    {
+      k = 1;
+    }
+  else
+    {
+      frac |= STRTOD_MIN_NORMAL;
+    }
+
+  k -= 1023 + STRTOD_FRAC_BITS;
+
+  lhs = *num;
+  strtod_big_mul64(&rhs, den, 2 * frac + 1);
+
+  shift = exponent - (k - 1);
+  if (shift > 0)
+    {
+      strtod_big_shl(&lhs, shift);
+    }
+  else
+    {
+      strtod_big_shl(&rhs, -shift);
+    }
+
+  return strtod_big_cmp(&lhs, &rhs);
+}
+
+/****************************************************************************
+ * Name: strtod_round
+ *
+ * Description:
+ *   Return the double nearest to the decimal value (mantissa * 10^nextra +
+ *   extra) * 10^exponent.  If the value is not an integer, an
+ *   approximation is moved up or down one unit in the last place at a time
+ *   until the value is within half a unit of it.  Ties go to the even
+ *   neighbour, unless non-zero digits were dropped, in which case the
+ *   decimal value is really a bit larger.
+ *
+ ****************************************************************************/
+
+static double strtod_round(uint64_t mantissa, uint64_t extra, int nextra,
+                           int exponent, bool dropped)
+{
+  struct strtod_big_s num;
+  struct strtod_big_s den;
+  union strtod_shape_u u;
+  uint64_t top;
+  double approx;
+  int shift;
+  int cmp;
+  int n;
+
+  /* The decimal value is num / den * 2^exponent with the power of five of
+   * 10^exponent in num or den.
+   */
+
+  strtod_big_set(&num, mantissa);
+  strtod_big_set(&den, 1);
+
+  if (nextra > 0)
+    {
+      n = nextra;
+      while (n > 9)
+        {
+          strtod_big_mul(&num, STRTOD_POW10_9);
+          n -= 9;
+        }
+
+      strtod_big_mul(&num, g_strtod_pow5[n] << n);
+      strtod_big_add(&num, extra);
+    }
+
+  /* With a positive exponent the value is the integer num * 2^exponent,
+   * which is converted directly.
+   */
+
+  if (exponent >= 0)
+    {
+      strtod_big_mulpow5(&num, exponent);
+      top = strtod_big_top(&num, &shift);
+      return strtod_scale((double)(top | dropped), shift + exponent);
+    }
+
+  /* Otherwise start with the quotient of the upper bits, which is off by a
+   * unit in the last place or two, and correct it.
+   */
+
+  strtod_big_mulpow5(&den, -exponent);
+
+  top     = strtod_big_top(&num, &shift);
+  approx  = (double)top;
+  top     = strtod_big_top(&den, &n);
+  approx /= (double)top;
+
+  u.value = strtod_scale(approx, shift - n + exponent);
+
+  for (; ; )
+    {
+      cmp = strtod_cmpmid(&num, &den, exponent, u.bits);
+      if (cmp > 0 || (cmp == 0 && (dropped || (u.bits & 1) != 0)))
+        {
+          if (++u.bits == STRTOD_INF_BITS)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      if (u.bits == 0)
+        {
+          break;
+        }
+
+      cmp = strtod_cmpmid(&num, &den, exponent, u.bits - 1);
+      if (cmp < 0 || (cmp == 0 && !dropped && (u.bits & 1) != 0))
+        {
+          u.bits--;
+          continue;
+        }
+
+      break;
+    }
+
+  return u.value;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -83,20 +603,24 @@ static inline int is_real(double x)
  * Name: strtod
  *
  * Description:
- *   Convert a string to a double value
+ *   Convert a string to a double value.  The result is correctly rounded
+ *   for up to 38 significant digits; further digits only break ties.
  *
  ****************************************************************************/
 
 double strtod(FAR const char *str, FAR char **endptr)
 {
   double number;
+  uint64_t mantissa;
+  uint64_t extra;
+  int nextra;
   int exponent;
   int negative;
+  bool minus;
+  bool dropped;
   FAR char *p = (FAR char *) str;
-  double p10;
   int n;
   int num_digits;
-  int num_decimals;
   const double infinite = 1.0/0.0;
 
   /* Skip leading whitespace */
@@ -121,16 +645,36 @@ double strtod(FAR const char *str, FAR char **endptr)
       break;
     }
 
-  number       = 0.;
+  mantissa     = 0;
   exponent     = 0;
   num_digits   = 0;
-  num_decimals = 0;
+  extra        = 0;
+  nextra       = 0;
+  dropped      = false;
 
   /* Process string of digits */
 
   while (isdigit(*p))
     {
-      number = number * 10. + (*p - '0');
+      if (mantissa < STRTOD_MANT_LIMIT)
+        {
+          mantissa = mantissa * 10 + (*p - '0');
+        }
+      else
+        {
+          if (nextra < STRTOD_EXTRA_DIGITS)
+            {
+              extra = extra * 10 + (*p - '0');
+              nextra++;
+            }
+          else
+            {
+              dropped |= *p != '0';
+            }
+
+          exponent++;
+        }
+
       p++;
       num_digits++;
     }
@@ -143,13 +687,24 @@ double strtod(FAR const char *str, FAR char **endptr)
 
       while (isdigit(*p))
         {
-          number = number * 10. + (*p - '0');
+          if (mantissa < STRTOD_MANT_LIMIT)
+            {
+              mantissa = mantissa * 10 + (*p - '0');
+              exponent--;
+            }
+          else if (nextra < STRTOD_EXTRA_DIGITS)
+            {
+              extra = extra * 10 + (*p - '0');
+              nextra++;
+            }
+          else
+            {
+              dropped |= *p != '0';
+            }
+
           p++;
           num_digits++;
-          num_decimals++;
         }
-
-      exponent -= num_decimals;
     }
 
   if (num_digits == 0)
@@ -159,12 +714,9 @@ double strtod(FAR const char *str, FAR char **endptr)
       goto errout;
     }
 
-  /* Correct for sign */
+  /* Remember the sign, it is applied to the result */
 
-  if (negative)
-    {
-      number = -number;
-    }
+  minus = negative;
 
   /* Process an exponent string */
 
@@ -185,12 +737,16 @@ double strtod(FAR const char *str, FAR char **endptr)
           break;
         }
 
-      /* Process string of digits */
+      /* Process string of digits, saturating absurdly large exponents */
 
       n = 0;
       while (isdigit(*p))
         {
-          n = n * 10 + (*p - '0');
+          if (n < 100000)
+            {
+              n = n * 10 + (*p - '0');
+            }
+
           p++;
         }
 
@@ -204,44 +760,72 @@ double strtod(FAR const char *str, FAR char **endptr)
         }
     }
 
-  if (exponent < __DBL_MIN_EXP__ ||
-      exponent > __DBL_MAX_EXP__)
+  /* Zero is exact whatever the exponent */
+
+  if (mantissa == 0)
+    {
+      number = 0.0;
+      goto errout_with_sign;
+    }
+
+  if (exponent > STRTOD_MAX_EXP10)
     {
       set_errno(ERANGE);
       number = infinite;
-      goto errout;
+      goto errout_with_sign;
     }
 
-  /* Scale the result */
+  if (exponent < STRTOD_MIN_EXP10)
+    {
+      set_errno(ERANGE);
+      number = 0.0;
+      goto errout_with_sign;
+    }
+
+  /* Move the excess of a large exponent into the mantissa while that
+   * keeps the mantissa exact, e.g. 1e25 becomes 1000e22.
+   */
 
-  p10 = 10.;
-  n = exponent;
-  if (n < 0)
+  while (exponent > STRTOD_EXACT_POW10 && mantissa <= STRTOD_EXACT_MANT / 10)
     {
-      n = -n;
+      mantissa *= 10;
+      exponent--;
     }
 
-  while (n)
+  /* Fast path:  The mantissa and the power of ten are both exact */
+
+  if (mantissa <= STRTOD_EXACT_MANT &&
+      exponent >= -STRTOD_EXACT_POW10 && exponent <= STRTOD_EXACT_POW10)
     {
-      if (n & 1)
+      number = (double)mantissa;
+      if (exponent < 0)
         {
-          if (exponent < 0)
-            {
-              number /= p10;
-            }
-          else
-            {
-              number *= p10;
-            }
+          number /= g_strtod_pow10[-exponent];
         }
+      else
+        {
+          number *= g_strtod_pow10[exponent];
+        }
+    }
+  else
+    {
+      /* Otherwise compute the nearest double from the exact value */
+
+      number = strtod_round(mantissa, extra, nextra, exponent - nextra,
+                            dropped);
+
+      /* Overflow to infinity and underflow to a subnormal or zero */
 
-      n >>= 1;
-      p10 *= p10;
+      if (!is_real(number) || !is_normal(number))
+        {
+          set_errno(ERANGE);
+        }
     }
 
-  if (!is_real(number))
+errout_with_sign:
+  if (minus)
     {
-      set_errno(ERANGE);
+      number = -number;
     }
 
 errout:
@@ -44,6 +44,8 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <ctype.h>
 #include <errno.h>
@@ -52,53 +54,131 @@
  * Pre-processor definitions
  ****************************************************************************/
 
-/* These are predefined with GCC, but could be issues for other compilers. If
- * not defined, an arbitrary big number is put in for now.  These should be
- * added to nuttx/compiler for your compiler.
+/* The bits of the exponent of a float */
+
+#define STRTOF_EXP_MASK    0x7f800000u
+
+#ifndef CONFIG_HAVE_DOUBLE
+
+/* The digits are accumulated in an integer mantissa as long as another digit
+ * cannot overflow it.  The remaining digits only scale the result.
+ */
+
+#define STRTOF_MANT_LIMIT  ((UINT32_MAX - 9) / 10)
+
+/* The largest integer and the largest power of ten that are exactly
+ * representable in a float.  If both the mantissa and the power of ten are
+ * exact, a single multiplication or division gives the correctly rounded
+ * result.
  */
 
-#if !defined(__FLT_MIN_EXP__) || !defined(__FLT_MAX_EXP__)
-#  ifdef CONFIG_CPP_HAVE_WARNING
-#    warning "Size of exponent is unknown"
-#  endif
-#  undef  __FLT_MIN_EXP__
-#  define __FLT_MIN_EXP__ (-125)
-#  undef  __FLT_MAX_EXP__
-#  define __FLT_MAX_EXP__ (128)
+#define STRTOF_EXACT_MANT  ((uint32_t)1 << 24)
+#define STRTOF_EXACT_POW10 10
+
+/* A mantissa of at most 10 digits times 10^exponent overflows above this
+ * exponent and is less than half of the smallest subnormal below the
+ * other.
+ */
+
+#define STRTOF_MAX_EXP10   38
+#define STRTOF_MIN_EXP10   (-55)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Union which permits us to convert between a float and its bits */
+
+union strtof_shape_u
+{
+  float    value;
+  uint32_t bits;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifndef CONFIG_HAVE_DOUBLE
+static const float g_strtof_pow10[STRTOF_EXACT_POW10 + 1] =
+{
+  1e0F, 1e1F, 1e2F, 1e3F, 1e4F, 1e5F, 1e6F, 1e7F, 1e8F, 1e9F, 1e10F
+};
 #endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static inline int is_real(float x)
+/* Return true if x is finite and neither zero nor subnormal */
+
+static inline bool is_normal(float x)
 {
-  const float infinite = 1.0F/0.0F;
-  return (x < infinite) && (x >= -infinite);
+  union strtof_shape_u u;
+
+  u.value = x;
+  u.bits &= STRTOF_EXP_MASK;
+  return u.bits != 0 && u.bits != STRTOF_EXP_MASK;
 }
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_HAVE_DOUBLE
+/***************************************************(************************
+ * Name: strtof
+ *
+ * Description:
+ *   Convert a string to a float value.  The string is converted to the
+ *   nearest double, which is then rounded to float.  This is the correctly
+ *   rounded float unless the double falls exactly halfway between two
+ *   floats while the decimal value does not, which happens for about one
+ *   input in 2^29.
+ *
+ ****************************************************************************/
+
+float strtof(FAR const char *str, FAR char **endptr)
+{
+  double number;
+  float result;
+
+  number = strtod(str, endptr);
+  result = (float)number;
+
+  /* Overflow to infinity and underflow to a subnormal or zero */
+
+  if (number != 0.0 && !is_normal(result))
+    {
+      set_errno(ERANGE);
+    }
+
+  return result;
+}
+
+#else
 /***************************************************(************************
  * Name: strtof
  *
  * Description:
- *   Convert a string to a float value
+ *   Convert a string to a float value.  Without double precision support
+ *   the result is scaled in float and may be off by a few units in the
+ *   last place.
  *
  ****************************************************************************/
 
 float strtof(FAR const char *str, FAR char **endptr)
 {
   float number;
+  uint32_t mantissa;
   int exponent;
   int negative;
+  bool minus;
   FAR char *p = (FAR char *) str;
   float p10;
   int n;
   int num_digits;
-  int num_decimals;
   const float infinite = 1.0F/0.0F;
 
   /* Skip leading whitespace */
@@ -123,16 +203,23 @@ float strtof(FAR const char *str, FAR char **endptr)
       break;
     }
 
-  number       = 0.0F;
+  mantissa     = 0;
   exponent     = 0;
   num_digits   = 0;
-  num_decimals = 0;
 
   /* Process string of digits */
 
   while (isdigit(*p))
     {
-      number = number * 10.0F + (float)(*p - '0');
+      if (mantissa < STRTOF_MANT_LIMIT)
+        {
+          mantissa = mantissa * 10 + (*p - '0');
+        }
+      else
+        {
+          exponent++;
+        }
+
       p++;
       num_digits++;
     }
@@ -145,13 +232,15 @@ float strtof(FAR const char *str, FAR char **endptr)
 
       while (isdigit(*p))
         {
-          number = number * 10.0F + (float)(*p - '0');
+          if (mantissa < STRTOF_MANT_LIMIT)
+            {
+              mantissa = mantissa * 10 + (*p - '0');
+              exponent--;
+            }
+
           p++;
           num_digits++;
-          num_decimals++;
         }
-
-      exponent -= num_decimals;
     }
 
   if (num_digits == 0)
@@ -161,12 +250,9 @@ float strtof(FAR const char *str, FAR char **endptr)
       goto errout;
     }
 
-  /* Correct for sign */
+  /* Remember the sign, it is applied to the result */
 
-  if (negative)
-    {
-      number = -number;
-    }
+  minus = negative;
 
   /* Process an exponent string */
 
@@ -187,12 +273,16 @@ float strtof(FAR const char *str, FAR char **endptr)
           break;
         }
 
-      /* Process string of digits */
+      /* Process string of digits, saturating absurdly large exponents */
 
       n = 0;
       while (isdigit(*p))
         {
-          n = n * 10 + (*p - '0');
+          if (n < 100000)
+            {
+              n = n * 10 + (*p - '0');
+            }
+
           p++;
         }
 
@@ -206,44 +296,95 @@ float strtof(FAR const char *str, FAR char **endptr)
         }
     }
 
-  if (exponent < __FLT_MIN_EXP__ ||
-      exponent > __FLT_MAX_EXP__)
+  /* Zero is exact whatever the exponent */
+
+  if (mantissa == 0)
+    {
+      number = 0.0F;
+      goto errout_with_sign;
+    }
+
+  if (exponent > STRTOF_MAX_EXP10)
     {
       set_errno(ERANGE);
       number = infinite;
-      goto errout;
+      goto errout_with_sign;
     }
 
-  /* Scale the result */
+  if (exponent < STRTOF_MIN_EXP10)
+    {
+      set_errno(ERANGE);
+      number = 0.0F;
+      goto errout_with_sign;
+    }
 
-  p10 = 10.0F;
-  n = exponent;
-  if (n < 0)
+  /* Move the excess of a large exponent into the mantissa while that
+   * keeps the mantissa exact, e.g. 1e12 becomes 100e10.
+   */
+
+  while (exponent > STRTOF_EXACT_POW10 && mantissa <= STRTOF_EXACT_MANT / 10)
     {
-      n = -n;
+      mantissa *= 10;
+      exponent--;
     }
 
-  while (n)
+  number = (float)mantissa;
+
+  /* Fast path:  The mantissa and the power of ten are both exact */
+
+  if (mantissa <= STRTOF_EXACT_MANT &&
+      exponent >= -STRTOF_EXACT_POW10 && exponent <= STRTOF_EXACT_POW10)
     {
-      if (n & 1)
+      if (exponent < 0)
         {
-          if (exponent < 0)
-            {
-              number /= p10;
-            }
-          else
+          number /= g_strtof_pow10[-exponent];
+        }
+      else
+        {
+          number *= g_strtof_pow10[exponent];
+        }
+    }
+  else
+    {
+      /* Scale the result */
+
+      p10 = 10.0F;
+      n = exponent;
+      if (n < 0)
+        {
+          n = -n;
+        }
+
+      while (n)
+        {
+          if (n & 1)
             {
-              number *= p10;
+              if (exponent < 0)
+                {
+                  number /= p10;
+                }
+              else
+                {
+                  number *= p10;
+                }
             }
+
+          n >>= 1;
+          p10 *= p10;
         }
 
-      n >>= 1;
-      p10 *= p10;
+      /* Overflow to infinity and underflow to a subnormal or zero */
+
+      if (!is_normal(number))
+        {
+          set_errno(ERANGE);
+        }
     }
 
-  if (!is_real(number))
+errout_with_sign:
+  if (minus)
     {
-      set_errno(ERANGE);
+      number = -number;
     }
 
 errout:
@@ -254,3 +395,4 @@ errout:
 
   return number;
 }
+#endif /* CONFIG_HAVE_DOUBLE */
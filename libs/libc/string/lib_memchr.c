@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -62,9 +64,43 @@
 FAR void *memchr(FAR const void *s, int c, size_t n)
 {
   FAR const unsigned char *p = (FAR const unsigned char *)s;
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *w;
+  uintptr_t rep;
+#endif
 
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Align to a word boundary */
+
+      while (n > 0 && !STRWORD_ALIGNED(p))
+        {
+          if (*p == (unsigned char)c)
+            {
+              return (FAR void *)p;
+            }
+
+          p++;
+          n--;
+        }
+
+      /* Skip the words that do not hold the byte.  The word that does is
+       * searched byte by byte below.
+       */
+
+      w   = (FAR const uintptr_t *)p;
+      rep = STRWORD_REPEAT(c);
+
+      while (n >= STRWORD_SIZE && !STRWORD_HASZERO(*w ^ rep))
+        {
+          w++;
+          n -= STRWORD_SIZE;
+        }
+
+      p = (FAR const unsigned char *)w;
+#endif
+
       while (n--)
         {
           if (*p == (unsigned char)c)
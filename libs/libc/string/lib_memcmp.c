@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +53,35 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip the equal words if both buffers can be aligned together.  The
+   * first word that differs is left for the byte comparison below.
+   */
+
+  if (n >= STRWORD_SIZE && STRWORD_COALIGNED(p1, p2))
+    {
+      while (!STRWORD_ALIGNED(p1))
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      while (n >= STRWORD_SIZE &&
+             *(FAR uintptr_t *)p1 == *(FAR uintptr_t *)p2)
+        {
+          p1 += STRWORD_SIZE;
+          p2 += STRWORD_SIZE;
+          n  -= STRWORD_SIZE;
+        }
+    }
+
+#endif
   while (n-- > 0)
     {
       if (*p1 < *p2)
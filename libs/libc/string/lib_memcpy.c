@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -52,9 +54,59 @@
 #ifndef CONFIG_LIBC_ARCH_MEMCPY
 FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR unsigned char *pout = (FAR unsigned char *)dest;
+  FAR const unsigned char *pin = (FAR const unsigned char *)src;
+  FAR uintptr_t *wout;
+  FAR const uintptr_t *win;
+
+  /* Copy whole words if both buffers can be aligned together */
+
+  if (n >= STRWORD_SIZE && STRWORD_COALIGNED(pout, pin))
+    {
+      while (!STRWORD_ALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout = (FAR uintptr_t *)pout;
+      win  = (FAR const uintptr_t *)pin;
+
+      while (n >= 4 * STRWORD_SIZE)
+        {
+          wout[0] = win[0];
+          wout[1] = win[1];
+          wout[2] = win[2];
+          wout[3] = win[3];
+          wout   += 4;
+          win    += 4;
+          n      -= 4 * STRWORD_SIZE;
+        }
+
+      while (n >= STRWORD_SIZE)
+        {
+          *wout++ = *win++;
+          n      -= STRWORD_SIZE;
+        }
+
+      pout = (FAR unsigned char *)wout;
+      pin  = (FAR const unsigned char *)win;
+    }
+
+  /* Copy the remaining bytes */
+
+  while (n-- > 0)
+    {
+      *pout++ = *pin++;
+    }
+
+  return dest;
+#else
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
   while (n-- > 0) *pout++ = *pin++;
   return dest;
+#endif
 }
 #endif
@@ -41,11 +41,92 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 #ifndef CONFIG_LIBC_ARCH_MEMMOVE
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
+{
+  FAR unsigned char *tmp;
+  FAR const unsigned char *s;
+  FAR uintptr_t *wtmp;
+  FAR const uintptr_t *ws;
+
+  /* Whole words may be moved if both buffers can be aligned together.  A
+   * word is always read completely before it is written so the copy in the
+   * direction away from the overlap is safe.
+   */
+
+  if (dest <= src)
+    {
+      tmp = (FAR unsigned char *)dest;
+      s   = (FAR const unsigned char *)src;
+
+      if (count >= STRWORD_SIZE && STRWORD_COALIGNED(tmp, s))
+        {
+          while (!STRWORD_ALIGNED(tmp))
+            {
+              *tmp++ = *s++;
+              count--;
+            }
+
+          wtmp = (FAR uintptr_t *)tmp;
+          ws   = (FAR const uintptr_t *)s;
+
+          while (count >= STRWORD_SIZE)
+            {
+              *wtmp++ = *ws++;
+              count  -= STRWORD_SIZE;
+            }
+
+          tmp = (FAR unsigned char *)wtmp;
+          s   = (FAR const unsigned char *)ws;
+        }
+
+      while (count--)
+        {
+          *tmp++ = *s++;
+        }
+    }
+  else
+    {
+      tmp = (FAR unsigned char *)dest + count;
+      s   = (FAR const unsigned char *)src + count;
+
+      if (count >= STRWORD_SIZE && STRWORD_COALIGNED(tmp, s))
+        {
+          while (!STRWORD_ALIGNED(tmp))
+            {
+              *--tmp = *--s;
+              count--;
+            }
+
+          wtmp = (FAR uintptr_t *)tmp;
+          ws   = (FAR const uintptr_t *)s;
+
+          while (count >= STRWORD_SIZE)
+            {
+              *--wtmp = *--ws;
+              count  -= STRWORD_SIZE;
+            }
+
+          tmp = (FAR unsigned char *)wtmp;
+          s   = (FAR const unsigned char *)ws;
+        }
+
+      while (count--)
+        {
+          *--tmp = *--s;
+        }
+    }
+
+  return dest;
+}
+#else
 FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
 {
   FAR char *tmp;
@@ -74,4 +155,5 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
 
   return dest;
 }
+#endif /* CONFIG_LIBC_STRING_OPTSPEED */
 #endif
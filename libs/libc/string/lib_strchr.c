@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -62,11 +64,45 @@
 #ifndef CONFIG_LIBC_ARCH_STRCHR
 FAR char *strchr(FAR const char *s, int c)
 {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *w;
+  uintptr_t rep;
+#endif
+
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Align to a word boundary */
+
+      for (; !STRWORD_ALIGNED(s); s++)
+        {
+          if (*s == (char)c)
+            {
+              return (FAR char *)s;
+            }
+
+          if (!*s)
+            {
+              return NULL;
+            }
+        }
+
+      /* Skip the words that hold neither the character nor a NUL byte */
+
+      w   = (FAR const uintptr_t *)s;
+      rep = STRWORD_REPEAT(c);
+
+      while (!STRWORD_HASZERO(*w) && !STRWORD_HASZERO(*w ^ rep))
+        {
+          w++;
+        }
+
+      s = (FAR const char *)w;
+#endif
+
       for (; ; s++)
         {
-          if (*s == c)
+          if (*s == (char)c)
             {
               return (FAR char *)s;
             }
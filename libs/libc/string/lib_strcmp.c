@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,6 +51,31 @@
 int strcmp(FAR const char *cs, FAR const char *ct)
 {
   register signed char result;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip the equal words without a NUL byte if both strings can be aligned
+   * together.
+   */
+
+  if (STRWORD_COALIGNED(cs, ct))
+    {
+      for (; !STRWORD_ALIGNED(cs); cs++, ct++)
+        {
+          if ((result = *cs - *ct) != 0 || !*cs)
+            {
+              return result;
+            }
+        }
+
+      while (*(FAR const uintptr_t *)cs == *(FAR const uintptr_t *)ct &&
+             !STRWORD_HASZERO(*(FAR const uintptr_t *)cs))
+        {
+          cs += STRWORD_SIZE;
+          ct += STRWORD_SIZE;
+        }
+    }
+
+#endif
   for (; ; )
     {
       if ((result = *cs - *ct++) != 0 || !*cs++)
@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,7 +51,28 @@
 size_t strlen(const char *s)
 {
   const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *w;
+
+  /* Align to a word boundary */
+
+  for (sc = s; !STRWORD_ALIGNED(sc); ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  /* Skip the words without a NUL byte */
+
+  for (w = (FAR const uintptr_t *)sc; !STRWORD_HASZERO(*w); w++);
+  sc = (const char *)w;
+#else
+  sc = s;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
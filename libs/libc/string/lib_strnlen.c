@@ -48,6 +48,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_strword.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -56,7 +58,30 @@
 size_t strnlen(const char *s, size_t maxlen)
 {
   const char *sc;
-  for (sc = s; maxlen != 0 && *sc != '\0'; maxlen--, ++sc);
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *w;
+
+  /* Align to a word boundary */
+
+  for (sc = s; maxlen != 0 && !STRWORD_ALIGNED(sc); maxlen--, ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  /* Skip the words without a NUL byte */
+
+  for (w = (FAR const uintptr_t *)sc;
+       maxlen >= STRWORD_SIZE && !STRWORD_HASZERO(*w);
+       maxlen -= STRWORD_SIZE, w++);
+  sc = (const char *)w;
+#else
+  sc = s;
+#endif
+
+  for (; maxlen != 0 && *sc != '\0'; maxlen--, ++sc);
   return sc - s;
 }
 #endif
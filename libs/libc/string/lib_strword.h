@@ -0,0 +1,72 @@
+/****************************************************************************
+ * libs/libc/string/lib_strword.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRWORD_H
+#define __LIBS_LIBC_STRING_LIB_STRWORD_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The speed optimized string functions work on whole, aligned machine
+ * words.  A word never crosses an alignment boundary so reading a word that
+ * holds the terminating NUL byte cannot fault even if some of its bytes are
+ * past the end of the string.
+ */
+
+#define STRWORD_SIZE         sizeof(uintptr_t)
+#define STRWORD_MASK         (STRWORD_SIZE - 1)
+
+/* True if the address is aligned to a word boundary */
+
+#define STRWORD_ALIGNED(p)   (((uintptr_t)(p) & STRWORD_MASK) == 0)
+
+/* True if two addresses have the same alignment, i.e., both can be aligned
+ * to a word boundary by the same number of byte accesses.
+ */
+
+#define STRWORD_COALIGNED(p1, p2) \
+  ((((uintptr_t)(p1) ^ (uintptr_t)(p2)) & STRWORD_MASK) == 0)
+
+/* 0x0101...01 and 0x8080...80 for the size of the word */
+
+#define STRWORD_ONES         ((uintptr_t)-1 / 0xff)
+#define STRWORD_HIGHS        (STRWORD_ONES << 7)
+
+/* A word with each byte set to the (unsigned char) value c */
+
+#define STRWORD_REPEAT(c)    (STRWORD_ONES * (unsigned char)(c))
+
+/* Non-zero if any byte of the word x is zero.  Subtracting one from each
+ * byte sets the high bit only of the bytes that were zero or had the high
+ * bit already set; the latter are masked out with ~x.
+ */
+
+#define STRWORD_HASZERO(x)   (((x) - STRWORD_ONES) & ~(x) & STRWORD_HIGHS)
+
+#endif /* __LIBS_LIBC_STRING_LIB_STRWORD_H */
@@ -57,8 +57,11 @@
 #include <limits.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <assert.h>
+#include <semaphore.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/semaphore.h>
 
 #include "libc.h"
 
@@ -76,6 +79,12 @@
 #  define TZDIR "/etc/zoneinfo"
 #endif
 
+/* Number of parsed time zones kept by tzset() */
+
+#ifndef CONFIG_LIBC_TZ_CACHE_SIZE
+#  define CONFIG_LIBC_TZ_CACHE_SIZE 1
+#endif
+
 /* Time definitions *********************************************************/
 
 /* Time zone files */
@@ -101,6 +110,13 @@
 #define SECSPERDAY          ((int_fast32_t) SECSPERHOUR * HOURSPERDAY)
 #define MONSPERYEAR         12
 
+/* Days in 400 years and from 0000-03-01 to 1970-01-01, for the conversion
+ * of days to a calendar date.
+ */
+
+#define DAYSPERQCENTURY     146097
+#define DAYSTOEPOCH         719468
+
 #define TM_SUNDAY           0
 #define TM_MONDAY           1
 #define TM_TUESDAY          2
@@ -291,6 +307,14 @@ struct state_s
   int defaulttype;            /* For early times or if no transitions */
 };
 
+/* A parsed time zone kept by tzset() for reuse */
+
+struct tzcache_s
+{
+  FAR struct state_s *state;  /* Parsed time zone, allocated on first use */
+  char name[MY_TZNAME_MAX + 1]; /* Value of TZ or empty if not reusable */
+};
+
 struct rule_s
 {
   int r_type;                 /* type of rule; see below */
@@ -320,7 +344,15 @@ static const char g_wildabbr[] = WILDABBR;
 
 static char g_lcl_tzname[MY_TZNAME_MAX + 1];
 static int g_lcl_isset;
-static int g_gmt_isset;
+
+/* The parsed time zones, replaced in round-robin order */
+
+static struct tzcache_s g_tz_cache[CONFIG_LIBC_TZ_CACHE_SIZE];
+static int g_tz_cachenext;
+
+/* Serializes the access to the time zone state */
+
+static sem_t g_tz_sem = SEM_INITIALIZER(1);
 
 /* Section 4.12.3 of X3.159-1989 requires that
  *    Except for the strftime function, these functions [asctime,
@@ -377,7 +409,6 @@ static FAR struct tm *gmtsub(FAR const time_t * timep, int_fast32_t offset,
 static FAR struct tm *localsub(FAR const time_t * timep, int_fast32_t offset,
               FAR struct tm *tmp);
 static int  increment_overflow(FAR int *number, int delta);
-static int  leaps_thru_end_of(int y);
 static int  increment_overflow32(FAR int_fast32_t * number, int delta);
 static int  increment_overflow_time(time_t * t, int_fast32_t delta);
 static int  normalize_overflow32(FAR int_fast32_t * tensptr,
@@ -403,12 +434,16 @@ static int  tmcomp(FAR const struct tm *atmp, FAR const struct tm *btmp);
 static int_fast32_t transtime(int year, FAR const struct rule_s *rulep,
               int_fast32_t offset);
 static int  typesequiv(FAR const struct state_s *sp, int a, int b);
+static FAR struct state_s *tzcache_find(FAR const char *name);
+static FAR struct state_s *tzcache_alloc(FAR const char *name);
+static void tz_semtake(void);
+static void tz_semgive(void);
+static void tzset_unlocked(void);
 static int  tzload(FAR const char *name, FAR struct state_s *sp,
               int doextend);
 static int  tzparse(FAR const char *name, FAR struct state_s *sp,
               int lastditch);
 static FAR struct state_s *lclptr;
-static FAR struct state_s *gmtptr;
 
 /****************************************************************************
  * Private Functions
@@ -1633,6 +1668,72 @@ static void gmtload(FAR struct state_s *const sp)
     }
 }
 
+/* Return the parsed time zone of the given TZ value from the cache or
+ * NULL if it is not cached.
+ */
+
+static FAR struct state_s *tzcache_find(FAR const char *name)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_LIBC_TZ_CACHE_SIZE; i++)
+    {
+      if (g_tz_cache[i].state != NULL && g_tz_cache[i].name[0] != '\0' &&
+          strcmp(g_tz_cache[i].name, name) == 0)
+        {
+          return g_tz_cache[i].state;
+        }
+    }
+
+  return NULL;
+}
+
+/* Replace the least recently loaded time zone of the cache and return its
+ * state, to be loaded by the caller.  A NULL name (the system default time
+ * zone) or a name that is too long is not found by tzcache_find().
+ */
+
+static FAR struct state_s *tzcache_alloc(FAR const char *name)
+{
+  FAR struct tzcache_s *entry = &g_tz_cache[g_tz_cachenext];
+
+  if (entry->state == NULL)
+    {
+      entry->state = lib_malloc(sizeof(struct state_s));
+      if (entry->state == NULL)
+        {
+          return NULL;
+        }
+    }
+
+  g_tz_cachenext = (g_tz_cachenext + 1) % CONFIG_LIBC_TZ_CACHE_SIZE;
+
+  entry->name[0] = '\0';
+  if (name != NULL && strlen(name) < sizeof(entry->name))
+    {
+      strcpy(entry->name, name);
+    }
+
+  return entry->state;
+}
+
+/* Serialize the access to the time zone state */
+
+static void tz_semtake(void)
+{
+  int ret;
+
+  while ((ret = _SEM_WAIT(&g_tz_sem)) < 0)
+    {
+      DEBUGASSERT(_SEM_ERRNO(ret) == EINTR || _SEM_ERRNO(ret) == ECANCELED);
+    }
+}
+
+static void tz_semgive(void)
+{
+  _SEM_POST(&g_tz_sem);
+}
+
 /* A non-static declaration of tzsetwall in a system header file
  * may cause a warning about this upcoming static declaration...
  */
@@ -1646,14 +1747,11 @@ static void tzsetwall(void)
 
   g_lcl_isset = -1;
 
+  lclptr = tzcache_alloc(NULL);
   if (lclptr == NULL)
     {
-      lclptr = lib_malloc(sizeof *lclptr);
-      if (lclptr == NULL)
-        {
-          settzname();          /* all we can do */
-          return;
-        }
+      settzname();          /* all we can do */
+      return;
     }
 
   if (tzload(NULL, lclptr, TRUE) != 0)
@@ -1788,30 +1886,14 @@ static struct tm *localsub(FAR const time_t * const timep,
 
 /* gmtsub is to gmtime as localsub is to localtime */
 
-static struct tm *gmtsub(FAR const time_t * const timep,
-                         const int_fast32_t offset, struct tm *const tmp)
-{
-  if (!g_gmt_isset)
-    {
-      gmtptr = lib_malloc(sizeof *gmtptr);
-      g_gmt_isset = gmtptr != NULL;
-      if (g_gmt_isset)
-        {
-          gmtload(gmtptr);
-        }
-    }
-
-  return timesub(timep, offset, gmtptr, tmp);
-}
-
-/* Return the number of leap years through the end of the given year
- * where, to make the math easy, the answer for year zero is defined as zero.
+/* UTC has no transitions and POSIX time does not count leap seconds, so
+ * there is no need to load the GMT zone file.
  */
 
-static int leaps_thru_end_of(const int y)
+static struct tm *gmtsub(FAR const time_t * const timep,
+                         const int_fast32_t offset, struct tm *const tmp)
 {
-  return (y >= 0) ? (y / 4 - y / 100 + y / 400) :
-    -(leaps_thru_end_of(-(y + 1)) + 1);
+  return timesub(timep, offset, NULL, tmp);
 }
 
 static struct tm *timesub(FAR const time_t * const timep,
@@ -1820,11 +1902,14 @@ static struct tm *timesub(FAR const time_t * const timep,
                           struct tm *const tmp)
 {
   const struct lsinfo_s *lp;
-  time_t tdays;
-  int idays;           /* unsigned would be so 2003 */
+  int_fast64_t days;
+  int_fast64_t era;
+  int_fast64_t year;
+  int doe;
+  int yoe;
+  int doy;
+  int mp;
   int_fast64_t rem;
-  int y;
-  FAR const int *ip;
   int_fast64_t corr;
   int hit;
   int i;
@@ -1859,103 +1944,57 @@ static struct tm *timesub(FAR const time_t * const timep,
         }
     }
 
-  y = EPOCH_YEAR;
-  tdays = *timep / SECSPERDAY;
-  rem = *timep - tdays * SECSPERDAY;
-  while (tdays < 0 || tdays >= g_year_lengths[isleap(y)])
-    {
-      int newy;
-      time_t tdelta;
-      int idelta;
-      int leapdays;
-
-      tdelta = tdays / DAYSPERLYEAR;
-      if (!((!TYPE_SIGNED(time_t) || INT_MIN <= tdelta) &&
-          tdelta <= INT_MAX))
-        {
-          return NULL;
-        }
-
-      idelta = tdelta;
-      if (idelta == 0)
-        {
-          idelta = (tdays < 0) ? -1 : 1;
-        }
-
-      newy = y;
-      if (increment_overflow(&newy, idelta))
-        {
-          return NULL;
-        }
-
-      leapdays = leaps_thru_end_of(newy - 1) - leaps_thru_end_of(y - 1);
-      tdays -= ((time_t) newy - y) * DAYSPERNYEAR;
-      tdays -= leapdays;
-      y = newy;
-    }
-
-    {
-      int_fast32_t seconds;
-
-      seconds = tdays * SECSPERDAY;
-      tdays = seconds / SECSPERDAY;
-      rem += seconds - tdays * SECSPERDAY;
-    }
-
-  /* Given the range, we can now fearlessly cast */
+  /* Split the time into days since the epoch and seconds of the day.  The
+   * division truncates towards zero, so the remainder may be negative
+   * before times in 1970; it is brought into [0, SECSPERDAY) together with
+   * the offset and the leap second correction.
+   */
 
-  idays = tdays;
+  days = (int_fast64_t)(*timep / SECSPERDAY);
+  rem  = (int_fast64_t)*timep - days * SECSPERDAY;
   rem += offset - corr;
+
   while (rem < 0)
     {
       rem += SECSPERDAY;
-      --idays;
+      --days;
     }
 
   while (rem >= SECSPERDAY)
     {
       rem -= SECSPERDAY;
-      ++idays;
+      ++days;
     }
 
-  while (idays < 0)
-    {
-      if (increment_overflow(&y, -1))
-        {
-          return NULL;
-        }
+  tmp->tm_wday = (int)(days % DAYSPERWEEK);
+  tmp->tm_wday = (tmp->tm_wday + EPOCH_WDAY + DAYSPERWEEK) % DAYSPERWEEK;
 
-      idays += g_year_lengths[isleap(y)];
-    }
+  /* Convert the days to a date without iterating over the years.  The
+   * years are counted from March 1st so that the leap day is the last day
+   * of the year, in eras of 400 years which all have the same number of
+   * days (Howard Hinnant's civil_from_days()).
+   */
 
-  while (idays >= g_year_lengths[isleap(y)])
-    {
-      idays -= g_year_lengths[isleap(y)];
-      if (increment_overflow(&y, 1))
-        {
-          return NULL;
-        }
-    }
+  days  += DAYSTOEPOCH;
+  era    = (days >= 0 ? days : days - (DAYSPERQCENTURY - 1)) /
+           DAYSPERQCENTURY;
+  doe    = (int)(days - era * DAYSPERQCENTURY);
+  yoe    = (doe - doe / 1460 + doe / 36524 - doe / 146096) / DAYSPERNYEAR;
+  doy    = doe - (DAYSPERNYEAR * yoe + yoe / 4 - yoe / 100);
+  mp     = (5 * doy + 2) / 153;
+
+  tmp->tm_mday = doy - (153 * mp + 2) / 5 + 1;
+  tmp->tm_mon  = mp < 10 ? mp + TM_MARCH : mp - 10;
 
-  tmp->tm_year = y;
-  if (increment_overflow(&tmp->tm_year, -TM_YEAR_BASE))
+  year = era * 400 + yoe + (tmp->tm_mon <= TM_FEBRUARY);
+  if (year - TM_YEAR_BASE < INT_MIN || year - TM_YEAR_BASE > INT_MAX)
     {
       return NULL;
     }
 
-  tmp->tm_yday = idays;
-
-  /* The "extra" mods below avoid overflow problems */
-
-  tmp->tm_wday = EPOCH_WDAY +
-    ((y - EPOCH_YEAR) % DAYSPERWEEK) *
-    (DAYSPERNYEAR % DAYSPERWEEK) +
-    leaps_thru_end_of(y - 1) - leaps_thru_end_of(EPOCH_YEAR - 1) + idays;
-  tmp->tm_wday %= DAYSPERWEEK;
-  if (tmp->tm_wday < 0)
-    {
-      tmp->tm_wday += DAYSPERWEEK;
-    }
+  tmp->tm_year = (int)(year - TM_YEAR_BASE);
+  tmp->tm_yday = tmp->tm_mon <= TM_FEBRUARY ? doy - 306 :
+                 doy + 59 + isleap(year);
 
   tmp->tm_hour = (int)(rem / SECSPERHOUR);
   rem %= SECSPERHOUR;
@@ -1966,13 +2005,6 @@ static struct tm *timesub(FAR const time_t * const timep,
    */
 
   tmp->tm_sec = (int)(rem % SECSPERMIN) + hit;
-  ip = g_mon_lengths[isleap(y)];
-  for (tmp->tm_mon = 0; idays >= ip[tmp->tm_mon]; ++(tmp->tm_mon))
-    {
-      idays -= ip[tmp->tm_mon];
-    }
-
-  tmp->tm_mday = (int)(idays + 1);
   tmp->tm_isdst = 0;
   tmp->tm_gmtoff = offset;
   tmp->tm_zone = tzname[0];
@@ -2310,7 +2342,7 @@ static time_t time2sub(struct tm *const tmp,
        */
 
       sp = (FAR const struct state_s *)
-        ((funcp == localsub) ? lclptr : gmtptr);
+        ((funcp == localsub) ? lclptr : NULL);
       if (sp == NULL)
         {
           return -1;
@@ -2431,7 +2463,7 @@ static time_t time1(FAR struct tm *const tmp,
    * type they need.
    */
 
-  sp = (FAR const struct state_s *)((funcp == localsub) ? lclptr : gmtptr);
+  sp = (FAR const struct state_s *)((funcp == localsub) ? lclptr : NULL);
   if (sp == NULL)
     {
       return -1;
@@ -2486,11 +2518,11 @@ static time_t time1(FAR struct tm *const tmp,
   return -1;
 }
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
+/* tzset() without the lock, for the functions that need the time zone
+ * state
+ */
 
-void tzset(void)
+static void tzset_unlocked(void)
 {
   FAR const char *name;
 
@@ -2512,14 +2544,20 @@ void tzset(void)
       strcpy(g_lcl_tzname, name);
     }
 
+  /* Reuse the time zone if it was parsed before */
+
+  lclptr = tzcache_find(name);
+  if (lclptr != NULL)
+    {
+      settzname();
+      return;
+    }
+
+  lclptr = tzcache_alloc(name);
   if (lclptr == NULL)
     {
-      lclptr = lib_malloc(sizeof *lclptr);
-      if (lclptr == NULL)
-        {
-          settzname(); /* all we can do */
-          return;
-        }
+      settzname(); /* all we can do */
+      return;
     }
 
   if (*name == '\0')
@@ -2545,17 +2583,47 @@ void tzset(void)
   settzname();
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void tzset(void)
+{
+  tz_semtake();
+  tzset_unlocked();
+  tz_semgive();
+}
+
 FAR struct tm *localtime(FAR const time_t * const timep)
 {
-  tzset();
-  return localsub(timep, 0L, &g_tm);
+  FAR struct tm *ret;
+
+  tz_semtake();
+  tzset_unlocked();
+  ret = localsub(timep, 0L, &g_tm);
+  tz_semgive();
+
+  return ret;
 }
 
-/* Re-entrant version of localtime */
+/* Re-entrant version of localtime.  The time zone is set up on first use
+ * only; a later change of TZ takes effect with the next tzset().
+ */
 
 FAR struct tm *localtime_r(FAR const time_t * const timep, struct tm *tmp)
 {
-  return localsub(timep, 0L, tmp);
+  FAR struct tm *ret;
+
+  tz_semtake();
+  if (g_lcl_isset == 0)
+    {
+      tzset_unlocked();
+    }
+
+  ret = localsub(timep, 0L, tmp);
+  tz_semgive();
+
+  return ret;
 }
 
 FAR struct tm *gmtime(FAR const time_t * const timep)
@@ -2572,6 +2640,12 @@ FAR struct tm *gmtime_r(FAR const time_t * const timep, struct tm *tmp)
 
 time_t mktime(struct tm * const tmp)
 {
-  tzset();
-  return time1(tmp, localsub, 0L);
+  time_t ret;
+
+  tz_semtake();
+  tzset_unlocked();
+  ret = time1(tmp, localsub, 0L);
+  tz_semgive();
+
+  return ret;
 }
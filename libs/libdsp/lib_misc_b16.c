@@ -0,0 +1,70 @@
+/****************************************************************************
+ * libs/libdsp/lib_misc_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: phase_angle_update_b16
+ *
+ * Description:
+ *   Fixed-point variant of phase_angle_update():
+ *     1. normalize angle value to <0.0, 2PI> range
+ *     2. update angle value
+ *     3. update sin/cos value for given angle
+ *
+ * Input Parameters:
+ *   angle - (in/out) pointer to the angle data
+ *   val   - (in) angle radian value
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void phase_angle_update_b16(FAR phase_angle_b16_t *angle, b16_t val)
+{
+  DEBUGASSERT(angle != NULL);
+
+  /* Normalize angle to <0.0, 2PI> */
+
+  while (val > b16TWOPI)
+    {
+      val -= b16TWOPI;
+    }
+
+  while (val < 0)
+    {
+      val += b16TWOPI;
+    }
+
+  /* Update structure */
+
+  angle->angle = val;
+  angle->sin   = b16sin(val);
+  angle->cos   = b16cos(val);
+}
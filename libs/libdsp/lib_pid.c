@@ -294,3 +294,74 @@ float pid_controller(FAR pid_controller_t *pid, float err)
 
   return pid->out;
 }
+
+/****************************************************************************
+ * Name: pi_controller_batch
+ *
+ * Description:
+ *   PI controller with output saturation and windup protection for n
+ *   channels, with the same results as pi_controller() for each of them.
+ *   The saturation limits are common to all channels.
+ *
+ * Input Parameters:
+ *   pi  - (in/out) pointer to the PI controllers data
+ *   err - (in) current controller errors
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_controller_batch(FAR struct pi_controller_batch_s *pi,
+                         FAR float *err, size_t n)
+{
+  FAR float *out;
+  FAR float *part;
+  FAR const float *KP;
+  FAR const float *KI;
+  float max;
+  float min;
+  float e;
+  float o;
+  float p;
+  bool sat;
+  bool hi;
+  bool lo;
+  size_t i;
+
+  DEBUGASSERT(pi != NULL);
+  DEBUGASSERT(err != NULL);
+
+  out  = pi->out;
+  part = pi->part;
+  KP   = pi->KP;
+  KI   = pi->KI;
+  max  = pi->sat.max;
+  min  = pi->sat.min;
+  sat  = (max != min);
+
+  for (i = 0; i < n; i++)
+    {
+      e = err[i];
+
+      /* Get integral part and add the proportional part */
+
+      p = part[i] + KI[i] * e;
+      o = KP[i] * e + p;
+
+      /* Saturate output if limits are set and reset the integral part if
+       * the error drives the output further into saturation.
+       */
+
+      hi = sat && o > max;
+      lo = sat && o < min;
+
+      p  = (hi && e > 0.0f) || (lo && e < 0.0f) ? 0.0f : p;
+      o  = hi ? max : o;
+      o  = lo ? min : o;
+
+      part[i] = p;
+      out[i]  = o;
+    }
+}
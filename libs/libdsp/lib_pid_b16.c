@@ -0,0 +1,157 @@
+/****************************************************************************
+ * libs/libdsp/lib_pid_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pi_controller_init_b16
+ *
+ * Description:
+ *   Fixed-point variant of pi_controller_init().  This function does not
+ *   initialize saturation limits.
+ *
+ * Input Parameters:
+ *   pi - (out) pointer to the PI controller data
+ *   KP - (in) proportional gain
+ *   KI - (in) integral gain
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_controller_init_b16(FAR pi_controller_b16_t *pi, b16_t KP,
+                            b16_t KI)
+{
+  DEBUGASSERT(pi != NULL);
+
+  /* Reset controller data */
+
+  memset(pi, 0, sizeof(pi_controller_b16_t));
+
+  /* Copy controller parameters */
+
+  pi->KP = KP;
+  pi->KI = KI;
+}
+
+/****************************************************************************
+ * Name: pi_saturation_set_b16
+ *
+ * Description:
+ *   Set controller saturation limits.
+ *
+ * Input Parameters:
+ *   pi  - (out) pointer to the PI controller data
+ *   min - (in) lower limit
+ *   max - (in) upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_saturation_set_b16(FAR pi_controller_b16_t *pi, b16_t min,
+                           b16_t max)
+{
+  DEBUGASSERT(pi != NULL);
+  DEBUGASSERT(min < max);
+
+  pi->sat.max = max;
+  pi->sat.min = min;
+}
+
+/****************************************************************************
+ * Name: pi_controller_b16
+ *
+ * Description:
+ *   Fixed-point variant of pi_controller():  PI controller with output
+ *   saturation and windup protection.
+ *
+ * Input Parameters:
+ *   pi  - (in/out) pointer to the PI controller data
+ *   err - (in) current controller error
+ *
+ * Returned Value:
+ *   Return controller output.
+ *
+ ****************************************************************************/
+
+b16_t pi_controller_b16(FAR pi_controller_b16_t *pi, b16_t err)
+{
+  DEBUGASSERT(pi != NULL);
+
+  /* Store error in controller structure */
+
+  pi->err = err;
+
+  /* Get proportional and integral part */
+
+  pi->part[0]  = b16mulb16(pi->KP, err);
+  pi->part[1] += b16mulb16(pi->KI, err);
+
+  /* Add proportional, integral */
+
+  pi->out = pi->part[0] + pi->part[1];
+
+  /* Saturate output only if some limits are set */
+
+  if (pi->sat.max != pi->sat.min)
+    {
+      if (pi->out > pi->sat.max)
+        {
+          /* Limit output to the upper limit */
+
+          pi->out = pi->sat.max;
+
+          /* Integral anti-windup - reset integral part */
+
+          if (err > 0)
+            {
+              pi->part[1] = 0;
+            }
+        }
+      else if (pi->out < pi->sat.min)
+        {
+          /* Limit output to the lower limit */
+
+          pi->out = pi->sat.min;
+
+          /* Integral anti-windup - reset integral part */
+
+          if (err < 0)
+            {
+              pi->part[1] = 0;
+            }
+        }
+    }
+
+  /* Return regulator output */
+
+  return pi->out;
+}
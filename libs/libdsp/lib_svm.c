@@ -26,6 +26,20 @@
 
 #include <dsp.h>
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* SVM sector indexed by the signs of the auxiliary i,j,k frame:
+ * (i > 0) | (j > 0) << 1 | (k > 0) << 2.  This gives the same sectors as
+ * svm3_sector_get() without branches.
+ */
+
+static const uint8_t g_svm3_sector[8] =
+{
+  2, 6, 2, 1, 4, 5, 3, 5
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -417,6 +431,104 @@ void svm3_current_correct(FAR struct svm3_state_s *s,
     }
 }
 
+/****************************************************************************
+ * Name: svm3_batch
+ *
+ * Description:
+ *   One step of the space vector modulation for n 3-phase systems, with
+ *   the same results as svm3() for each of them.
+ *
+ *   Instead of selecting the active vector times for the sector, the duty
+ *   cycles are obtained from the differences between the phases and then
+ *   centered so that both null vectors get the same time.  This needs
+ *   neither branches nor divisions and the loop can be vectorized.
+ *
+ * Input Parameters:
+ *   s    - (out) pointer to the SVM data
+ *   v_ab - (in) pointer to the modulation voltage vectors in alpha-beta
+ *          frame, normalized to magnitude (0.0 - 1.0)
+ *   n    - (in) number of 3-phase systems
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_batch(FAR struct svm3_batch_s *s, FAR ab_frame_batch_t *v_ab,
+                size_t n)
+{
+  FAR const float *alpha;
+  FAR const float *beta;
+  FAR uint8_t *sector;
+  FAR float *d_u;
+  FAR float *d_v;
+  FAR float *d_w;
+  float d_max;
+  float d_min;
+  float i;
+  float j;
+  float k;
+  float u;
+  float v;
+  float w;
+  float max;
+  float min;
+  float mid;
+  size_t x;
+
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(v_ab != NULL);
+
+  alpha  = v_ab->a;
+  beta   = v_ab->b;
+  sector = s->sector;
+  d_u    = s->d_u;
+  d_v    = s->d_v;
+  d_w    = s->d_w;
+  d_max  = s->d_max;
+  d_min  = s->d_min;
+
+  for (x = 0; x < n; x++)
+    {
+      /* Auxiliary i,j,k frame as in svm3() */
+
+      i = -0.5f*beta[x] + SQRT3_BY_TWO_F*alpha[x];
+      j = beta[x];
+      k = -j - i;
+
+      sector[x] = g_svm3_sector[(i > 0.0f) | (j > 0.0f) << 1 |
+                                (k > 0.0f) << 2];
+
+      /* The duty cycles differ by d_u - d_v = i and d_w - d_u = k.  Center
+       * them around 0.5.
+       */
+
+      u = 0.0f;
+      v = -i;
+      w = k;
+
+      max = v > u ? v : u;
+      max = w > max ? w : max;
+      min = v < u ? v : u;
+      min = w < min ? w : min;
+      mid = 0.5f - 0.5f * (max + min);
+
+      u = u + mid;
+      v = v + mid;
+      w = w + mid;
+
+      /* Saturate output from SVM */
+
+      u = u > d_max ? d_max : u;
+      v = v > d_max ? d_max : v;
+      w = w > d_max ? d_max : w;
+
+      d_u[x] = u < d_min ? d_min : u;
+      d_v[x] = v < d_min ? d_min : v;
+      d_w[x] = w < d_min ? d_min : w;
+    }
+}
+
 /****************************************************************************
  * Name: svm3_init
  *
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * libs/libdsp/lib_svm_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* SVM sector indexed by the signs of the auxiliary i,j,k frame, see
+ * lib_svm.c.
+ */
+
+static const uint8_t g_svm3_sector_b16[8] =
+{
+  2, 6, 2, 1, 4, 5, 3, 5
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: svm3_saturate_b16
+ ****************************************************************************/
+
+static inline b16_t svm3_saturate_b16(b16_t val, b16_t min, b16_t max)
+{
+  return val < min ? min : val > max ? max : val;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: svm3_b16
+ *
+ * Description:
+ *   Fixed-point variant of svm3(), computed as svm3_batch() does:  The
+ *   duty cycles are obtained from the differences between the phases and
+ *   centered so that both null vectors get the same time.
+ *
+ * Input Parameters:
+ *   s    - (out) pointer to the SVM data
+ *   v_ab - (in) pointer to the modulation voltage vector in alpha-beta
+ *          frame, normalized to magnitude (0.0 - 1.0)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_b16(FAR struct svm3_state_b16_s *s, FAR ab_frame_b16_t *v_ab)
+{
+  b16_t i;
+  b16_t j;
+  b16_t k;
+  b16_t v;
+  b16_t max;
+  b16_t min;
+  b16_t mid;
+
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(v_ab != NULL);
+
+  /* Auxiliary i,j,k frame as in svm3() */
+
+  i = -(v_ab->b >> 1) + b16mulb16(SQRT3_BY_TWO_B16, v_ab->a);
+  j = v_ab->b;
+  k = -j - i;
+
+  s->sector = g_svm3_sector_b16[(i > 0) | (j > 0) << 1 | (k > 0) << 2];
+
+  /* The duty cycles differ by d_u - d_v = i and d_w - d_u = k.  Center
+   * them around 0.5.
+   */
+
+  v   = -i;
+  max = v > 0 ? v : 0;
+  max = k > max ? k : max;
+  min = v < 0 ? v : 0;
+  min = k < min ? k : min;
+  mid = b16HALF - ((max + min) >> 1);
+
+  /* Saturate output from SVM */
+
+  s->d_u = svm3_saturate_b16(mid, s->d_min, s->d_max);
+  s->d_v = svm3_saturate_b16(v + mid, s->d_min, s->d_max);
+  s->d_w = svm3_saturate_b16(k + mid, s->d_min, s->d_max);
+}
+
+/****************************************************************************
+ * Name: svm3_init_b16
+ *
+ * Description:
+ *   Initialize 3-phase SVM data.
+ *
+ * Input Parameters:
+ *   s   - (in/out) pointer to the SVM state data
+ *   min - (in) duty cycle min
+ *   max - (in) duty cycle max
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_init_b16(FAR struct svm3_state_b16_s *s, b16_t min, b16_t max)
+{
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(max > min);
+
+  memset(s, 0, sizeof(struct svm3_state_b16_s));
+
+  s->d_max = max;
+  s->d_min = min;
+}
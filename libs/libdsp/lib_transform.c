@@ -143,3 +143,201 @@ void inv_park_transform(FAR phase_angle_t *angle,
   ab->a = angle->cos * dq->d - angle->sin * dq->q;
   ab->b = angle->cos * dq->q + angle->sin * dq->d;
 }
+
+/****************************************************************************
+ * Name: clarke_transform_batch
+ *
+ * Description:
+ *   Clarke transform of n abc frames given as arrays.
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frames
+ *   ab  - (out) pointer to the alpha-beta frames
+ *   n   - (in) number of frames
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_batch(FAR abc_frame_batch_t *abc,
+                            FAR ab_frame_batch_t *ab, size_t n)
+{
+  FAR const float *a;
+  FAR const float *b;
+  FAR float *alpha;
+  FAR float *beta;
+  size_t i;
+
+  DEBUGASSERT(abc != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  /* Copy the array pointers so that the compiler need not reload them
+   * after each store.
+   */
+
+  a     = abc->a;
+  b     = abc->b;
+  alpha = ab->a;
+  beta  = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      alpha[i] = a[i];
+      beta[i]  = ONE_BY_SQRT3_F*a[i] + TWO_BY_SQRT3_F*b[i];
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_batch
+ *
+ * Description:
+ *   Inverse Clarke transform of n alpha-beta frames given as arrays.
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frames
+ *   abc - (out) pointer to the abc frames
+ *   n   - (in) number of frames
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_batch(FAR ab_frame_batch_t *ab,
+                                FAR abc_frame_batch_t *abc, size_t n)
+{
+  FAR const float *alpha;
+  FAR const float *beta;
+  FAR float *a;
+  FAR float *b;
+  FAR float *c;
+  float va;
+  float vb;
+  size_t i;
+
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(abc != NULL);
+
+  alpha = ab->a;
+  beta  = ab->b;
+  a     = abc->a;
+  b     = abc->b;
+  c     = abc->c;
+
+  for (i = 0; i < n; i++)
+    {
+      va   = alpha[i];
+      vb   = -0.5f*va + SQRT3_BY_TWO_F*beta[i];
+
+      a[i] = va;
+      b[i] = vb;
+      c[i] = -va - vb;
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_batch
+ *
+ * Description:
+ *   Park transform of n alpha-beta frames given as arrays, each with its
+ *   own phase angle.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles sine and cosine
+ *   ab    - (in) pointer to the alpha-beta frames
+ *   dq    - (out) pointer to the direct-quadrature frames
+ *   n     - (in) number of frames
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_batch(FAR phase_angle_batch_t *angle,
+                          FAR ab_frame_batch_t *ab,
+                          FAR dq_frame_batch_t *dq, size_t n)
+{
+  FAR const float *sn;
+  FAR const float *cs;
+  FAR const float *alpha;
+  FAR const float *beta;
+  FAR float *d;
+  FAR float *q;
+  float va;
+  float vb;
+  size_t i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(ab != NULL);
+  DEBUGASSERT(dq != NULL);
+
+  sn    = angle->sin;
+  cs    = angle->cos;
+  alpha = ab->a;
+  beta  = ab->b;
+  d     = dq->d;
+  q     = dq->q;
+
+  for (i = 0; i < n; i++)
+    {
+      va   = alpha[i];
+      vb   = beta[i];
+
+      d[i] = cs[i] * va + sn[i] * vb;
+      q[i] = cs[i] * vb - sn[i] * va;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_batch
+ *
+ * Description:
+ *   Inverse Park transform of n direct-quadrature frames given as arrays,
+ *   each with its own phase angle.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles sine and cosine
+ *   dq    - (in) pointer to the direct-quadrature frames
+ *   ab    - (out) pointer to the alpha-beta frames
+ *   n     - (in) number of frames
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_batch(FAR phase_angle_batch_t *angle,
+                              FAR dq_frame_batch_t *dq,
+                              FAR ab_frame_batch_t *ab, size_t n)
+{
+  FAR const float *sn;
+  FAR const float *cs;
+  FAR const float *d;
+  FAR const float *q;
+  FAR float *alpha;
+  FAR float *beta;
+  float vd;
+  float vq;
+  size_t i;
+
+  DEBUGASSERT(angle != NULL);
+  DEBUGASSERT(dq != NULL);
+  DEBUGASSERT(ab != NULL);
+
+  sn    = angle->sin;
+  cs    = angle->cos;
+  d     = dq->d;
+  q     = dq->q;
+  alpha = ab->a;
+  beta  = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      vd       = d[i];
+      vq       = q[i];
+
+      alpha[i] = cs[i] * vd - sn[i] * vq;
+      beta[i]  = cs[i] * vq + sn[i] * vd;
+    }
+}
@@ -44,8 +44,10 @@
 
 #include <debug.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_MM_IOB
 
@@ -63,6 +65,50 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+#ifdef CONFIG_SMP
+#  define IOB_NCPUS              CONFIG_SMP_NCPUS
+#else
+#  define IOB_NCPUS              1
+#endif
+
+#ifndef CONFIG_IOB_PERCPU_CACHE
+#  define CONFIG_IOB_PERCPU_CACHE 0
+#endif
+
+/* The number of IOBs moved between a CPU cache and the global pool at
+ * once, and the number of free IOBs that must remain in the global pool
+ * for the CPU caches to hold on to IOBs.
+ */
+
+#define IOB_CACHE_BATCH          ((CONFIG_IOB_PERCPU_CACHE + 1) / 2)
+#define IOB_CACHE_RESERVE        (CONFIG_IOB_THROTTLE + IOB_CACHE_BATCH)
+
+/* Per-CPU statistics */
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+#  define IOB_CPUSTAT(f)         (g_iobcpustats[up_cpu_index()].f++)
+#else
+#  define IOB_CPUSTAT(f)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+/* A cache of free IOBs owned by one CPU.  The IOBs in a cache are not
+ * counted by g_iob_sem and g_throttle_sem.
+ */
+
+struct iob_cache_s
+{
+  spinlock_t ic_lock;            /* Protects the cache */
+  uint16_t ic_count;             /* The number of IOBs in the cache */
+  FAR struct iob_s *ic_head;     /* Free IOBs, linked by io_flink */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -95,6 +141,19 @@ extern sem_t g_throttle_sem;  /* Counts available I/O buffers when throttled */
 extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
 #endif
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+/* The per-CPU caches of free IOBs */
+
+extern struct iob_cache_s g_iob_cache[IOB_NCPUS];
+#endif
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+/* Per-CPU allocation statistics */
+
+extern struct iob_cpustats_s g_iobcpustats[IOB_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -134,6 +193,103 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_release
+ *
+ * Description:
+ *   Return one I/O buffer to the global free list, or to the committed list
+ *   if a thread is waiting for an IOB, and update the counting semaphores.
+ *   This function is intended only for internal use by the IOB module.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_release(FAR struct iob_s *iob);
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of this CPU.  Returns NULL if the
+ *   cache is empty, or if the allocation is throttled and the global pool
+ *   has reached the throttle limit.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_alloc(bool throttled);
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Put an I/O buffer into the cache of this CPU.  Returns false if the
+ *   cache is full or if the global pool is running low, in which case the
+ *   caller must return the IOB to the global pool.
+ *
+ ****************************************************************************/
+
+bool iob_cache_free(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_cache_refill
+ *
+ * Description:
+ *   Move a batch of I/O buffers from the global free list to the cache of
+ *   this CPU if the cache is empty and the global pool has enough free
+ *   IOBs.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_cache_refill(void);
+
+/****************************************************************************
+ * Name: iob_cache_detach
+ *
+ * Description:
+ *   Remove the I/O buffers that should be returned to the global pool from
+ *   the cache of this CPU:  A batch if the cache is full, or all of them if
+ *   the global pool is running low.  The IOBs are returned as a list
+ *   linked by io_flink.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_detach(void);
+
+/****************************************************************************
+ * Name: iob_cache_drain
+ *
+ * Description:
+ *   Return the I/O buffers of all CPU caches to the global pool.  This is
+ *   done before iob_tryalloc() fails, and so before a thread waits for an
+ *   IOB, so that IOBs do not remain unused in the cache of an idle CPU.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_cache_drain(void);
+
+/****************************************************************************
+ * Name: iob_cache_navail
+ *
+ * Description:
+ *   Return the number of I/O buffers held in the CPU caches.
+ *
+ ****************************************************************************/
+
+int iob_cache_navail(void);
+#endif /* CONFIG_IOB_PERCPU_CACHE > 0 */
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
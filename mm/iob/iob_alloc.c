@@ -145,6 +145,15 @@ static FAR struct iob_s *iob_allocwait(bool throttled,
        * list.
        */
 
+      if (throttled)
+        {
+          IOB_CPUSTAT(throttlewaits);
+        }
+      else
+        {
+          IOB_CPUSTAT(waits);
+        }
+
       ret = nxsem_wait_uninterruptible(sem);
       if (ret >= 0)
         {
@@ -243,12 +252,49 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
   sem = (throttled ? &g_throttle_sem : &g_iob_sem);
 #endif
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Try the cache of this CPU first.  This does not need the critical
+   * section and so does not serialize with the other CPUs.
+   */
+
+  iob = iob_cache_alloc(throttled);
+  if (iob != NULL)
+    {
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onalloc(consumerid);
+      IOB_CPUSTAT(allochits);
+#endif
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+      return iob;
+    }
+#endif
+
   /* We don't know what context we are called from so we use extreme measures
    * to protect the free list:  We disable interrupts very briefly.
    */
 
   flags = enter_critical_section();
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* The IOBs in the caches of the other CPUs are not counted in the global
+   * pool.  Return them to it before the allocation fails.
+   */
+
+  if (g_iob_freelist == NULL
+#if CONFIG_IOB_THROTTLE > 0
+      || sem->semcount <= 0
+#endif
+     )
+    {
+      iob_cache_drain();
+    }
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
   /* If there are free I/O buffers for this allocation */
 
@@ -289,6 +335,13 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
           iob_stats_onalloc(consumerid);
+          IOB_CPUSTAT(allocmisses);
+#endif
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+          /* Take a batch of IOBs for the next allocations on this CPU */
+
+          iob_cache_refill();
 #endif
 
           leave_critical_section(flags);
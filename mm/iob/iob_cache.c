@@ -0,0 +1,304 @@
+/****************************************************************************
+ * mm/iob/iob_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#if CONFIG_IOB_PERCPU_CACHE > 0
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The per-CPU caches of free IOBs.  A CPU accesses its own cache with only
+ * local interrupts disabled; the spinlock is contended only when another
+ * CPU drains the cache before waiting for an IOB.
+ */
+
+struct iob_cache_s g_iob_cache[IOB_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_take
+ *
+ * Description:
+ *   Remove up to 'count' IOBs from a cache.  The cache must be locked.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_cache_take(FAR struct iob_cache_s *cache,
+                                        unsigned int count)
+{
+  FAR struct iob_s *head = cache->ic_head;
+  FAR struct iob_s *tail = NULL;
+  FAR struct iob_s *iob;
+
+  for (iob = head; count > 0 && iob != NULL; count--)
+    {
+      tail = iob;
+      iob  = iob->io_flink;
+      cache->ic_count--;
+    }
+
+  if (tail == NULL)
+    {
+      return NULL;
+    }
+
+  cache->ic_head = iob;
+  tail->io_flink = NULL;
+  return head;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of this CPU.  Returns NULL if the
+ *   cache is empty, or if the allocation is throttled and the global pool
+ *   has reached the throttle limit.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_alloc(bool throttled)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob = NULL;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &g_iob_cache[up_cpu_index()];
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* The cached IOBs are not counted by the semaphores.  A throttled
+   * allocation may use them only while the global pool is above the
+   * throttle limit.
+   */
+
+  if (!throttled || g_throttle_sem.semcount > 0)
+#endif
+    {
+      spin_lock(&cache->ic_lock);
+
+      iob = cache->ic_head;
+      if (iob != NULL)
+        {
+          cache->ic_head = iob->io_flink;
+          cache->ic_count--;
+        }
+
+      spin_unlock(&cache->ic_lock);
+    }
+
+  up_irq_restore(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Put an I/O buffer into the cache of this CPU.  Returns false if the
+ *   cache is full or if the global pool is running low, in which case the
+ *   caller must return the IOB to the global pool.
+ *
+ ****************************************************************************/
+
+bool iob_cache_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_cache_s *cache;
+  irqstate_t flags;
+  bool cached = false;
+
+  flags = up_irq_save();
+  cache = &g_iob_cache[up_cpu_index()];
+
+  /* Threads may be waiting for the IOB if the global pool is low */
+
+  if (g_iob_sem.semcount > IOB_CACHE_RESERVE)
+    {
+      spin_lock(&cache->ic_lock);
+
+      if (cache->ic_count < CONFIG_IOB_PERCPU_CACHE)
+        {
+          iob->io_flink  = cache->ic_head;
+          cache->ic_head = iob;
+          cache->ic_count++;
+          cached         = true;
+        }
+
+      spin_unlock(&cache->ic_lock);
+    }
+
+  up_irq_restore(flags);
+  return cached;
+}
+
+/****************************************************************************
+ * Name: iob_cache_refill
+ *
+ * Description:
+ *   Move a batch of I/O buffers from the global free list to the cache of
+ *   this CPU if the cache is empty and the global pool has enough free
+ *   IOBs.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_cache_refill(void)
+{
+  FAR struct iob_cache_s *cache = &g_iob_cache[up_cpu_index()];
+  FAR struct iob_s *iob;
+
+  spin_lock(&cache->ic_lock);
+
+  while (cache->ic_count < IOB_CACHE_BATCH &&
+         g_iob_sem.semcount > IOB_CACHE_RESERVE &&
+         (iob = g_iob_freelist) != NULL)
+    {
+      g_iob_freelist = iob->io_flink;
+
+      /* The IOB leaves the global pool just as if it were allocated */
+
+      g_iob_sem.semcount--;
+#if CONFIG_IOB_THROTTLE > 0
+      g_throttle_sem.semcount--;
+#endif
+
+      iob->io_flink  = cache->ic_head;
+      cache->ic_head = iob;
+      cache->ic_count++;
+    }
+
+  spin_unlock(&cache->ic_lock);
+}
+
+/****************************************************************************
+ * Name: iob_cache_detach
+ *
+ * Description:
+ *   Remove the I/O buffers that should be returned to the global pool from
+ *   the cache of this CPU:  A batch if the cache is full, or all of them if
+ *   the global pool is running low.  The IOBs are returned as a list
+ *   linked by io_flink.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_detach(void)
+{
+  FAR struct iob_cache_s *cache = &g_iob_cache[up_cpu_index()];
+  FAR struct iob_s *iob = NULL;
+
+  spin_lock(&cache->ic_lock);
+
+  if (g_iob_sem.semcount <= IOB_CACHE_RESERVE)
+    {
+      iob = iob_cache_take(cache, CONFIG_IOB_PERCPU_CACHE);
+    }
+  else if (cache->ic_count >= CONFIG_IOB_PERCPU_CACHE)
+    {
+      iob = iob_cache_take(cache, IOB_CACHE_BATCH);
+    }
+
+  spin_unlock(&cache->ic_lock);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_cache_drain
+ *
+ * Description:
+ *   Return the I/O buffers of all CPU caches to the global pool.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_cache_drain(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob;
+  FAR struct iob_s *next;
+  int cpu;
+
+  for (cpu = 0; cpu < IOB_NCPUS; cpu++)
+    {
+      cache = &g_iob_cache[cpu];
+
+      spin_lock(&cache->ic_lock);
+      iob = iob_cache_take(cache, CONFIG_IOB_PERCPU_CACHE);
+      spin_unlock(&cache->ic_lock);
+
+      for (; iob != NULL; iob = next)
+        {
+          next = iob->io_flink;
+          iob_release(iob);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: iob_cache_navail
+ *
+ * Description:
+ *   Return the number of I/O buffers held in the CPU caches.
+ *
+ ****************************************************************************/
+
+int iob_cache_navail(void)
+{
+  int navail = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < IOB_NCPUS; cpu++)
+    {
+      navail += g_iob_cache[cpu].ic_count;
+    }
+
+  return navail;
+}
+
+#endif /* CONFIG_IOB_PERCPU_CACHE > 0 */
@@ -77,6 +77,53 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_release
+ *
+ * Description:
+ *   Return one I/O buffer to the global free list, or to the committed list
+ *   if a thread is waiting for an IOB, and update the counting semaphores.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_release(FAR struct iob_s *iob)
+{
+  /* Which list?  If there is a task waiting for an IOB, then put
+   * the IOB on either the free list or on the committed list where
+   * it is reserved for that allocation (and not available to
+   * iob_tryalloc()).
+   */
+
+  if (g_iob_sem.semcount < 0)
+    {
+      iob->io_flink   = g_iob_committed;
+      g_iob_committed = iob;
+    }
+  else
+    {
+      iob->io_flink   = g_iob_freelist;
+      g_iob_freelist  = iob;
+    }
+
+  /* Signal that an IOB is available.  If there is a thread blocked,
+   * waiting for an IOB, this will wake up exactly one thread.  The
+   * semaphore count will correctly indicated that the awakened task
+   * owns an IOB and should find it in the committed list.
+   */
+
+  nxsem_post(&g_iob_sem);
+  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+
+#if CONFIG_IOB_THROTTLE > 0
+  nxsem_post(&g_throttle_sem);
+  DEBUGASSERT(g_throttle_sem.semcount <=
+              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+#endif
+}
+
 /****************************************************************************
  * Name: iob_free
  *
@@ -128,6 +175,20 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
               next, next->io_pktlen, next->io_len);
     }
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Keep the I/O buffer in the cache of this CPU if possible */
+
+  if (iob_cache_free(iob))
+    {
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onfree(producerid);
+      IOB_CPUSTAT(freehits);
+#endif
+      return next;
+    }
+#endif
+
   /* Free the I/O buffer by adding it to the head of the free or the
    * committed list. We don't know what context we are called from so
    * we use extreme measures to protect the free list:  We disable
@@ -136,41 +197,26 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 
   flags = enter_critical_section();
 
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
+#if CONFIG_IOB_PERCPU_CACHE > 0
+  /* Return a batch of IOBs from the cache of this CPU along with this one
+   * so that the cache has room for the next frees.
    */
 
-  if (g_iob_sem.semcount < 0)
-    {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
-    }
-  else
+  iob->io_flink = iob_cache_detach();
+  while (iob != NULL)
     {
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
+      FAR struct iob_s *flink = iob->io_flink;
+      iob_release(iob);
+      iob = flink;
     }
-
-  /* Signal that an IOB is available.  If there is a thread blocked,
-   * waiting for an IOB, this will wake up exactly one thread.  The
-   * semaphore count will correctly indicated that the awakened task
-   * owns an IOB and should find it in the committed list.
-   */
-
-  nxsem_post(&g_iob_sem);
-  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+#else
+  iob_release(iob);
+#endif
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
   iob_stats_onfree(producerid);
-#endif
-
-#if CONFIG_IOB_THROTTLE > 0
-  nxsem_post(&g_throttle_sem);
-  DEBUGASSERT(g_throttle_sem.semcount <=
-              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+  IOB_CPUSTAT(freemisses);
 #endif
 
 #ifdef CONFIG_IOB_NOTIFIER
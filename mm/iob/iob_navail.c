@@ -70,6 +70,12 @@ int iob_navail(bool throttled)
     {
       ret = navail;
 
+#if CONFIG_IOB_PERCPU_CACHE > 0
+      /* The IOBs in the CPU caches are free, too */
+
+      ret += iob_cache_navail();
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
       /* Subtract the throttle value is so requested */
 
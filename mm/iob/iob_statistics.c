@@ -46,6 +46,8 @@
 
 #include <nuttx/mm/iob.h>
 
+#include "iob.h"
+
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
 
@@ -54,6 +56,7 @@
  ****************************************************************************/
 
 struct iob_userstats_s g_iobuserstats[IOBUSER_NENTRIES];
+struct iob_cpustats_s g_iobcpustats[IOB_NCPUS];
 
 /****************************************************************************
  * Public Functions
@@ -129,5 +132,30 @@ FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid)
   return &g_iobuserstats[userid];
 }
 
+/****************************************************************************
+ * Name: iob_getcpustats
+ *
+ * Description:
+ *   Return a reference to the IOB allocation statistics of a CPU
+ *
+ * Input Parameters:
+ *   cpu - The index of the CPU
+ *
+ * Returned Value:
+ *   A reference to the statistics, or NULL if 'cpu' is not a valid CPU
+ *   index.
+ *
+ ****************************************************************************/
+
+FAR struct iob_cpustats_s *iob_getcpustats(int cpu)
+{
+  if (cpu < 0 || cpu >= IOB_NCPUS)
+    {
+      return NULL;
+    }
+
+  return &g_iobcpustats[cpu];
+}
+
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
         * !CONFIG_FS_PROCFS_EXCLUDE_IOBINFO */
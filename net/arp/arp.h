@@ -415,6 +415,88 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr);
 
 void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr);
 
+/****************************************************************************
+ * Name: arp_queue
+ *
+ * Description:
+ *   Queue the IPv4 packet in d_buf until the MAC address of 'ipaddr' has
+ *   been resolved.  An incomplete ARP table entry is created for the
+ *   address if there is none.  If the queue of the entry is full, the
+ *   oldest packet is discarded.
+ *
+ * Input Parameters:
+ *   dev    - The device that is sending the packet
+ *   ipaddr - The next hop IPv4 address to be resolved
+ *
+ * Returned Value:
+ *   Zero (OK) if the packet was queued.  A negated errno value is returned
+ *   if the packet could not be queued.  d_buf is not modified in any case.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_PENDING
+int arp_queue(FAR struct net_driver_s *dev, in_addr_t ipaddr);
+#else
+#  define arp_queue(d,i) (-ENOSYS)
+#endif
+
+/****************************************************************************
+ * Name: arp_pending_poll
+ *
+ * Description:
+ *   Send the packets queued by arp_queue() on 'dev' whose next hop address
+ *   has been resolved, and discard those that waited too long for the ARP
+ *   response.  Each packet is placed in d_buf and passed to the driver
+ *   callback as an outgoing IPv4 packet.
+ *
+ * Input Parameters:
+ *   dev      - The device being polled
+ *   callback - The driver poll callback
+ *
+ * Returned Value:
+ *   The value returned by the last callback; non-zero if polling should
+ *   stop.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver indirectly through
+ *   devif_poll() and devif_timer().  The network must be locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_PENDING
+int arp_pending_poll(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback);
+#else
+#  define arp_pending_poll(d,c) (0)
+#endif
+
+/****************************************************************************
+ * Name: arp_pending_flush
+ *
+ * Description:
+ *   Discard the packets queued by arp_queue() on 'dev'.  Called when the
+ *   device is unregistered, so that no ARP response refers to it later.
+ *
+ * Input Parameters:
+ *   dev - The device being unregistered
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_PENDING
+void arp_pending_flush(FAR struct net_driver_s *dev);
+#else
+#  define arp_pending_flush(d)
+#endif
+
 /****************************************************************************
  * Name: arp_snapshot
  *
@@ -478,6 +560,9 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_update(i,m);
 #  define arp_hdr_update(i,m);
 #  define arp_snapshot(s,n) (0)
+#  define arp_queue(d,i) (-ENOSYS)
+#  define arp_pending_poll(d,c) (0)
+#  define arp_pending_flush(d)
 #  define arp_dump(arp)
 
 #endif /* CONFIG_NET_ARP */
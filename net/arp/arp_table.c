@@ -55,9 +55,11 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
 #include <nuttx/net/arp.h>
 #include <nuttx/net/ip.h>
 
@@ -70,7 +72,30 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
+#define ARP_MAXAGE_TICK     SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
+
+/* Packets queued on an entry that is still unresolved after this time are
+ * discarded.
+ */
+
+#define ARP_INCOMPLETE_TICK SEC2TICK(3)
+
+/* The number of hash chains.  Chains and the free entry search use the
+ * entry index + 1 so that the zero-initialized table is valid.
+ */
+
+#define ARP_HASHSIZE        CONFIG_NET_ARPTAB_SIZE
+#define ARP_NOENTRY         0
+
+/* Values of te_flags */
+
+#define ARP_FLAG_INCOMPLETE (1 << 0) /* Waiting for the ARP response */
+
+#ifdef CONFIG_NET_STATISTICS
+#  define ARP_STAT(f)       (g_netstats.arp.f++)
+#else
+#  define ARP_STAT(f)
+#endif
 
 /****************************************************************************
  * Private Types
@@ -82,13 +107,37 @@ struct arp_table_info_s
   FAR struct ether_addr *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+/* One entry in the ARP table together with its table management state */
+
+struct arp_table_entry_s
+{
+  struct arp_entry_s       te_entry;   /* The exported ARP table entry */
+  uint16_t                 te_next;    /* Next entry on the same hash chain */
+  uint8_t                  te_flags;   /* See ARP_FLAG_* definitions */
+#ifdef CONFIG_NET_ARP_PENDING
+  uint8_t                  te_npending; /* Number of queued packets */
+  FAR struct net_driver_s *te_dev;     /* Device that queued the packets */
+  FAR struct iob_s        *te_pending[CONFIG_NET_ARP_MAXPENDING];
+#endif
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 /* The table of known address mappings */
 
-static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static struct arp_table_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+
+/* The head of each hash chain */
+
+static uint16_t g_arphash[ARP_HASHSIZE];
+
+#ifdef CONFIG_NET_ARP_PENDING
+/* The number of entries that hold queued packets */
+
+static uint16_t g_arpnpending;
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -141,32 +190,178 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_hash
+ *
+ * Description:
+ *   Return the hash chain for an IPv4 address.  The high bits of a
+ *   multiplicative hash are used since hosts on the same subnet differ
+ *   only in the last octets of the address.
+ *
+ ****************************************************************************/
+
+static inline unsigned int arp_hash(in_addr_t ipaddr)
+{
+  return (((uint32_t)ipaddr * 0x9e3779b1) >> 16) % ARP_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: arp_find_entry
+ *
+ * Description:
+ *   Find the table entry of an IPv4 address, whether it is resolved,
+ *   incomplete or expired.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_entry_s *arp_find_entry(in_addr_t ipaddr)
+{
+  FAR struct arp_table_entry_s *tabptr;
+  uint16_t ndx;
+
+  for (ndx = g_arphash[arp_hash(ipaddr)];
+       ndx != ARP_NOENTRY;
+       ndx = tabptr->te_next)
+    {
+      tabptr = &g_arptable[ndx - 1];
+      if (net_ipv4addr_cmp(ipaddr, tabptr->te_entry.at_ipaddr))
+        {
+          return tabptr;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_unlink
+ *
+ * Description:
+ *   Remove an entry from its hash chain.
+ *
+ ****************************************************************************/
+
+static void arp_unlink(FAR struct arp_table_entry_s *tabptr)
+{
+  FAR uint16_t *link = &g_arphash[arp_hash(tabptr->te_entry.at_ipaddr)];
+  uint16_t ndx       = tabptr - g_arptable + 1;
+
+  while (*link != ARP_NOENTRY)
+    {
+      if (*link == ndx)
+        {
+          *link = tabptr->te_next;
+          break;
+        }
+
+      link = &g_arptable[*link - 1].te_next;
+    }
+
+  tabptr->te_next = ARP_NOENTRY;
+}
+
+/****************************************************************************
+ * Name: arp_dequeue
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Remove the oldest packet queued on an entry.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+#ifdef CONFIG_NET_ARP_PENDING
+static FAR struct iob_s *arp_dequeue(FAR struct arp_table_entry_s *tabptr)
 {
-  if (e1->at_ipaddr == 0)
+  FAR struct iob_s *iob = tabptr->te_pending[0];
+
+  memmove(&tabptr->te_pending[0], &tabptr->te_pending[1],
+          (CONFIG_NET_ARP_MAXPENDING - 1) * sizeof(FAR struct iob_s *));
+
+  if (--tabptr->te_npending == 0)
     {
-      return e1;
+      tabptr->te_dev = NULL;
+      g_arpnpending--;
     }
-  else if (e2->at_ipaddr == 0)
+
+  return iob;
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_free_pending
+ *
+ * Description:
+ *   Discard all packets queued on an entry.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_PENDING
+static void arp_free_pending(FAR struct arp_table_entry_s *tabptr)
+{
+  while (tabptr->te_npending > 0)
     {
-      return e2;
+      iob_free_chain(arp_dequeue(tabptr), IOBUSER_NET_ARP);
+      ARP_STAT(dropped);
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+}
+#else
+#  define arp_free_pending(t)
+#endif
+
+/****************************************************************************
+ * Name: arp_alloc_entry
+ *
+ * Description:
+ *   Claim a table entry for an IPv4 address that is not in the table.  A
+ *   free entry is used if there is one, otherwise the oldest entry is
+ *   evicted.  The new entry is linked into its hash chain.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_entry_s *arp_alloc_entry(in_addr_t ipaddr)
+{
+  FAR struct arp_table_entry_s *tabptr = &g_arptable[0];
+  FAR uint16_t *head;
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; i++)
     {
-      return e1;
+      FAR struct arp_table_entry_s *candidate = &g_arptable[i];
+
+      if (candidate->te_entry.at_ipaddr == 0)
+        {
+          /* A free entry, use it */
+
+          tabptr = candidate;
+          break;
+        }
+
+      if ((int)(candidate->te_entry.at_time - tabptr->te_entry.at_time) < 0)
+        {
+          /* Record the oldest entry */
+
+          tabptr = candidate;
+        }
     }
-  else
+
+  if (tabptr->te_entry.at_ipaddr != 0)
     {
-      return e2;
+      ninfo("Evict ARP entry for %08lx\n",
+            (unsigned long)tabptr->te_entry.at_ipaddr);
+
+      arp_unlink(tabptr);
+      arp_free_pending(tabptr);
+      ARP_STAT(evicted);
     }
+
+  /* Link the entry at the head of its hash chain */
+
+  head                       = &g_arphash[arp_hash(ipaddr)];
+  tabptr->te_entry.at_ipaddr = ipaddr;
+  tabptr->te_flags           = 0;
+  tabptr->te_next            = *head;
+  *head                      = tabptr - g_arptable + 1;
+
+  ARP_STAT(added);
+  return tabptr;
 }
 
 /****************************************************************************
@@ -195,43 +390,42 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
+  FAR struct arp_table_entry_s *tabptr;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* The unspecified address marks unused entries (and is used as the
+   * sender address of ARP probes).  It is never added to the table.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  if (ipaddr == 0)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
+      return -EINVAL;
+    }
 
-          tabptr = &g_arptable[i];
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
+  /* Find the entry to update.  If none is found, the IP -> MAC address
+   * mapping is inserted in the ARP table.
+   */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+  tabptr = arp_find_entry(ipaddr);
+  if (tabptr == NULL)
+    {
+      tabptr = arp_alloc_entry(ipaddr);
     }
 
-  /* Now, tabptr is the ARP table entry which we will fill with the new
-   * information.
-   */
+  memcpy(tabptr->te_entry.at_ethaddr.ether_addr_octet, ethaddr,
+         ETHER_ADDR_LEN);
+  tabptr->te_entry.at_time = clock_systime_ticks();
+
+#ifdef CONFIG_NET_ARP_PENDING
+  /* If packets are waiting for this mapping, let the device send them */
 
-  tabptr->at_ipaddr = ipaddr;
-  memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_time = clock_systime_ticks();
+  if ((tabptr->te_flags & ARP_FLAG_INCOMPLETE) != 0 &&
+      tabptr->te_npending > 0)
+    {
+      netdev_txnotify_dev(tabptr->te_dev);
+    }
+#endif
+
+  tabptr->te_flags &= ~ARP_FLAG_INCOMPLETE;
   return OK;
 }
 
@@ -281,23 +475,23 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
 
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
-  int i;
+  FAR struct arp_table_entry_s *tabptr;
 
-  /* Check if the IPv4 address is already in the ARP table. */
+  /* Check if the IPv4 address is already in the ARP table and has been
+   * resolved recently enough.
+   */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  tabptr = arp_find_entry(ipaddr);
+  if (tabptr != NULL && (tabptr->te_flags & ARP_FLAG_INCOMPLETE) == 0 &&
+      clock_systime_ticks() - tabptr->te_entry.at_time <= ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      ARP_STAT(hits);
+      return &tabptr->te_entry;
     }
 
   /* Not found */
 
+  ARP_STAT(misses);
   return NULL;
 }
 
@@ -380,18 +574,231 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
 void arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_table_entry_s *tabptr;
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
+  tabptr = arp_find_entry(ipaddr);
   if (tabptr != NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Unlink it and set the IP address to zero to "delete" it */
+
+      arp_unlink(tabptr);
+      arp_free_pending(tabptr);
+
+      tabptr->te_entry.at_ipaddr = 0;
+      tabptr->te_flags           = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: arp_queue
+ *
+ * Description:
+ *   Queue the IPv4 packet in d_buf until the MAC address of 'ipaddr' has
+ *   been resolved.  An incomplete ARP table entry is created for the
+ *   address if there is none.  If the queue of the entry is full, the
+ *   oldest packet is discarded.
+ *
+ * Input Parameters:
+ *   dev    - The device that is sending the packet
+ *   ipaddr - The next hop IPv4 address to be resolved
+ *
+ * Returned Value:
+ *   Zero (OK) if the packet was queued.  A negated errno value is returned
+ *   if the packet could not be queued.  d_buf is not modified in any case.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_PENDING
+int arp_queue(FAR struct net_driver_s *dev, in_addr_t ipaddr)
+{
+  FAR struct arp_table_entry_s *tabptr;
+  FAR struct iob_s *iob;
+  int ret;
+
+  if (ipaddr == 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Copy the IPv4 packet into an I/O buffer chain */
+
+  iob = iob_tryalloc(false, IOBUSER_NET_ARP);
+  if (iob == NULL)
+    {
+      ARP_STAT(dropped);
+      return -ENOMEM;
+    }
+
+  ret = iob_trycopyin(iob, &dev->d_buf[NET_LL_HDRLEN(dev)], dev->d_len, 0,
+                      false, IOBUSER_NET_ARP);
+  if (ret < 0)
+    {
+      iob_free_chain(iob, IOBUSER_NET_ARP);
+      ARP_STAT(dropped);
+      return ret;
+    }
+
+  /* Find or create the incomplete entry.  An expired entry is re-used and
+   * becomes incomplete until the response to the new request arrives.
+   */
+
+  tabptr = arp_find_entry(ipaddr);
+  if (tabptr == NULL)
+    {
+      tabptr = arp_alloc_entry(ipaddr);
+    }
+
+  if ((tabptr->te_flags & ARP_FLAG_INCOMPLETE) == 0)
+    {
+      tabptr->te_flags        |= ARP_FLAG_INCOMPLETE;
+      tabptr->te_entry.at_time = clock_systime_ticks();
+    }
+
+  if (tabptr->te_npending > 0 && tabptr->te_dev != dev)
+    {
+      /* The packets were queued by another device; the next hop moved */
+
+      arp_free_pending(tabptr);
+    }
+
+  if (tabptr->te_npending >= CONFIG_NET_ARP_MAXPENDING)
+    {
+      /* The queue is full, discard the oldest packet */
+
+      iob_free_chain(arp_dequeue(tabptr), IOBUSER_NET_ARP);
+      ARP_STAT(dropped);
+    }
+
+  if (tabptr->te_npending == 0)
+    {
+      g_arpnpending++;
+    }
+
+  tabptr->te_dev = dev;
+  tabptr->te_pending[tabptr->te_npending++] = iob;
+
+  ARP_STAT(queued);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_pending_poll
+ *
+ * Description:
+ *   Send the packets queued by arp_queue() on 'dev' whose next hop address
+ *   has been resolved, and discard those that waited too long for the ARP
+ *   response.  Each packet is placed in d_buf and passed to the driver
+ *   callback as an outgoing IPv4 packet.
+ *
+ * Input Parameters:
+ *   dev      - The device being polled
+ *   callback - The driver poll callback
+ *
+ * Returned Value:
+ *   The value returned by the last callback; non-zero if polling should
+ *   stop.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver indirectly through
+ *   devif_poll() and devif_timer().  The network must be locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_PENDING
+int arp_pending_poll(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback)
+{
+  FAR struct arp_table_entry_s *tabptr;
+  FAR struct iob_s *iob;
+  clock_t now;
+  int bstop = 0;
+  int i;
+
+  if (g_arpnpending == 0)
+    {
+      return 0;
+    }
+
+  now = clock_systime_ticks();
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE && !bstop; i++)
+    {
+      tabptr = &g_arptable[i];
+      if (tabptr->te_npending == 0 || tabptr->te_dev != dev)
+        {
+          continue;
+        }
+
+      if ((tabptr->te_flags & ARP_FLAG_INCOMPLETE) != 0)
+        {
+          if (now - tabptr->te_entry.at_time > ARP_INCOMPLETE_TICK)
+            {
+              /* No response, give up */
+
+              arp_free_pending(tabptr);
+            }
+
+          continue;
+        }
 
-      tabptr->at_ipaddr = 0;
+      /* The address has been resolved, send the packets in order */
+
+      while (tabptr->te_npending > 0 && !bstop)
+        {
+          iob           = arp_dequeue(tabptr);
+          dev->d_len    = iob->io_pktlen;
+          dev->d_sndlen = 0;
+          iob_copyout(&dev->d_buf[NET_LL_HDRLEN(dev)], iob, dev->d_len, 0);
+          iob_free_chain(iob, IOBUSER_NET_ARP);
+
+          IFF_SET_IPv4(dev->d_flags);
+          ARP_STAT(sent);
+
+          bstop = callback(dev);
+        }
+    }
+
+  return bstop;
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_pending_flush
+ *
+ * Description:
+ *   Discard the packets queued by arp_queue() on 'dev'.  Called when the
+ *   device is unregistered, so that no ARP response refers to it later.
+ *
+ * Input Parameters:
+ *   dev - The device being unregistered
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_PENDING
+void arp_pending_flush(FAR struct net_driver_s *dev)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE && g_arpnpending > 0; i++)
+    {
+      if (g_arptable[i].te_npending > 0 && g_arptable[i].te_dev == dev)
+        {
+          arp_free_pending(&g_arptable[i]);
+        }
     }
 }
+#endif
 
 /****************************************************************************
  * Name: arp_snapshot
@@ -417,22 +824,24 @@ void arp_delete(in_addr_t ipaddr)
 unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
                           unsigned int nentries)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_table_entry_s *tabptr;
   clock_t now;
   unsigned int ncopied;
   int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all resolved, non-expired entries in the ARP table. */
 
   for (i = 0, now = clock_systime_ticks(), ncopied = 0;
        nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
        i++)
     {
       tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      if (tabptr->te_entry.at_ipaddr != 0 &&
+          (tabptr->te_flags & ARP_FLAG_INCOMPLETE) == 0 &&
+          now - tabptr->te_entry.at_time <= ARP_MAXAGE_TICK)
         {
-          memcpy(&snapshot[ncopied], tabptr, sizeof(struct arp_entry_s));
+          memcpy(&snapshot[ncopied], &tabptr->te_entry,
+                 sizeof(struct arp_entry_s));
           ncopied++;
         }
     }
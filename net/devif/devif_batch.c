@@ -0,0 +1,434 @@
+/****************************************************************************
+ * net/devif/devif_batch.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/arp.h>
+#include <nuttx/net/pkt.h>
+
+#ifdef CONFIG_NET_ETHERNET
+#  include <nuttx/net/ethernet.h>
+#endif
+
+#ifdef CONFIG_NET_BATCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* These are helper pointers for accessing the contents of the headers */
+
+#define ETHBUF  ((FAR struct eth_hdr_s *)dev->d_buf)
+#define IPv4BUF ((FAR struct ipv4_hdr_s *)(dev->d_buf + dev->d_llhdrlen))
+#define IPv6BUF ((FAR struct ipv6_hdr_s *)(dev->d_buf + dev->d_llhdrlen))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_batch_ethernet
+ *
+ * Description:
+ *   Return true if the device uses an Ethernet link layer header.
+ *
+ ****************************************************************************/
+
+static inline bool devif_batch_ethernet(FAR struct net_driver_s *dev)
+{
+#ifdef CONFIG_NET_ETHERNET
+  return dev->d_lltype == NET_LL_ETHERNET ||
+         dev->d_lltype == NET_LL_IEEE80211;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: devif_batch_llout
+ *
+ * Description:
+ *   Complete the Ethernet header of the outgoing IPv4 or IPv6 packet in
+ *   d_buf.
+ *
+ ****************************************************************************/
+
+static void devif_batch_llout(FAR struct net_driver_s *dev)
+{
+  if (!devif_batch_ethernet(dev))
+    {
+      return;
+    }
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (IFF_IS_IPv4(dev->d_flags))
+#endif
+    {
+      arp_out(dev);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      neighbor_out(dev);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+/****************************************************************************
+ * Name: devif_batch_txpoll
+ *
+ * Description:
+ *   The devif_poll() callback of devif_poll_batch().  Add the packet built
+ *   in the tail descriptor to the ring and let the network build the next
+ *   packet in the following descriptor.
+ *
+ ****************************************************************************/
+
+static int devif_batch_txpoll(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_ring_s *ring = dev->d_txring;
+
+  if (dev->d_len > 0)
+    {
+      devif_batch_llout(dev);
+
+      /* A packet addressed to the device itself does not use the ring:
+       * devif_loopback() passes it and any response to it through the
+       * input path right away, as devif_poll() callbacks of drivers do.
+       * It may therefore be received before the packets that are already
+       * in the ring have been transmitted.
+       */
+
+      if (!devif_loopback(dev))
+        {
+          /* A timer poll keeps the last free descriptor as a spare buffer
+           * for the TCP connections that are updated after the ring has
+           * filled up.  What they build there is dropped and resent by
+           * their retransmission timers.
+           */
+
+          if (ring->nr_timer && ring->nr_count + 1 >= ring->nr_size)
+            {
+              ninfo("Ring full, dropped %u bytes\n", dev->d_len);
+              dev->d_len = 0;
+              return 1;
+            }
+
+          NETDEV_RING_TAIL(ring)->nd_len = dev->d_len;
+          NETDEV_RING_PUT(ring);
+
+          /* Stop polling when there is no room for another packet */
+
+          if (NETDEV_RING_FULL(ring))
+            {
+              return 1;
+            }
+
+          dev->d_buf = NETDEV_RING_TAIL(ring)->nd_buf;
+          return ring->nr_timer && ring->nr_count + 1 >= ring->nr_size;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: devif_batch_poll
+ *
+ * Description:
+ *   Common logic of devif_poll_batch() and devif_timer_batch().  A timer
+ *   poll needs a spare descriptor besides the one for the first packet.
+ *   Without that room, its delay is kept in the ring and passed to the
+ *   network by the next poll that finds the room.
+ *
+ ****************************************************************************/
+
+static int devif_batch_poll(FAR struct net_driver_s *dev,
+                            FAR struct netdev_ring_s *ring, int delay)
+{
+  FAR uint8_t *buf = dev->d_buf;
+  uint16_t count = ring->nr_count;
+
+  DEBUGASSERT(ring->nr_desc != NULL && ring->nr_size > 1);
+
+  delay         += ring->nr_delay;
+  ring->nr_delay = 0;
+
+  if (delay > 0 && ring->nr_count + 2 > ring->nr_size)
+    {
+      ring->nr_delay = delay;
+      delay          = 0;
+    }
+
+  if (NETDEV_RING_FULL(ring))
+    {
+      return 0;
+    }
+
+  dev->d_txring  = ring;
+  dev->d_buf     = NETDEV_RING_TAIL(ring)->nd_buf;
+  ring->nr_timer = delay > 0;
+
+  if (ring->nr_timer)
+    {
+      devif_timer(dev, delay, devif_batch_txpoll);
+    }
+  else
+    {
+      devif_poll(dev, devif_batch_txpoll);
+    }
+
+  ring->nr_timer = false;
+  dev->d_txring  = NULL;
+  dev->d_buf     = buf;
+  return ring->nr_count - count;
+}
+
+/****************************************************************************
+ * Name: devif_batch_input
+ *
+ * Description:
+ *   Pass the received packet in d_buf to the network and send any
+ *   response through the callback.
+ *
+ ****************************************************************************/
+
+static void devif_batch_input(FAR struct net_driver_s *dev,
+                              devif_poll_callback_t callback)
+{
+#ifdef CONFIG_NET_ETHERNET
+  if (devif_batch_ethernet(dev))
+    {
+      if (dev->d_len <= ETH_HDRLEN)
+        {
+          NETDEV_RXERRORS(dev);
+          return;
+        }
+
+#ifdef CONFIG_NET_PKT
+      /* When packet sockets are enabled, feed the frame into the tap */
+
+      pkt_input(dev);
+#endif
+
+#ifdef CONFIG_NET_IPv4
+      if (ETHBUF->type == HTONS(ETHTYPE_IP))
+        {
+          ninfo("IPv4 frame\n");
+          NETDEV_RXIPV4(dev);
+
+          arp_ipin(dev);
+          ipv4_input(dev);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_IPv6
+      if (ETHBUF->type == HTONS(ETHTYPE_IP6))
+        {
+          ninfo("IPv6 frame\n");
+          NETDEV_RXIPV6(dev);
+
+          ipv6_input(dev);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_ARP
+      if (ETHBUF->type == HTONS(ETHTYPE_ARP))
+        {
+          ninfo("ARP frame\n");
+          NETDEV_RXARP(dev);
+
+          /* An ARP response is a complete frame */
+
+          arp_arpin(dev);
+          if (dev->d_len > 0)
+            {
+              callback(dev);
+            }
+
+          return;
+        }
+      else
+#endif
+        {
+          nwarn("WARNING: Unsupported Ethernet type %u\n", ETHBUF->type);
+          NETDEV_RXDROPPED(dev);
+          return;
+        }
+    }
+  else
+#endif /* CONFIG_NET_ETHERNET */
+    {
+      /* Devices without a link layer header carry raw IP packets.  The
+       * version is read from the first byte, which must be present.
+       */
+
+      if (dev->d_len == 0)
+        {
+          NETDEV_RXERRORS(dev);
+          return;
+        }
+
+#ifdef CONFIG_NET_PKT
+      pkt_input(dev);
+#endif
+
+#ifdef CONFIG_NET_IPv4
+      if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION)
+        {
+          ninfo("IPv4 packet\n");
+          NETDEV_RXIPV4(dev);
+
+          ipv4_input(dev);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_IPv6
+      if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION)
+        {
+          ninfo("IPv6 packet\n");
+          NETDEV_RXIPV6(dev);
+
+          ipv6_input(dev);
+        }
+      else
+#endif
+        {
+          nwarn("WARNING: Unrecognized IP version\n");
+          NETDEV_RXDROPPED(dev);
+          return;
+        }
+    }
+
+  /* Check for a response to the IP packet */
+
+  if (dev->d_len > 0)
+    {
+      devif_batch_llout(dev);
+      callback(dev);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_poll_batch and devif_timer_batch
+ *
+ * Description:
+ *   Batched versions of devif_poll() and devif_timer().  Instead of calling
+ *   a driver callback for each outgoing packet, the packets are built
+ *   directly in the buffers of the free descriptors of 'ring' and added to
+ *   the ring.  Polling stops when the ring is full, except for the TCP
+ *   timers of a timer poll (see devif_batch_txpoll()).
+ *
+ * Input Parameters:
+ *   dev   - The network device to be polled
+ *   ring  - The ring that receives the outgoing packets
+ *   delay - The time elapsed since the last timer poll (devif_timer_batch)
+ *
+ * Returned Value:
+ *   The number of packets added to the ring.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int devif_poll_batch(FAR struct net_driver_s *dev,
+                     FAR struct netdev_ring_s *ring)
+{
+  return devif_batch_poll(dev, ring, 0);
+}
+
+int devif_timer_batch(FAR struct net_driver_s *dev,
+                      FAR struct netdev_ring_s *ring, int delay)
+{
+  return devif_batch_poll(dev, ring, delay);
+}
+
+/****************************************************************************
+ * Name: devif_input_batch
+ *
+ * Description:
+ *   Pass all of the received packets held in 'ring' to the network, oldest
+ *   first, removing them from the ring.  Responses are sent through the
+ *   callback.
+ *
+ * Input Parameters:
+ *   dev      - The network device that received the packets
+ *   ring     - The ring holding the received packets
+ *   callback - Driver function that sends any response in d_buf
+ *
+ * Returned Value:
+ *   The number of packets passed to the network.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int devif_input_batch(FAR struct net_driver_s *dev,
+                      FAR struct netdev_ring_s *ring,
+                      devif_poll_callback_t callback)
+{
+  FAR struct netdev_desc_s *desc;
+  FAR uint8_t *buf = dev->d_buf;
+  int npkts = 0;
+
+  DEBUGASSERT(callback != NULL);
+
+  while (!NETDEV_RING_EMPTY(ring))
+    {
+      desc = NETDEV_RING_HEAD(ring);
+      NETDEV_RING_GET(ring);
+
+      dev->d_buf = desc->nd_buf;
+      dev->d_len = desc->nd_len;
+      NETDEV_RXPACKETS(dev);
+
+      devif_batch_input(dev, callback);
+      npkts++;
+    }
+
+  dev->d_buf = buf;
+  dev->d_len = 0;
+  return npkts;
+}
+
+#endif /* CONFIG_NET_BATCH */
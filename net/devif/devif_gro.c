@@ -0,0 +1,604 @@
+/****************************************************************************
+ * net/devif/devif_gro.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_GRO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Only pure data segments (ACK with optional PSH) are merged */
+
+#define GRO_TCP_FLAGS (TCP_ACK | TCP_PSH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Describes the headers of one received TCP segment */
+
+struct gro_pkt_s
+{
+  FAR uint8_t *iphdr;          /* Start of the IP header */
+  FAR struct tcp_hdr_s *tcp;   /* Start of the TCP header */
+  uint16_t iphdrlen;           /* Size of the IP header */
+  uint16_t tcphdrlen;          /* Size of the TCP header incl. options */
+  uint16_t hdrlen;             /* Link layer + IP + TCP header size */
+  uint16_t paylen;             /* Size of the TCP payload */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gro_add
+ *
+ * Description:
+ *   One's complement addition of two 16-bit values.
+ *
+ ****************************************************************************/
+
+static inline uint16_t gro_add(uint16_t a, uint16_t b)
+{
+  uint16_t sum = a + b;
+  return sum < b ? sum + 1 : sum;
+}
+
+/****************************************************************************
+ * Name: gro_isipv6
+ ****************************************************************************/
+
+static inline bool gro_isipv6(FAR const uint8_t *iphdr)
+{
+#ifdef CONFIG_NET_IPv6
+  return (iphdr[0] & IP_VERSION_MASK) == IPv6_VERSION;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: gro_parse
+ *
+ * Description:
+ *   Check whether the frame in buf is a TCP data segment for this host
+ *   that may be merged and, if so, describe its headers in pkt.
+ *
+ ****************************************************************************/
+
+static bool gro_parse(FAR struct net_driver_s *dev, FAR uint8_t *buf,
+                      uint16_t len, FAR struct gro_pkt_s *pkt)
+{
+  uint16_t llhdrlen = NET_LL_HDRLEN(dev);
+  uint16_t iplen = 0;
+
+  pkt->iphdr    = &buf[llhdrlen];
+  pkt->iphdrlen = 0;
+
+#ifdef CONFIG_NET_IPv4
+  if ((pkt->iphdr[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)pkt->iphdr;
+
+      /* No IP options, no fragments and addressed to us */
+
+      if (len < llhdrlen + IPv4_HDRLEN + TCP_HDRLEN ||
+          ipv4->vhl != 0x45 || ipv4->proto != IP_PROTO_TCP ||
+          (ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0 ||
+          !net_ipv4addr_hdrcmp(ipv4->destipaddr, &dev->d_ipaddr))
+        {
+          return false;
+        }
+
+      /* The header checksum of every merged frame must be verified here
+       * since only the header of the first frame is seen by ipv4_input().
+       */
+
+      if (!IFF_IS_NOCHKSUM(dev->d_flags) && ipv4_chksum(dev) != 0xffff)
+        {
+          return false;
+        }
+
+      pkt->iphdrlen = IPv4_HDRLEN;
+      iplen = ((uint16_t)ipv4->len[0] << 8) | ipv4->len[1];
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((pkt->iphdr[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)pkt->iphdr;
+
+      if (len < llhdrlen + IPv6_HDRLEN + TCP_HDRLEN ||
+          ipv6->proto != IP_PROTO_TCP ||
+          !net_ipv6addr_hdrcmp(ipv6->destipaddr, dev->d_ipv6addr))
+        {
+          return false;
+        }
+
+      pkt->iphdrlen = IPv6_HDRLEN;
+      iplen = (((uint16_t)ipv6->len[0] << 8) | ipv6->len[1]) + IPv6_HDRLEN;
+    }
+#endif
+
+  if (pkt->iphdrlen == 0 || llhdrlen + iplen > len)
+    {
+      return false;
+    }
+
+  pkt->tcp       = (FAR struct tcp_hdr_s *)&pkt->iphdr[pkt->iphdrlen];
+  pkt->tcphdrlen = (pkt->tcp->tcpoffset >> 4) << 2;
+  pkt->hdrlen    = llhdrlen + pkt->iphdrlen + pkt->tcphdrlen;
+
+  if (pkt->tcphdrlen < TCP_HDRLEN ||
+      pkt->iphdrlen + pkt->tcphdrlen >= iplen ||
+      (pkt->tcp->flags & TCP_ACK) == 0 ||
+      (pkt->tcp->flags & ~GRO_TCP_FLAGS) != 0)
+    {
+      return false;
+    }
+
+  pkt->paylen = iplen - pkt->iphdrlen - pkt->tcphdrlen;
+  return true;
+}
+
+/****************************************************************************
+ * Name: gro_hdrsum
+ *
+ * Description:
+ *   Return the one's complement sum of the TCP pseudo-header and of the
+ *   TCP header (including its checksum field) for a segment with paylen
+ *   bytes of payload.
+ *
+ ****************************************************************************/
+
+static uint16_t gro_hdrsum(FAR const struct gro_pkt_s *pkt, uint16_t paylen)
+{
+  uint16_t sum = pkt->tcphdrlen + paylen + IP_PROTO_TCP;
+
+#ifdef CONFIG_NET_IPv6
+  if (gro_isipv6(pkt->iphdr))
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)pkt->iphdr;
+
+      sum = chksum(sum, (FAR uint8_t *)ipv6->srcipaddr,
+                   2 * sizeof(net_ipv6addr_t));
+    }
+  else
+#endif
+    {
+#ifdef CONFIG_NET_IPv4
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)pkt->iphdr;
+
+      sum = chksum(sum, (FAR uint8_t *)ipv4->srcipaddr,
+                   2 * sizeof(in_addr_t));
+#endif
+    }
+
+  return chksum(sum, (FAR uint8_t *)pkt->tcp, pkt->tcphdrlen);
+}
+
+/****************************************************************************
+ * Name: gro_paysum
+ *
+ * Description:
+ *   Return the one's complement sum of the payload of a segment.  The TCP
+ *   checksum of a valid segment sums to 0xffff, so the payload sum is the
+ *   complement of the header sum and need not be computed over the data.
+ *   Any corruption of the payload is still detected when tcp_input()
+ *   verifies the checksum of the merged segment.
+ *
+ ****************************************************************************/
+
+static inline uint16_t gro_paysum(FAR const struct gro_pkt_s *pkt)
+{
+  return ~gro_hdrsum(pkt, pkt->paylen);
+}
+
+/****************************************************************************
+ * Name: gro_held
+ *
+ * Description:
+ *   Describe the headers of the frame held in the aggregation buffer.
+ *
+ ****************************************************************************/
+
+static void gro_held(FAR struct net_driver_s *dev,
+                     FAR struct gro_pkt_s *pkt)
+{
+  FAR struct netdev_gro_s *gro = &dev->d_gro;
+
+  pkt->iphdr     = &gro->ng_buf[NET_LL_HDRLEN(dev)];
+  pkt->hdrlen    = gro->ng_hdrlen;
+  pkt->paylen    = gro->ng_len - gro->ng_hdrlen;
+
+  /* The held frame has no IP options; the TCP header ends at hdrlen */
+
+#ifdef CONFIG_NET_IPv6
+  if (gro_isipv6(pkt->iphdr))
+    {
+      pkt->iphdrlen = IPv6_HDRLEN;
+    }
+  else
+#endif
+    {
+#ifdef CONFIG_NET_IPv4
+      pkt->iphdrlen = IPv4_HDRLEN;
+#endif
+    }
+
+  pkt->tcp       = (FAR struct tcp_hdr_s *)&pkt->iphdr[pkt->iphdrlen];
+  pkt->tcphdrlen = pkt->hdrlen - NET_LL_HDRLEN(dev) - pkt->iphdrlen;
+}
+
+/****************************************************************************
+ * Name: gro_match
+ *
+ * Description:
+ *   Return true if the segment described by pkt is the next in-order
+ *   segment of the flow held in the aggregation buffer and fits into it.
+ *
+ ****************************************************************************/
+
+static bool gro_match(FAR struct net_driver_s *dev,
+                      FAR const struct gro_pkt_s *held,
+                      FAR const struct gro_pkt_s *pkt)
+{
+  FAR struct netdev_gro_s *gro = &dev->d_gro;
+  uint32_t seqno;
+
+  if ((unsigned int)gro->ng_len + pkt->paylen > gro->ng_bufsize ||
+      held->hdrlen != pkt->hdrlen || held->iphdrlen != pkt->iphdrlen ||
+      (held->iphdr[0] & IP_VERSION_MASK) !=
+      (pkt->iphdr[0] & IP_VERSION_MASK))
+    {
+      return false;
+    }
+
+  /* Same ports and identical TCP options */
+
+  if (held->tcp->srcport != pkt->tcp->srcport ||
+      held->tcp->destport != pkt->tcp->destport ||
+      memcmp(held->tcp->optdata, pkt->tcp->optdata,
+             held->tcphdrlen - TCP_HDRLEN) != 0)
+    {
+      return false;
+    }
+
+  /* Same source address (the destination is always our address) */
+
+#ifdef CONFIG_NET_IPv6
+  if (gro_isipv6(pkt->iphdr))
+    {
+      if (!net_ipv6addr_cmp(
+            ((FAR struct ipv6_hdr_s *)held->iphdr)->srcipaddr,
+            ((FAR struct ipv6_hdr_s *)pkt->iphdr)->srcipaddr))
+        {
+          return false;
+        }
+    }
+  else
+#endif
+    {
+#ifdef CONFIG_NET_IPv4
+      FAR struct ipv4_hdr_s *h = (FAR struct ipv4_hdr_s *)held->iphdr;
+      FAR struct ipv4_hdr_s *p = (FAR struct ipv4_hdr_s *)pkt->iphdr;
+
+      if (h->srcipaddr[0] != p->srcipaddr[0] ||
+          h->srcipaddr[1] != p->srcipaddr[1])
+        {
+          return false;
+        }
+#endif
+    }
+
+  /* The new segment must immediately follow the held data */
+
+  seqno = tcp_getsequence(held->tcp->seqno) + held->paylen;
+  return seqno == tcp_getsequence(pkt->tcp->seqno);
+}
+
+/****************************************************************************
+ * Name: gro_hold
+ *
+ * Description:
+ *   Copy the frame in d_buf into the aggregation buffer.
+ *
+ ****************************************************************************/
+
+static void gro_hold(FAR struct net_driver_s *dev,
+                     FAR const struct gro_pkt_s *pkt)
+{
+  FAR struct netdev_gro_s *gro = &dev->d_gro;
+
+  gro->ng_len    = pkt->hdrlen + pkt->paylen;
+  gro->ng_hdrlen = pkt->hdrlen;
+  gro->ng_nsegs  = 1;
+  gro->ng_sum    = IFF_IS_NOCHKSUM(dev->d_flags) ? 0 : gro_paysum(pkt);
+
+  memcpy(gro->ng_buf, dev->d_buf, gro->ng_len);
+}
+
+/****************************************************************************
+ * Name: gro_merge
+ *
+ * Description:
+ *   Append the payload of the segment in d_buf to the held frame.
+ *
+ ****************************************************************************/
+
+static void gro_merge(FAR struct net_driver_s *dev,
+                      FAR const struct gro_pkt_s *held,
+                      FAR const struct gro_pkt_s *pkt)
+{
+  FAR struct netdev_gro_s *gro = &dev->d_gro;
+
+  if (!IFF_IS_NOCHKSUM(dev->d_flags))
+    {
+      uint16_t sum = gro_paysum(pkt);
+
+      /* Payload appended at an odd offset is summed byte-swapped */
+
+      if ((held->paylen & 1) != 0)
+        {
+          sum = (sum << 8) | (sum >> 8);
+        }
+
+      gro->ng_sum = gro_add(gro->ng_sum, sum);
+    }
+
+  memcpy(&gro->ng_buf[gro->ng_len], &dev->d_buf[pkt->hdrlen], pkt->paylen);
+
+  /* The acknowledgement, window and PSH flag of the most recent segment
+   * apply to the merged segment.
+   */
+
+  memcpy(held->tcp->ackno, pkt->tcp->ackno, 4);
+  memcpy(held->tcp->wnd, pkt->tcp->wnd, 2);
+  held->tcp->flags |= pkt->tcp->flags & TCP_PSH;
+
+  gro->ng_len += pkt->paylen;
+  gro->ng_nsegs++;
+}
+
+/****************************************************************************
+ * Name: gro_finish
+ *
+ * Description:
+ *   Update the lengths and checksums of a merged frame.  d_buf must refer
+ *   to the aggregation buffer.
+ *
+ ****************************************************************************/
+
+static void gro_finish(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_gro_s *gro = &dev->d_gro;
+  struct gro_pkt_s held;
+  uint16_t iplen = gro->ng_len - NET_LL_HDRLEN(dev);
+
+  gro_held(dev, &held);
+
+#ifdef CONFIG_NET_IPv6
+  if (gro_isipv6(held.iphdr))
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)held.iphdr;
+
+      iplen       -= IPv6_HDRLEN;
+      ipv6->len[0] = iplen >> 8;
+      ipv6->len[1] = iplen & 0xff;
+    }
+  else
+#endif
+    {
+#ifdef CONFIG_NET_IPv4
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)held.iphdr;
+
+      ipv4->len[0]   = iplen >> 8;
+      ipv4->len[1]   = iplen & 0xff;
+      ipv4->ipchksum = 0;
+
+      if (!IFF_IS_NOCHKSUM(dev->d_flags))
+        {
+          ipv4->ipchksum = ~ipv4_chksum(dev);
+        }
+#endif
+    }
+
+  if (!IFF_IS_NOCHKSUM(dev->d_flags))
+    {
+      uint16_t sum;
+
+      held.tcp->tcpchksum = 0;
+      sum = gro_add(gro_hdrsum(&held, held.paylen), gro->ng_sum);
+      held.tcp->tcpchksum = HTONS((uint16_t)~sum);
+    }
+}
+
+/****************************************************************************
+ * Name: gro_deliver
+ *
+ * Description:
+ *   Pass the held frame to the network and send any response.  d_buf is
+ *   preserved but d_len is not.
+ *
+ ****************************************************************************/
+
+static void gro_deliver(FAR struct net_driver_s *dev,
+                        devif_poll_callback_t callback)
+{
+  FAR struct netdev_gro_s *gro = &dev->d_gro;
+  FAR uint8_t *buf = dev->d_buf;
+
+  dev->d_buf = gro->ng_buf;
+  dev->d_len = gro->ng_len;
+
+  if (gro->ng_nsegs > 1)
+    {
+      gro_finish(dev);
+    }
+
+  gro->ng_len = 0;
+
+#ifdef CONFIG_NET_IPv6
+  if (gro_isipv6(&gro->ng_buf[NET_LL_HDRLEN(dev)]))
+    {
+      ipv6_input(dev);
+    }
+  else
+#endif
+    {
+#ifdef CONFIG_NET_IPv4
+      ipv4_input(dev);
+#endif
+    }
+
+  if (dev->d_len > 0)
+    {
+      callback(dev);
+    }
+
+  DEBUGASSERT(dev->d_buf == gro->ng_buf);
+  dev->d_buf = buf;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_gro_input
+ *
+ * Description:
+ *   Hold or merge the TCP segment in d_buf.  See include/nuttx/net/netdev.h.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int devif_gro_input(FAR struct net_driver_s *dev,
+                    devif_poll_callback_t callback)
+{
+  FAR struct netdev_gro_s *gro = &dev->d_gro;
+  struct gro_pkt_s pkt;
+  uint16_t len = dev->d_len;
+
+  DEBUGASSERT(callback != NULL);
+
+  if (gro->ng_buf == NULL)
+    {
+      return 0;
+    }
+
+  if (!gro_parse(dev, dev->d_buf, len, &pkt))
+    {
+      /* Not mergeable.  Flush any held frame first to preserve ordering. */
+
+      if (gro->ng_len > 0)
+        {
+          gro_deliver(dev, callback);
+          dev->d_len = len;
+        }
+
+      return 0;
+    }
+
+  if (gro->ng_len > 0)
+    {
+      struct gro_pkt_s held;
+
+      gro_held(dev, &held);
+      if (gro_match(dev, &held, &pkt))
+        {
+          gro_merge(dev, &held, &pkt);
+          dev->d_len = 0;
+
+          /* The sender wants the data delivered now */
+
+          if ((pkt.tcp->flags & TCP_PSH) != 0)
+            {
+              gro_deliver(dev, callback);
+              dev->d_len = 0;
+            }
+
+          return 1;
+        }
+
+      gro_deliver(dev, callback);
+      dev->d_len = len;
+    }
+
+  /* Start a new flow unless the segment should be delivered right away */
+
+  if ((pkt.tcp->flags & TCP_PSH) != 0 ||
+      pkt.hdrlen + pkt.paylen >= gro->ng_bufsize)
+    {
+      return 0;
+    }
+
+  gro_hold(dev, &pkt);
+  dev->d_len = 0;
+  return 1;
+}
+
+/****************************************************************************
+ * Name: devif_gro_flush
+ *
+ * Description:
+ *   Pass any held frame to the network.  See include/nuttx/net/netdev.h.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+void devif_gro_flush(FAR struct net_driver_s *dev,
+                     devif_poll_callback_t callback)
+{
+  DEBUGASSERT(callback != NULL);
+
+  if (dev->d_gro.ng_len > 0)
+    {
+      gro_deliver(dev, callback);
+    }
+
+  dev->d_len = 0;
+}
+
+#endif /* CONFIG_NET_GRO */
@@ -0,0 +1,240 @@
+/****************************************************************************
+ * net/devif/devif_gso.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "inet/inet.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_GSO
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gso_fixup
+ *
+ * Description:
+ *   Set the IP length field and recalculate the checksums of the segment
+ *   described by d_buf and d_len.
+ *
+ ****************************************************************************/
+
+static void gso_fixup(FAR struct net_driver_s *dev, FAR uint8_t *iphdr,
+                      unsigned int iphdrlen, FAR struct tcp_hdr_s *tcp)
+{
+  uint16_t iplen = dev->d_len - NET_LL_HDRLEN(dev);
+
+#ifdef CONFIG_NET_IPv4
+  if ((iphdr[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)iphdr;
+
+      ipv4->len[0]   = iplen >> 8;
+      ipv4->len[1]   = iplen & 0xff;
+      ipv4->ipchksum = 0;
+      tcp->tcpchksum = 0;
+
+      if (!IFF_IS_NOCHKSUM(dev->d_flags))
+        {
+          ipv4->ipchksum = ~ipv4_chksum(dev);
+          tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((iphdr[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)iphdr;
+
+      iplen         -= IPv6_HDRLEN;
+      ipv6->len[0]   = iplen >> 8;
+      ipv6->len[1]   = iplen & 0xff;
+      tcp->tcpchksum = 0;
+
+      if (!IFF_IS_NOCHKSUM(dev->d_flags))
+        {
+          tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+        }
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_gso_send
+ *
+ * Description:
+ *   Split a TCP super-segment into MSS-sized segments and pass each of them
+ *   to the driver callback.  See include/nuttx/net/netdev.h.
+ *
+ *   The segments are produced in place:  Segment n is formed by copying the
+ *   headers of segment n-1 immediately in front of its payload, overwriting
+ *   the tail of the payload of segment n-1 that has already been sent.  No
+ *   payload data is copied.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+int devif_gso_send(FAR struct net_driver_s *dev,
+                   devif_poll_callback_t callback)
+{
+  FAR struct tcp_hdr_s *tcp;
+  FAR uint8_t *buf = dev->d_buf;
+  FAR uint8_t *iphdr;
+  unsigned int llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int iphdrlen;
+  unsigned int hdrlen;
+  unsigned int remaining;
+  unsigned int offset;
+  unsigned int seglen;
+  unsigned int mss;
+  uint8_t flags;
+  int ret = 0;
+
+  DEBUGASSERT(dev != NULL && callback != NULL);
+
+  /* Packets that fit into the MTU are passed through unmodified */
+
+  if (dev->d_len <= dev->d_pktsize)
+    {
+      return callback(dev);
+    }
+
+  DEBUGASSERT(dev->d_len <= dev->d_gsosize);
+
+  /* Only TCP super-segments are ever built by the network */
+
+  iphdr    = &buf[llhdrlen];
+  iphdrlen = 0;
+
+#ifdef CONFIG_NET_IPv4
+  if ((iphdr[0] & IP_VERSION_MASK) == IPv4_VERSION &&
+      ((FAR struct ipv4_hdr_s *)iphdr)->proto == IP_PROTO_TCP)
+    {
+      iphdrlen = (iphdr[0] & IPv4_HLMASK) << 2;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((iphdr[0] & IP_VERSION_MASK) == IPv6_VERSION &&
+      ((FAR struct ipv6_hdr_s *)iphdr)->proto == IP_PROTO_TCP)
+    {
+      iphdrlen = IPv6_HDRLEN;
+    }
+#endif
+
+  if (iphdrlen == 0)
+    {
+      nwarn("WARNING: Oversized non-TCP packet dropped: %u\n", dev->d_len);
+      NETDEV_TXERRORS(dev);
+      dev->d_len = 0;
+      return 0;
+    }
+
+  tcp    = (FAR struct tcp_hdr_s *)&iphdr[iphdrlen];
+  hdrlen = llhdrlen + iphdrlen + ((tcp->tcpoffset >> 4) << 2);
+  flags  = tcp->flags;
+
+  /* Each segment carries at most d_gsomss bytes of payload.  The segment
+   * size is kept even so that the headers of every segment remain 16-bit
+   * aligned.
+   */
+
+  mss = dev->d_gsomss;
+  if (mss == 0 || mss > dev->d_pktsize - hdrlen)
+    {
+      mss = dev->d_pktsize - hdrlen;
+    }
+
+  mss      &= ~1;
+  remaining = dev->d_len - hdrlen;
+
+  for (offset = 0; remaining > 0; offset += mss)
+    {
+      FAR uint8_t *seg = &buf[offset];
+
+      seglen     = remaining > mss ? mss : remaining;
+      remaining -= seglen;
+
+      iphdr = &seg[llhdrlen];
+      tcp   = (FAR struct tcp_hdr_s *)&iphdr[iphdrlen];
+
+      if (offset > 0)
+        {
+          /* Move the headers of the previous segment in front of this
+           * payload and advance the sequence number.
+           */
+
+          memmove(seg, seg - mss, hdrlen);
+          net_incr32(tcp->seqno, mss);
+
+#ifdef CONFIG_NET_IPv4
+          if ((iphdr[0] & IP_VERSION_MASK) == IPv4_VERSION)
+            {
+              FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)iphdr;
+
+              /* Take the ID from the counter of the stack, as for any
+               * other packet, so that no later packet reuses it.
+               */
+
+              ++g_ipid;
+              ipv4->ipid[0] = g_ipid >> 8;
+              ipv4->ipid[1] = g_ipid & 0xff;
+            }
+#endif
+        }
+
+      /* FIN and PSH belong to the last segment only */
+
+      tcp->flags = remaining > 0 ? (flags & ~(TCP_FIN | TCP_PSH)) : flags;
+
+      dev->d_buf = seg;
+      dev->d_len = hdrlen + seglen;
+      gso_fixup(dev, iphdr, iphdrlen, tcp);
+
+      ret = callback(dev);
+    }
+
+  dev->d_buf = buf;
+  dev->d_len = 0;
+  return ret;
+}
+
+#endif /* CONFIG_NET_GSO */
@@ -70,7 +70,13 @@
 void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                     unsigned int len, unsigned int offset)
 {
+#ifdef CONFIG_NET_GSO
+  DEBUGASSERT(dev && len > 0 &&
+              len < (dev->d_gsosize > NETDEV_PKTSIZE(dev) ?
+                     dev->d_gsosize : NETDEV_PKTSIZE(dev)));
+#else
   DEBUGASSERT(dev && len > 0 && len < NETDEV_PKTSIZE(dev));
+#endif
 
   /* Copy the data from the I/O buffer chain to the device buffer */
 
@@ -47,6 +47,7 @@
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/net.h>
+#include <nuttx/net/netstats.h>
 
 #include "devif/devif.h"
 #include "arp/arp.h"
@@ -60,6 +61,7 @@
 #include "igmp/igmp.h"
 #include "icmpv6/icmpv6.h"
 #include "mld/mld.h"
+#include "neighbor/neighbor.h"
 #include "ipforward/ipforward.h"
 #include "sixlowpan/sixlowpan.h"
 
@@ -193,6 +195,31 @@ static void devif_packet_conversion(FAR struct net_driver_s *dev,
 #  define devif_packet_conversion(dev,pkttype)
 #endif /* CONFIG_NET_6LOWPAN */
 
+/****************************************************************************
+ * Name: devif_poll_latency
+ *
+ * Description:
+ *   If there is an outgoing packet, record the TX latency since the oldest
+ *   pending TX notification of the device.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LATENCY
+static inline void devif_poll_latency(FAR struct net_driver_s *dev)
+{
+  if (dev->d_len > 0 && dev->d_txstamp != 0)
+    {
+      net_latency_record(NET_LATENCY_TXPOLL, dev->d_txstamp);
+      dev->d_txstamp = 0;
+    }
+}
+#else
+#  define devif_poll_latency(dev)
+#endif
+
 /****************************************************************************
  * Name: devif_poll_pkt_connections
  *
@@ -223,6 +250,7 @@ static int devif_poll_pkt_connections(FAR struct net_driver_s *dev,
       /* Perform any necessary conversions on outgoing packets */
 
       devif_packet_conversion(dev, DEVIF_PKT);
+      devif_poll_latency(dev);
 
       /* Call back into the driver */
 
@@ -369,6 +397,7 @@ static inline int devif_poll_icmp(FAR struct net_driver_s *dev,
       /* Perform any necessary conversions on outgoing packets */
 
       devif_packet_conversion(dev, DEVIF_ICMP);
+      devif_poll_latency(dev);
 
       /* Call back into the driver */
 
@@ -409,6 +438,7 @@ static inline int devif_poll_icmpv6(FAR struct net_driver_s *dev,
       /* Perform any necessary conversions on outgoing packets */
 
       devif_packet_conversion(dev, DEVIF_ICMP6);
+      devif_poll_latency(dev);
 
       /* Call back into the driver */
 
@@ -537,6 +567,7 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
       /* Perform any necessary conversions on outgoing packets */
 
       devif_packet_conversion(dev, DEVIF_UDP);
+      devif_poll_latency(dev);
 
       /* Call back into the driver */
 
@@ -577,6 +608,7 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
       /* Perform any necessary conversions on outgoing packets */
 
       devif_packet_conversion(dev, DEVIF_TCP);
+      devif_poll_latency(dev);
 
       /* Call back into the driver */
 
@@ -612,7 +644,7 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
 
   /* Traverse all of the active TCP connections and perform the poll action. */
 
-  while (!bstop && (conn = tcp_nextconn(conn)))
+  while ((conn = tcp_nextconn(conn)) != NULL)
     {
       /* Perform the TCP timer poll */
 
@@ -624,7 +656,24 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
 
       /* Call back into the driver */
 
-      bstop = callback(dev);
+      if (callback(dev) != 0)
+        {
+          bstop = 1;
+
+#ifdef CONFIG_NET_BATCH
+          /* A batched driver keeps a spare buffer for the rest of the walk
+           * and drops what is built there; the connections resend it.
+           * Every connection still sees the elapsed time.
+           */
+
+          if (dev->d_txring != NULL)
+            {
+              continue;
+            }
+#endif
+
+          break;
+        }
     }
 
   return bstop;
@@ -670,6 +719,18 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
    * action.
    */
 
+#ifdef CONFIG_NET_ARP_PENDING
+  /* Send packets that were waiting for ARP resolution */
+
+  bstop = arp_pending_poll(dev, callback);
+  if (!bstop)
+#endif
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+  /* Send packets that were waiting for neighbor resolution */
+
+  bstop = neighbor_pending_poll(dev, callback);
+  if (!bstop)
+#endif
 #ifdef CONFIG_NET_ARP_SEND
   /* Check for pending ARP requests */
 
@@ -797,7 +858,10 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
  *   This function will call the provided callback function for every active
  *   connection. Polling will continue until all connections have been polled
  *   or until the user-supplied function returns a non-zero value (which it
- *   should do only if it cannot accept further write data).
+ *   should do only if it cannot accept further write data).  For a batched
+ *   driver polled through devif_timer_batch(), the TCP connections after
+ *   that point are still updated, and only the polling of other connections
+ *   is stopped.
  *
  *   When the callback function is called, there may be an outbound packet
  *   waiting for service in the device packet buffer, and if so the d_len field
@@ -328,7 +328,11 @@ nullreturn:
  *
  ****************************************************************************/
 
+#ifdef CONFIG_NET_LATENCY
+static int ipv4_in(FAR struct net_driver_s *dev)
+#else
 int ipv4_input(FAR struct net_driver_s *dev)
+#endif
 {
   FAR struct ipv4_hdr_s *ipv4 = BUF;
   in_addr_t destipaddr;
@@ -519,7 +523,7 @@ int ipv4_input(FAR struct net_driver_s *dev)
         }
     }
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!IFF_IS_NOCHKSUM(dev->d_flags) && ipv4_chksum(dev) != 0xffff)
     {
       /* Compute and check the IP header checksum. */
 
@@ -591,4 +595,36 @@ drop:
   dev->d_len = 0;
   return OK;
 }
+
+/****************************************************************************
+ * Name: ipv4_input
+ *
+ * Description:
+ *   Time stamp the packet for the latency instrumentation and let
+ *   ipv4_in() process it.  The latency is measured from the time stamp of
+ *   the driver if there is one, or from here otherwise.  The time stamp is
+ *   used by the upper layers while the packet is processed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LATENCY
+int ipv4_input(FAR struct net_driver_s *dev)
+{
+  int ret;
+
+  if (dev->d_rxstamp != 0)
+    {
+      net_latency_record(NET_LATENCY_IPIN, dev->d_rxstamp);
+    }
+  else
+    {
+      dev->d_rxstamp = net_latency_stamp();
+    }
+
+  ret = ipv4_in(dev);
+  dev->d_rxstamp = 0;
+  return ret;
+}
+#endif
+
 #endif /* CONFIG_NET_IPv4 */
@@ -271,7 +271,11 @@ static bool check_destipaddr(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
+#ifdef CONFIG_NET_LATENCY
+static int ipv6_in(FAR struct net_driver_s *dev)
+#else
 int ipv6_input(FAR struct net_driver_s *dev)
+#endif
 {
   FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
   FAR uint8_t *payload;
@@ -571,4 +575,36 @@ drop:
   dev->d_len = 0;
   return OK;
 }
+
+/****************************************************************************
+ * Name: ipv6_input
+ *
+ * Description:
+ *   Time stamp the packet for the latency instrumentation and let
+ *   ipv6_in() process it.  The latency is measured from the time stamp of
+ *   the driver if there is one, or from here otherwise.  The time stamp is
+ *   used by the upper layers while the packet is processed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LATENCY
+int ipv6_input(FAR struct net_driver_s *dev)
+{
+  int ret;
+
+  if (dev->d_rxstamp != 0)
+    {
+      net_latency_record(NET_LATENCY_IPIN, dev->d_rxstamp);
+    }
+  else
+    {
+      dev->d_rxstamp = net_latency_stamp();
+    }
+
+  ret = ipv6_in(dev);
+  dev->d_rxstamp = 0;
+  return ret;
+}
+#endif
+
 #endif /* CONFIG_NET_IPv6 */
@@ -71,6 +71,7 @@
 struct devif_callback_s; /* Forward reference */
 struct net_driver_s;     /* Forward reference */
 struct iob_s;            /* Forward reference */
+union ip_addr_u;         /* Forward reference */
 
 struct forward_s
 {
@@ -375,5 +376,69 @@ void ipv4_dropstats(FAR struct ipv4_hdr_s *ipv4);
 #  define ipv4_dropstats(ipv4)
 #endif
 
+/****************************************************************************
+ * Name: ipfwd_flow_lookup
+ *
+ * Description:
+ *   Return the device that forwards the packets to a destination address
+ *   received on a device, if that flow is in the cache.
+ *
+ * Input Parameters:
+ *   dev    - The device that received the packet
+ *   domain - PF_INET or PF_INET6
+ *   dest   - The destination address of the packet
+ *
+ * Returned Value:
+ *   The forwarding device or NULL if the flow is not in the cache.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+FAR struct net_driver_s *
+ipfwd_flow_lookup(FAR struct net_driver_s *dev, uint8_t domain,
+                  FAR const union ip_addr_u *dest);
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flow_add
+ *
+ * Description:
+ *   Remember the device that forwards the packets to a destination address
+ *   received on a device.
+ *
+ * Input Parameters:
+ *   dev    - The device that received the packet
+ *   domain - PF_INET or PF_INET6
+ *   dest   - The destination address of the packet
+ *   fwddev - The device that forwards the packet
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipfwd_flow_add(FAR struct net_driver_s *dev, uint8_t domain,
+                    FAR const union ip_addr_u *dest,
+                    FAR struct net_driver_s *fwddev);
+#endif
+
 #endif /* CONFIG_NET_IPFORWARD */
+
+/****************************************************************************
+ * Name: ipfwd_flowflush
+ *
+ * Description:
+ *   Invalidate all entries of the flow cache.  This must be called when
+ *   the routing table, the address of a device or the registration and the
+ *   state of a device change.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipfwd_flowflush(void);
+#else
+#  define ipfwd_flowflush()
+#endif
+
 #endif /* __NET_IPFORWARD_IPFORWARD_H */
@@ -128,6 +128,7 @@ void ipv6_dropstats(FAR struct ipv6_hdr_s *ipv6)
     }
 
   g_netstats.ipv6.drop++;
+  g_netstats.ipfwd.dropped++;
 }
 #endif
 
@@ -158,6 +159,7 @@ void ipv4_dropstats(FAR struct ipv4_hdr_s *ipv4)
     }
 
   g_netstats.ipv4.drop++;
+  g_netstats.ipfwd.dropped++;
 }
 #endif
 
@@ -0,0 +1,294 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_flowcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One entry of the flow cache.  An entry is valid only if it was added in
+ * the current generation of the cache.
+ */
+
+struct ipfwd_flow_s
+{
+  FAR struct net_driver_s *fl_dev;     /* The device that received the flow */
+  FAR struct net_driver_s *fl_fwddev;  /* The device that forwards the flow */
+  uint32_t                 fl_gen;     /* Generation of the entry */
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  uint8_t                  fl_domain;  /* Domain: PF_INET or PF_INET6 */
+#endif
+  union ip_addr_u          fl_dest;    /* Destination address of the flow */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct ipfwd_flow_s g_ipfwd_flows[CONFIG_NET_IPFORWARD_NFLOWS];
+
+/* The current generation.  It starts at one so that the zeroed entries
+ * are not valid.
+ */
+
+static uint32_t g_ipfwd_flowgen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_flow_hash
+ *
+ * Description:
+ *   Return the cache entry of a destination address received on a device.
+ *
+ ****************************************************************************/
+
+static FAR struct ipfwd_flow_s *
+ipfwd_flow_hash(FAR struct net_driver_s *dev, uint8_t domain,
+                FAR const union ip_addr_u *dest)
+{
+  uint32_t hash = (uint32_t)((uintptr_t)dev >> 4);
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET)
+#endif
+    {
+      hash ^= dest->ipv4;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      int i;
+
+      for (i = 0; i < 8; i += 2)
+        {
+          hash ^= ((uint32_t)dest->ipv6[i] << 16) | dest->ipv6[i + 1];
+        }
+    }
+#endif
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return &g_ipfwd_flows[hash % CONFIG_NET_IPFORWARD_NFLOWS];
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_match
+ *
+ * Description:
+ *   Return true if a valid cache entry holds the destination address.
+ *
+ ****************************************************************************/
+
+static bool ipfwd_flow_match(FAR struct ipfwd_flow_s *flow,
+                             FAR struct net_driver_s *dev, uint8_t domain,
+                             FAR const union ip_addr_u *dest)
+{
+  if (flow->fl_gen != g_ipfwd_flowgen || flow->fl_dev != dev)
+    {
+      return false;
+    }
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  if (flow->fl_domain != domain)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET)
+#endif
+    {
+      return net_ipv4addr_cmp(flow->fl_dest.ipv4, dest->ipv4);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return net_ipv6addr_cmp(flow->fl_dest.ipv6, dest->ipv6);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_flow_lookup
+ *
+ * Description:
+ *   Return the device that forwards the packets to a destination address
+ *   received on a device, if that flow is in the cache.
+ *
+ * Input Parameters:
+ *   dev    - The device that received the packet
+ *   domain - PF_INET or PF_INET6
+ *   dest   - The destination address of the packet
+ *
+ * Returned Value:
+ *   The forwarding device or NULL if the flow is not in the cache.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct net_driver_s *
+ipfwd_flow_lookup(FAR struct net_driver_s *dev, uint8_t domain,
+                  FAR const union ip_addr_u *dest)
+{
+  FAR struct ipfwd_flow_s *flow = ipfwd_flow_hash(dev, domain, dest);
+
+  if (ipfwd_flow_match(flow, dev, domain, dest))
+    {
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.ipfwd.flowhits++;
+#endif
+      return flow->fl_fwddev;
+    }
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.ipfwd.flowmisses++;
+#endif
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: ipfwd_flow_add
+ *
+ * Description:
+ *   Remember the device that forwards the packets to a destination address
+ *   received on a device.  The entry replaces any other flow with the same
+ *   hash.
+ *
+ * Input Parameters:
+ *   dev    - The device that received the packet
+ *   domain - PF_INET or PF_INET6
+ *   dest   - The destination address of the packet
+ *   fwddev - The device that forwards the packet
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_flow_add(FAR struct net_driver_s *dev, uint8_t domain,
+                    FAR const union ip_addr_u *dest,
+                    FAR struct net_driver_s *fwddev)
+{
+  FAR struct ipfwd_flow_s *flow = ipfwd_flow_hash(dev, domain, dest);
+
+  flow->fl_dev    = dev;
+  flow->fl_fwddev = fwddev;
+  flow->fl_gen    = g_ipfwd_flowgen;
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  flow->fl_domain = domain;
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET)
+#endif
+    {
+      net_ipv4addr_copy(flow->fl_dest.ipv4, dest->ipv4);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      net_ipv6addr_copy(flow->fl_dest.ipv6, dest->ipv6);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: ipfwd_flowflush
+ *
+ * Description:
+ *   Invalidate all entries of the flow cache.  This must be called when
+ *   anything that affects the selection of the forwarding device changes:
+ *   The routing table, the address of a device or the registration and the
+ *   state of a device.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ipfwd_flowflush(void)
+{
+  net_lock();
+
+  /* Entries of older generations are no longer valid.  On the (unlikely)
+   * wrap-around, the entries must be cleared for real.
+   */
+
+  if (++g_ipfwd_flowgen == 0)
+    {
+      memset(g_ipfwd_flows, 0, sizeof(g_ipfwd_flows));
+      g_ipfwd_flowgen = 1;
+    }
+
+  net_unlock();
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FLOWCACHE */
@@ -451,11 +451,32 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
   destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
   srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
 
-  fwddev     = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Packets of a known flow skip the device and route lookups */
+
+  fwddev = ipfwd_flow_lookup(dev, PF_INET,
+                             (FAR const union ip_addr_u *)&destipaddr);
   if (fwddev == NULL)
+#endif
     {
-      nwarn("WARNING: Not routable\n");
-      return (ssize_t)-ENETUNREACH;
+      fwddev = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+      if (fwddev == NULL)
+        {
+          nwarn("WARNING: Not routable\n");
+          return (ssize_t)-ENETUNREACH;
+        }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* The device selected for the broadcast address depends on the
+       * source address, so that is not a flow.
+       */
+
+      if (!net_ipv4addr_cmp(destipaddr, INADDR_BROADCAST))
+        {
+          ipfwd_flow_add(dev, PF_INET,
+                         (FAR const union ip_addr_u *)&destipaddr, fwddev);
+        }
+#endif
     }
 
   /* Check if we are forwarding on the same device that we received the
@@ -481,6 +502,23 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
        * endpoints, but seems less useful for a wired network.
        */
 
+#ifdef CONFIG_NET_IPFORWARD_INPLACE
+      /* The packet is sent back from d_buf without any copy.  Only the TTL
+       * needs to be updated, the driver rebuilds the link layer header for
+       * the new destination as it does for any response.
+       */
+
+      if (ipv4_decr_ttl(ipv4) < 1)
+        {
+          nwarn("WARNING: Hop limit exceeded... Dropping!\n");
+          ret = -EMULTIHOP;
+          goto drop;
+        }
+
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.ipfwd.inplace++;
+#endif
+#else
 #ifdef CONFIG_NET_ETHERNET
       /* REVISIT:  For Ethernet we may have to fix up the Ethernet header:
        * - source MAC, the MAC of the current device.
@@ -495,6 +533,7 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
       nwarn("WARNING: Packet forwarding to same device not supportedN\n");
       ret = -ENOSYS;
       goto drop;
+#endif /* CONFIG_NET_IPFORWARD_INPLACE */
     }
 
   /* Return success.  ipv4_input will return to the network driver with
@@ -502,6 +541,9 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
    * the transfer.
    */
 
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.ipfwd.forwarded++;
+#endif
   return OK;
 
 drop:
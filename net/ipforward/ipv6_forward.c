@@ -583,11 +583,25 @@ int ipv6_forward(FAR struct net_driver_s *dev, FAR struct ipv6_hdr_s *ipv6)
 
   /* Search for a device that can forward this packet. */
 
-  fwddev = netdev_findby_ripv6addr(ipv6->srcipaddr, ipv6->destipaddr);
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Packets of a known flow skip the device and route lookups */
+
+  fwddev = ipfwd_flow_lookup(dev, PF_INET6,
+                             (FAR const union ip_addr_u *)ipv6->destipaddr);
   if (fwddev == NULL)
+#endif
     {
-      nwarn("WARNING: Not routable\n");
-      return (ssize_t)-ENETUNREACH;
+      fwddev = netdev_findby_ripv6addr(ipv6->srcipaddr, ipv6->destipaddr);
+      if (fwddev == NULL)
+        {
+          nwarn("WARNING: Not routable\n");
+          return (ssize_t)-ENETUNREACH;
+        }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      ipfwd_flow_add(dev, PF_INET6,
+                     (FAR const union ip_addr_u *)ipv6->destipaddr, fwddev);
+#endif
     }
 
   /* Check if we are forwarding on the same device that we received the
@@ -651,6 +665,24 @@ int ipv6_forward(FAR struct net_driver_s *dev, FAR struct ipv6_hdr_s *ipv6)
         }
     }
 
+#elif defined(CONFIG_NET_IPFORWARD_INPLACE)
+    {
+      /* The packet is sent back from d_buf without any copy.  Only the hop
+       * limit needs to be updated, the driver rebuilds the link layer
+       * header for the new destination as it does for any response.
+       */
+
+      if (ipv6_decr_ttl(ipv6) < 1)
+        {
+          nwarn("WARNING: Hop limit exceeded... Dropping!\n");
+          ret = -EMULTIHOP;
+          goto drop;
+        }
+
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.ipfwd.inplace++;
+#endif
+    }
 #else /* CONFIG_NET_6LOWPAN */
     {
       nwarn("WARNING: Packet forwarding not supported in this configuration\n");
@@ -664,6 +696,9 @@ int ipv6_forward(FAR struct net_driver_s *dev, FAR struct ipv6_hdr_s *ipv6)
    * the transfer.
    */
 
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.ipfwd.forwarded++;
+#endif
   return OK;
 
 drop:
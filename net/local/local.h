@@ -74,6 +74,28 @@
 #define LOCAL_SYNC_BYTE   0x42     /* Byte in sync sequence */
 #define LOCAL_END_BYTE    0xbd     /* End of sync sequence */
 
+#ifdef CONFIG_NET_LOCAL_RING
+/* Large messages may be lent to the receiver only if it can access the
+ * memory of the sender.
+ */
+
+#if CONFIG_NET_LOCAL_RING_LENDSIZE > 0 && !defined(CONFIG_BUILD_KERNEL)
+#  define HAVE_LOCAL_LEND 1
+#endif
+
+/* Bits in lr_flags */
+
+#define LOCAL_RING_RDCLOSED (1 << 0) /* The receiving socket was closed */
+#define LOCAL_RING_WRCLOSED (1 << 1) /* The sending stream peer was closed */
+
+/* The maximum number of descriptors passed in one SCM_RIGHTS message */
+
+#define LOCAL_SCM_MAXFDS  16
+
+#define SIZEOF_LOCAL_FDS(n) \
+  (sizeof(struct local_fds_s) + ((n) - 1) * sizeof(struct local_fd_s))
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -108,6 +130,75 @@ enum local_state_s
   LOCAL_STATE_DISCONNECTED     /* Peer disconnected */
 };
 
+#ifdef CONFIG_NET_LOCAL_RING
+/* A descriptor in flight.  The ring holds its own reference on the file or
+ * socket until the receiver installs it or the message is discarded.
+ */
+
+struct local_fd_s
+{
+  bool lf_socket;              /* True: u.lf_sock, false: u.lf_file */
+  union
+  {
+    struct file lf_file;       /* Reference to the passed file */
+    struct socket lf_sock;     /* Reference to the passed socket */
+  } u;
+};
+
+/* The descriptors passed with one SCM_RIGHTS message */
+
+struct local_fds_s
+{
+  int lf_nfds;                 /* Number of descriptors in lf_fds[] */
+  struct local_fd_s lf_fds[1]; /* Actual size given by lf_nfds */
+};
+
+/* A large message lent by a blocked sender */
+
+struct local_lend_s
+{
+  FAR const uint8_t *ll_buf;   /* The buffer of the sender */
+  size_t ll_len;               /* Length of the message */
+  size_t ll_offset;            /* Bytes consumed by the receiver */
+  bool ll_done;                /* The receiver no longer needs ll_buf */
+  sem_t ll_donesem;            /* Wakes the sender when ll_done is set */
+};
+
+/* Each message in the ring begins with this header.  The message data
+ * follows the header, unless the message was lent.
+ */
+
+struct local_hdr_s
+{
+  FAR struct local_lend_s *lh_lend; /* Lent message or NULL */
+  FAR struct local_fds_s *lh_fds;   /* Passed descriptors or NULL */
+  uint32_t lh_len;                  /* Length of the message data */
+  bool lh_dropped;                  /* The sender withdrew the message */
+};
+
+/* The receive ring of a socket */
+
+struct local_ring_s
+{
+  uint8_t lr_crefs;            /* Reference count */
+  uint8_t lr_flags;            /* See LOCAL_RING_* definitions */
+  uint8_t lr_nrdwait;          /* Number of readers waiting on lr_rdsem */
+  uint8_t lr_nwrwait;          /* Number of writers waiting on lr_wrsem */
+  bool lr_reading;             /* lr_hdr is the message being read */
+  uint16_t lr_head;            /* Index of the first byte in lr_buf */
+  uint16_t lr_count;           /* Number of bytes in lr_buf */
+  uint32_t lr_offset;          /* Bytes of lr_hdr already read */
+  struct local_hdr_s lr_hdr;   /* Header of the message being read */
+  sem_t lr_rdsem;              /* Wait for data */
+  sem_t lr_wrsem;              /* Wait for space */
+#ifdef HAVE_LOCAL_POLL
+  FAR struct pollfd *lr_rdfds[LOCAL_NPOLLWAITERS]; /* Waiting for POLLIN */
+  FAR struct pollfd *lr_wrfds[LOCAL_NPOLLWAITERS]; /* Waiting for POLLOUT */
+#endif
+  uint8_t lr_buf[CONFIG_NET_LOCAL_RING_SIZE];
+};
+#endif /* CONFIG_NET_LOCAL_RING */
+
 /* Representation of a local connection.  There are four types of
  * connection structures:
  *
@@ -160,6 +251,10 @@ struct local_conn_s
   char lc_path[UNIX_PATH_MAX]; /* Path assigned by bind() */
   int32_t lc_instance_id;      /* Connection instance ID for stream
                                 * server<->client connection pair */
+#ifdef CONFIG_NET_LOCAL_RING
+  FAR struct local_ring_s *lc_rxring; /* Receive ring (peers, bound dgram) */
+  FAR struct local_ring_s *lc_txring; /* Receive ring of the peer */
+#endif
 
 #ifdef CONFIG_NET_LOCAL_STREAM
   /* SOCK_STREAM fields common to both client and server */
@@ -230,12 +325,19 @@ EXTERN const struct sock_intf_s g_local_sockif;
 EXTERN dq_queue_t g_local_listeners;
 #endif
 
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_LOCAL_DGRAM)
+/* A list of all SOCK_DGRAM sockets bound to a path */
+
+EXTERN dq_queue_t g_local_dgrams;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
 struct sockaddr; /* Forward reference */
 struct socket;   /* Forward reference */
+struct msghdr;   /* Forward reference */
 
 /****************************************************************************
  * Name: local_initialize
@@ -714,6 +816,213 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds);
 int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds);
 #endif
 
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Create the two receive rings that connect a SOCK_STREAM client with
+ *   the new server-side peer created by accept().
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_LOCAL_STREAM)
+int local_ring_connect(FAR struct local_conn_s *client,
+                       FAR struct local_conn_s *server);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_bind
+ *
+ * Description:
+ *   Create the receive ring of a SOCK_DGRAM socket bound to a path and make
+ *   the socket visible to senders.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_LOCAL_DGRAM)
+int local_ring_bind(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_find
+ *
+ * Description:
+ *   Return the receive ring of the SOCK_DGRAM socket bound to 'path' with
+ *   an additional reference, or NULL if there is no such socket.  The
+ *   reference must be dropped with local_ring_release().
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_LOCAL_DGRAM)
+FAR struct local_ring_s *local_ring_find(FAR const char *path);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Drop a reference to a ring, freeing it with the last reference.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_release(FAR struct local_ring_s *ring);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_detach
+ *
+ * Description:
+ *   Disconnect a socket that is being freed from its rings.  The peer sees
+ *   end-of-file or a broken pipe, and messages not yet received are
+ *   discarded.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_detach(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_write
+ *
+ * Description:
+ *   Queue a message in a receive ring.  A stream message may be split into
+ *   several ring messages, a datagram is queued whole.
+ *
+ * Input Parameters:
+ *   ring     - The receive ring of the peer
+ *   buf      - Data to send
+ *   len      - Length of data to send
+ *   stream   - True for SOCK_STREAM, false for SOCK_DGRAM
+ *   nonblock - Return -EAGAIN rather than waiting for space
+ *   timeout  - The time in milliseconds a blocking send waits for space
+ *              or for a lent message to be consumed; UINT_MAX waits
+ *              forever
+ *   fds      - Descriptors to pass with the message, or NULL.  Set to NULL
+ *              if the descriptors were queued.
+ *
+ * Returned Value:
+ *   The number of bytes sent; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_write(FAR struct local_ring_s *ring,
+                         FAR const uint8_t *buf, size_t len, bool stream,
+                         bool nonblock, unsigned int timeout,
+                         FAR struct local_fds_s **fds);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_read
+ *
+ * Description:
+ *   Receive data from a receive ring.  A stream read may return data from
+ *   several messages, but never crosses the start of a message carrying
+ *   descriptors.  A datagram read returns one message; the part that does
+ *   not fit in 'buf' is discarded.
+ *
+ * Input Parameters:
+ *   ring     - The receive ring of the socket
+ *   buf      - Buffer to receive data
+ *   len      - Length of buffer
+ *   stream   - True for SOCK_STREAM, false for SOCK_DGRAM
+ *   nonblock - Return -EAGAIN rather than waiting for data
+ *   fds      - Location to return passed descriptors, or NULL to discard
+ *              them
+ *   flags    - Location to report MSG_TRUNC, or NULL
+ *
+ * Returned Value:
+ *   The number of bytes received, zero at the end of the stream; a negated
+ *   errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_read(FAR struct local_ring_s *ring, FAR uint8_t *buf,
+                        size_t len, bool stream, bool nonblock,
+                        FAR struct local_fds_s **fds,
+                        FAR unsigned int *flags);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_pollsetup and local_ring_pollteardown
+ *
+ * Description:
+ *   Setup or teardown the monitoring of the rings of a socket.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(HAVE_LOCAL_POLL)
+int local_ring_pollsetup(FAR struct local_conn_s *conn,
+                         FAR struct pollfd *fds);
+int local_ring_pollteardown(FAR struct local_conn_s *conn,
+                            FAR struct pollfd *fds);
+#endif
+
+/****************************************************************************
+ * Name: local_fds_free
+ *
+ * Description:
+ *   Release the references held on descriptors in flight and free the
+ *   container.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_fds_free(FAR struct local_fds_s *fds);
+#endif
+
+/****************************************************************************
+ * Name: psock_local_sendmsg
+ *
+ * Description:
+ *   Implements sendmsg() for Unix domain sockets, passing SCM_RIGHTS
+ *   descriptors with the message.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_CMSG)
+ssize_t psock_local_sendmsg(FAR struct socket *psock,
+                            FAR struct msghdr *msg, int flags);
+#endif
+
+/****************************************************************************
+ * Name: psock_local_recvmsg
+ *
+ * Description:
+ *   Implements recvmsg() for Unix domain sockets, installing received
+ *   SCM_RIGHTS descriptors in the calling task.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_CMSG)
+ssize_t psock_local_recvmsg(FAR struct socket *psock,
+                            FAR struct msghdr *msg, int flags);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -182,6 +182,13 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               conn->lc_path[UNIX_PATH_MAX - 1] = '\0';
               conn->lc_instance_id = client->lc_instance_id;
 
+#ifdef CONFIG_NET_LOCAL_RING
+              /* Connect the receive rings of the two peers */
+
+              net_lock();
+              ret = local_ring_connect(client, conn);
+              net_unlock();
+#else
               /* Open the server-side write-only FIFO.  This should not
                * block.
                */
@@ -193,8 +200,11 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                    nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
                         conn->lc_path, ret);
                 }
+#endif
             }
 
+#ifndef CONFIG_NET_LOCAL_RING
+
           /* Do we have a connection?  Is the write-side FIFO opened? */
 
           if (ret == OK)
@@ -214,12 +224,15 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                         conn->lc_path, ret);
                 }
             }
+#endif
 
           /* Do we have a connection?  Are the FIFOs opened? */
 
           if (ret == OK)
             {
+#ifndef CONFIG_NET_LOCAL_RING
               DEBUGASSERT(conn->lc_infile.f_inode != NULL);
+#endif
 
               /* Return the address family */
 
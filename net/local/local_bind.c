@@ -42,6 +42,7 @@
 
 #include <sys/socket.h>
 #include <string.h>
+#include <errno.h>
 #include <assert.h>
 
 #include <nuttx/net/net.h>
@@ -113,6 +114,24 @@ int psock_local_bind(FAR struct socket *psock,
         }
     }
 
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_LOCAL_DGRAM)
+  /* A datagram socket bound to a path receives into its own ring */
+
+  if (conn->lc_proto == SOCK_DGRAM && conn->lc_type == LOCAL_TYPE_PATHNAME)
+    {
+      int ret;
+
+      net_lock();
+      ret = local_ring_bind(conn);
+      net_unlock();
+
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
   conn->lc_state = LOCAL_STATE_BOUND;
   return OK;
 }
@@ -68,6 +68,9 @@ void local_initialize(void)
 #ifdef CONFIG_NET_LOCAL_STREAM
   dq_init(&g_local_listeners);
 #endif
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_LOCAL_DGRAM)
+  dq_init(&g_local_dgrams);
+#endif
 }
 
 /****************************************************************************
@@ -118,6 +121,12 @@ void local_free(FAR struct local_conn_s *conn)
 {
   DEBUGASSERT(conn != NULL);
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Disconnect from the peer and discard any messages not yet received */
+
+  local_ring_detach(conn);
+#endif
+
   /* Make sure that the read-only FIFO is closed */
 
   if (conn->lc_infile.f_inode != NULL)
@@ -126,6 +126,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
   server->u.server.lc_pending++;
   DEBUGASSERT(server->u.server.lc_pending != 0);
 
+#ifndef CONFIG_NET_LOCAL_RING
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(client);
@@ -153,6 +154,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
     }
 
   DEBUGASSERT(client->lc_outfile.f_inode != NULL);
+#endif
 
   /* Set the busy "result" before giving the semaphore. */
 
@@ -185,9 +187,21 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
   if (ret < 0)
     {
       nerr("ERROR: Failed to connect: %d\n", ret);
+#ifdef CONFIG_NET_LOCAL_RING
+      client->lc_state = LOCAL_STATE_BOUND;
+      return ret;
+#else
       goto errout_with_outfd;
+#endif
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* The server has connected the rings */
+
+  DEBUGASSERT(client->lc_rxring != NULL && client->lc_txring != NULL);
+  client->lc_state = LOCAL_STATE_CONNECTED;
+  return OK;
+#else
   /* Yes.. open the read-only FIFO */
 
   ret = local_open_client_rx(client, nonblock);
@@ -210,6 +224,7 @@ errout_with_fifos:
   local_release_fifos(client);
   client->lc_state = LOCAL_STATE_BOUND;
   return ret;
+#endif /* CONFIG_NET_LOCAL_RING */
 }
 
 /****************************************************************************
@@ -182,6 +182,15 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
   conn = (FAR struct local_conn_s *)psock->s_conn;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Connected stream sockets and bound datagram sockets have rings */
+
+  if (conn->lc_rxring != NULL)
+    {
+      return local_ring_pollsetup(conn, fds);
+    }
+#endif
+
   if (conn->lc_proto == SOCK_DGRAM)
     {
       return ret;
@@ -200,6 +209,13 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       goto pollerr;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Not connected */
+
+  fds->priv = NULL;
+  goto pollerr;
+#endif
+
   switch (fds->events & (POLLIN | POLLOUT))
     {
       case (POLLIN | POLLOUT):
@@ -332,6 +348,13 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
 
   conn = (FAR struct local_conn_s *)psock->s_conn;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (conn->lc_rxring != NULL)
+    {
+      return local_ring_pollteardown(conn, fds);
+    }
+#endif
+
   if (conn->lc_proto == SOCK_DGRAM)
     {
       return -ENOSYS;
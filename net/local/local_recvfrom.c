@@ -64,6 +64,8 @@
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_NET_LOCAL_RING
+
 /****************************************************************************
  * Name: psock_fifo_read
  *
@@ -384,6 +386,156 @@ errout_with_halfduplex:
   return ret;
 }
 #endif /* CONFIG_NET_LOCAL_STREAM */
+#else /* CONFIG_NET_LOCAL_RING */
+
+/****************************************************************************
+ * Name: psock_ring_recvfrom
+ *
+ * Description:
+ *   Receive from the ring of a connected stream socket or of a datagram
+ *   socket bound to a path.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Buffer to receive data
+ *   len      Length of buffer
+ *   flags    Receive flags
+ *   from     Address of source (may be NULL)
+ *   fromlen  The length of the address structure
+ *   fds      Location to return passed descriptors (may be NULL)
+ *   msgflags Location to return MSG_TRUNC (may be NULL)
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received, zero at the
+ *   end of the stream.  Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+static ssize_t psock_ring_recvfrom(FAR struct socket *psock, FAR void *buf,
+                                   size_t len, int flags,
+                                   FAR struct sockaddr *from,
+                                   FAR socklen_t *fromlen,
+                                   FAR struct local_fds_s **fds,
+                                   FAR unsigned int *msgflags)
+{
+  FAR struct local_conn_s *conn = (FAR struct local_conn_s *)psock->s_conn;
+  bool stream = psock->s_type == SOCK_STREAM;
+  ssize_t ret;
+  int ret2;
+
+  if (stream && conn->lc_state != LOCAL_STATE_CONNECTED)
+    {
+      nerr("ERROR: not connected\n");
+      return -ENOTCONN;
+    }
+  else if (!stream && conn->lc_state != LOCAL_STATE_BOUND)
+    {
+      nerr("ERROR: Connected or not bound\n");
+      return -EISCONN;
+    }
+
+  /* Only datagram sockets bound to a path have a receive ring */
+
+  if (conn->lc_rxring == NULL)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  net_lock();
+  ret = local_ring_read(conn->lc_rxring, buf, len, stream,
+                        _SS_ISNONBLOCK(psock->s_flags) ||
+                        (flags & MSG_DONTWAIT) != 0, fds, msgflags);
+  net_unlock();
+
+  /* Return the address family */
+
+  if (ret >= 0 && from != NULL)
+    {
+      ret2 = local_getaddr(conn, from, fromlen);
+      if (ret2 < 0)
+        {
+          return ret2;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_scm_deliver
+ *
+ * Description:
+ *   Install the descriptors received with a message in the calling task
+ *   and return them in an SCM_RIGHTS control message.  Descriptors that do
+ *   not fit in the control buffer are closed and MSG_CTRUNC is reported.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CMSG
+static void local_scm_deliver(FAR struct msghdr *msg,
+                              FAR struct local_fds_s *fds)
+{
+  FAR struct cmsghdr *cmsg = (FAR struct cmsghdr *)msg->msg_control;
+  FAR struct local_fd_s *lfd;
+  FAR int *fdv;
+  int maxfds = 0;
+  int nfds = 0;
+  int fd;
+  int i;
+
+  if (cmsg != NULL && msg->msg_controllen >= CMSG_LEN(sizeof(int)))
+    {
+      maxfds = (msg->msg_controllen - CMSG_LEN(0)) / sizeof(int);
+    }
+
+  for (i = 0; i < fds->lf_nfds && nfds < maxfds; i++)
+    {
+      lfd = &fds->lf_fds[i];
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+      if (!lfd->lf_socket)
+        {
+          fd = file_dup(&lfd->u.lf_file, 0);
+        }
+      else
+#endif
+        {
+          fd = psock_dup(&lfd->u.lf_sock, CONFIG_NFILE_DESCRIPTORS);
+        }
+
+      if (fd < 0)
+        {
+          nerr("ERROR: Failed to install descriptor: %d\n", fd);
+          break;
+        }
+
+      fdv         = (FAR int *)CMSG_DATA(cmsg);
+      fdv[nfds++] = fd;
+    }
+
+  if (nfds < fds->lf_nfds)
+    {
+      msg->msg_flags |= MSG_CTRUNC;
+    }
+
+  if (nfds > 0)
+    {
+      cmsg->cmsg_level    = SOL_SOCKET;
+      cmsg->cmsg_type     = SCM_RIGHTS;
+      cmsg->cmsg_len      = CMSG_LEN(nfds * sizeof(int));
+      msg->msg_controllen = cmsg->cmsg_len;
+    }
+  else
+    {
+      msg->msg_controllen = 0;
+    }
+
+  /* Drop the references held while the descriptors were in flight */
+
+  local_fds_free(fds);
+}
+#endif /* CONFIG_NET_CMSG */
+#endif /* CONFIG_NET_LOCAL_RING */
 
 /****************************************************************************
  * Public Functions
@@ -424,6 +576,10 @@ ssize_t local_recvfrom(FAR struct socket *psock, FAR void *buf,
 {
   DEBUGASSERT(psock && psock->s_conn && buf);
 
+#ifdef CONFIG_NET_LOCAL_RING
+  return psock_ring_recvfrom(psock, buf, len, flags, from, fromlen,
+                             NULL, NULL);
+#else
   /* Check for a stream socket */
 
 #ifdef CONFIG_NET_LOCAL_STREAM
@@ -446,6 +602,56 @@ ssize_t local_recvfrom(FAR struct socket *psock, FAR void *buf,
       nerr("ERROR: Unrecognized socket type: %s\n", psock->s_type);
       return -EINVAL;
     }
+#endif
+}
+
+/****************************************************************************
+ * Name: psock_local_recvmsg
+ *
+ * Description:
+ *   Implements recvmsg() for Unix domain sockets.  Descriptors passed with
+ *   SCM_RIGHTS are installed in the calling task and returned in the
+ *   control buffer.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      Buffers to receive the message
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly
+ *   shutdown, zero is returned.  Otherwise, a negated errno value is
+ *   returned.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_CMSG)
+ssize_t psock_local_recvmsg(FAR struct socket *psock,
+                            FAR struct msghdr *msg, int flags)
+{
+  FAR struct local_fds_s *fds = NULL;
+  ssize_t ret;
+
+  DEBUGASSERT(psock && psock->s_conn && msg->msg_iov);
+
+  msg->msg_flags = 0;
+  ret = psock_ring_recvfrom(psock, msg->msg_iov->iov_base,
+                            msg->msg_iov->iov_len, flags, msg->msg_name,
+                            (FAR socklen_t *)&msg->msg_namelen, &fds,
+                            &msg->msg_flags);
+
+  if (fds != NULL)
+    {
+      local_scm_deliver(msg, fds);
+    }
+  else
+    {
+      msg->msg_controllen = 0;
+    }
+
+  return ret;
 }
+#endif
 
 #endif /* CONFIG_NET && CONFIG_NET_LOCAL */
@@ -0,0 +1,1139 @@
+/****************************************************************************
+ * net/local/local_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <queue.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "local/local.h"
+
+#ifdef CONFIG_NET_LOCAL_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+#define LOCAL_RING_SPACE(r) (CONFIG_NET_LOCAL_RING_SIZE - (r)->lr_count)
+#define LOCAL_HDRLEN        sizeof(struct local_hdr_s)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+/* A list of all SOCK_DGRAM sockets bound to a path */
+
+dq_queue_t g_local_dgrams;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_alloc
+ *
+ * Description:
+ *   Allocate an empty ring with one reference.
+ *
+ ****************************************************************************/
+
+static FAR struct local_ring_s *local_ring_alloc(void)
+{
+  FAR struct local_ring_s *ring;
+
+  ring = (FAR struct local_ring_s *)kmm_zalloc(sizeof(struct local_ring_s));
+  if (ring != NULL)
+    {
+      ring->lr_crefs = 1;
+
+      /* These semaphores are used for signaling and, hence, should not
+       * have priority inheritance enabled.
+       */
+
+      nxsem_init(&ring->lr_rdsem, 0, 0);
+      nxsem_set_protocol(&ring->lr_rdsem, SEM_PRIO_NONE);
+      nxsem_init(&ring->lr_wrsem, 0, 0);
+      nxsem_set_protocol(&ring->lr_wrsem, SEM_PRIO_NONE);
+    }
+
+  return ring;
+}
+
+/****************************************************************************
+ * Name: local_ring_get
+ *
+ * Description:
+ *   Copy data out of the ring at a position.
+ *
+ ****************************************************************************/
+
+static void local_ring_get(FAR struct local_ring_s *ring, size_t pos,
+                           FAR void *dest, size_t len)
+{
+  size_t first = MIN(len, CONFIG_NET_LOCAL_RING_SIZE - pos);
+
+  memcpy(dest, &ring->lr_buf[pos], first);
+  memcpy((FAR uint8_t *)dest + first, ring->lr_buf, len - first);
+}
+
+/****************************************************************************
+ * Name: local_ring_peek, local_ring_skip and local_ring_copy
+ *
+ * Description:
+ *   Copy the first bytes out of the ring, remove them, or both.
+ *
+ ****************************************************************************/
+
+static void local_ring_peek(FAR struct local_ring_s *ring, FAR void *dest,
+                            size_t len)
+{
+  DEBUGASSERT(len <= ring->lr_count);
+
+  local_ring_get(ring, ring->lr_head, dest, len);
+}
+
+static void local_ring_skip(FAR struct local_ring_s *ring, size_t len)
+{
+  DEBUGASSERT(len <= ring->lr_count);
+
+  ring->lr_head   = (ring->lr_head + len) % CONFIG_NET_LOCAL_RING_SIZE;
+  ring->lr_count -= len;
+}
+
+static void local_ring_copy(FAR struct local_ring_s *ring, FAR void *dest,
+                            size_t len)
+{
+  local_ring_peek(ring, dest, len);
+  local_ring_skip(ring, len);
+}
+
+/****************************************************************************
+ * Name: local_ring_put and local_ring_append
+ *
+ * Description:
+ *   Write data at a position of the ring, or append it at the end.  The
+ *   caller has checked that there is room.
+ *
+ ****************************************************************************/
+
+static void local_ring_put(FAR struct local_ring_s *ring, size_t pos,
+                           FAR const void *src, size_t len)
+{
+  size_t first = MIN(len, CONFIG_NET_LOCAL_RING_SIZE - pos);
+
+  memcpy(&ring->lr_buf[pos], src, first);
+  memcpy(ring->lr_buf, (FAR const uint8_t *)src + first, len - first);
+}
+
+static void local_ring_append(FAR struct local_ring_s *ring,
+                              FAR const void *src, size_t len)
+{
+  DEBUGASSERT(len <= LOCAL_RING_SPACE(ring));
+
+  local_ring_put(ring, (ring->lr_head + ring->lr_count) %
+                       CONFIG_NET_LOCAL_RING_SIZE, src, len);
+  ring->lr_count += len;
+}
+
+/****************************************************************************
+ * Name: local_ring_wait
+ *
+ * Description:
+ *   Wait for a change of the ring state for at most timeout milliseconds.
+ *   The caller re-checks its condition on return, so a stale post only
+ *   causes a spurious wakeup.
+ *
+ ****************************************************************************/
+
+static int local_ring_wait(FAR sem_t *sem, FAR uint8_t *nwaiters,
+                           unsigned int timeout)
+{
+  int ret;
+
+  DEBUGASSERT(*nwaiters < UINT8_MAX);
+  (*nwaiters)++;
+
+  ret = net_timedwait(sem, timeout);
+  if (ret < 0 && *nwaiters > 0)
+    {
+      (*nwaiters)--;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_wake
+ *
+ * Description:
+ *   Wake all waiters on one of the ring semaphores.
+ *
+ ****************************************************************************/
+
+static void local_ring_wake(FAR sem_t *sem, FAR uint8_t *nwaiters)
+{
+  for (; *nwaiters > 0; (*nwaiters)--)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_pollnotify
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+static void local_ring_pollnotify(FAR struct pollfd **fdslots,
+                                  pollevent_t eventset)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  for (i = 0; i < LOCAL_NPOLLWAITERS; i++)
+    {
+      fds = fdslots[i];
+      if (fds != NULL)
+        {
+          fds->revents |= (fds->events & eventset) |
+                          (eventset & (POLLHUP | POLLERR));
+          if (fds->revents != 0)
+            {
+              ninfo("Report events: %02x\n", fds->revents);
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+#else
+#  define local_ring_pollnotify(f,e)
+#endif
+
+/****************************************************************************
+ * Name: local_ring_rdnotify and local_ring_wrnotify
+ *
+ * Description:
+ *   Tell readers that data was added, or writers that space was freed.
+ *
+ ****************************************************************************/
+
+static void local_ring_rdnotify(FAR struct local_ring_s *ring,
+                                pollevent_t eventset)
+{
+  local_ring_wake(&ring->lr_rdsem, &ring->lr_nrdwait);
+  local_ring_pollnotify(ring->lr_rdfds, eventset);
+}
+
+static void local_ring_wrnotify(FAR struct local_ring_s *ring,
+                                pollevent_t eventset)
+{
+  local_ring_wake(&ring->lr_wrsem, &ring->lr_nwrwait);
+  local_ring_pollnotify(ring->lr_wrfds, eventset);
+}
+
+/****************************************************************************
+ * Name: local_lend_done
+ *
+ * Description:
+ *   Return a lent buffer to its sender.
+ *
+ ****************************************************************************/
+
+static void local_lend_done(FAR struct local_lend_s *lend)
+{
+  lend->ll_done = true;
+  nxsem_post(&lend->ll_donesem);
+}
+
+/****************************************************************************
+ * Name: local_ring_flush
+ *
+ * Description:
+ *   Discard all messages in the ring, returning lent buffers to their
+ *   senders and closing descriptors in flight.
+ *
+ ****************************************************************************/
+
+static void local_ring_flush(FAR struct local_ring_s *ring)
+{
+  struct local_hdr_s hdr;
+
+  if (ring->lr_reading)
+    {
+      if (ring->lr_hdr.lh_lend != NULL)
+        {
+          local_lend_done(ring->lr_hdr.lh_lend);
+        }
+      else
+        {
+          local_ring_skip(ring, ring->lr_hdr.lh_len - ring->lr_offset);
+        }
+
+      ring->lr_reading = false;
+    }
+
+  while (ring->lr_count > 0)
+    {
+      local_ring_copy(ring, &hdr, LOCAL_HDRLEN);
+
+      if (hdr.lh_fds != NULL)
+        {
+          local_fds_free(hdr.lh_fds);
+        }
+
+      if (hdr.lh_lend != NULL)
+        {
+          local_lend_done(hdr.lh_lend);
+        }
+      else
+        {
+          local_ring_skip(ring, hdr.lh_len);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_shutdown
+ *
+ * Description:
+ *   Close the receiving or the sending side of a ring.
+ *
+ ****************************************************************************/
+
+static void local_ring_shutdown(FAR struct local_ring_s *ring, bool reader)
+{
+  if (reader)
+    {
+      /* Nothing more will be received.  Senders get EPIPE. */
+
+      ring->lr_flags |= LOCAL_RING_RDCLOSED;
+      local_ring_flush(ring);
+      local_ring_wrnotify(ring, POLLOUT | POLLHUP);
+    }
+  else
+    {
+      /* The receiver sees end-of-file after the queued data */
+
+      ring->lr_flags |= LOCAL_RING_WRCLOSED;
+      local_ring_rdnotify(ring, POLLIN | POLLHUP);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_unlend
+ *
+ * Description:
+ *   Withdraw a lent message whose sender stops waiting.  If the receiver
+ *   is reading the message, the message ends after the bytes it has taken.
+ *   Otherwise the header at pos is replaced by that of a dropped message.
+ *   Either way, the ring no longer refers to the buffer of the sender.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_LEND
+static void local_ring_unlend(FAR struct local_ring_s *ring,
+                              FAR struct local_lend_s *lend, size_t pos)
+{
+  struct local_hdr_s hdr;
+
+  if (ring->lr_reading && ring->lr_hdr.lh_lend == lend)
+    {
+      ring->lr_hdr.lh_lend = NULL;
+      ring->lr_reading     = false;
+      return;
+    }
+
+  /* The descriptors were not received and go with the message */
+
+  local_ring_get(ring, pos, &hdr, LOCAL_HDRLEN);
+  DEBUGASSERT(hdr.lh_lend == lend);
+
+  if (hdr.lh_fds != NULL)
+    {
+      local_fds_free(hdr.lh_fds);
+    }
+
+  hdr.lh_lend    = NULL;
+  hdr.lh_fds     = NULL;
+  hdr.lh_len     = 0;
+  hdr.lh_dropped = true;
+
+  local_ring_put(ring, pos, &hdr, LOCAL_HDRLEN);
+}
+#endif
+
+/****************************************************************************
+ * Name: local_ring_lend
+ *
+ * Description:
+ *   Queue a lent message and wait until the receiver has consumed it, the
+ *   socket was closed, the wait was interrupted or timed out.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_LEND
+static ssize_t local_ring_lend(FAR struct local_ring_s *ring,
+                               FAR const uint8_t *buf, size_t len,
+                               bool stream, unsigned int timeout,
+                               FAR struct local_fds_s **fds)
+{
+  struct local_lend_s lend;
+  struct local_hdr_s hdr;
+  size_t pos;
+  int ret = OK;
+
+  /* Wait for room for the header */
+
+  while (LOCAL_RING_SPACE(ring) < LOCAL_HDRLEN)
+    {
+      if ((ring->lr_flags & LOCAL_RING_RDCLOSED) != 0)
+        {
+          return stream ? -EPIPE : -ECONNREFUSED;
+        }
+
+      ret = local_ring_wait(&ring->lr_wrsem, &ring->lr_nwrwait, timeout);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if ((ring->lr_flags & LOCAL_RING_RDCLOSED) != 0)
+    {
+      return stream ? -EPIPE : -ECONNREFUSED;
+    }
+
+  lend.ll_buf    = buf;
+  lend.ll_len    = len;
+  lend.ll_offset = 0;
+  lend.ll_done   = false;
+
+  nxsem_init(&lend.ll_donesem, 0, 0);
+  nxsem_set_protocol(&lend.ll_donesem, SEM_PRIO_NONE);
+
+  hdr.lh_lend    = &lend;
+  hdr.lh_fds     = fds != NULL ? *fds : NULL;
+  hdr.lh_len     = len;
+  hdr.lh_dropped = false;
+
+  pos = (ring->lr_head + ring->lr_count) % CONFIG_NET_LOCAL_RING_SIZE;
+  local_ring_append(ring, &hdr, LOCAL_HDRLEN);
+  if (fds != NULL)
+    {
+      *fds = NULL;
+    }
+
+  local_ring_rdnotify(ring, POLLIN);
+
+  /* The receiver copies straight out of 'buf' with the network locked.
+   * Until the message has been consumed, it is either the message being
+   * read or still queued at pos.  If the wait ends early, the message is
+   * withdrawn before 'lend' goes out of scope.
+   */
+
+  while (!lend.ll_done)
+    {
+      ret = net_timedwait(&lend.ll_donesem, timeout);
+      if (ret < 0 && !lend.ll_done)
+        {
+          local_ring_unlend(ring, &lend, pos);
+          break;
+        }
+    }
+
+  nxsem_destroy(&lend.ll_donesem);
+
+  /* A stream sender reports the bytes that were taken */
+
+  if (!lend.ll_done)
+    {
+      return stream && lend.ll_offset > 0 ? lend.ll_offset : ret;
+    }
+
+  /* A datagram is delivered even if it was truncated */
+
+  if (lend.ll_offset == 0 && len > 0)
+    {
+      return stream ? -EPIPE : -ECONNREFUSED;
+    }
+
+  return stream ? lend.ll_offset : len;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_connect
+ *
+ * Description:
+ *   Create the two receive rings that connect a SOCK_STREAM client with
+ *   the new server-side peer created by accept().
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+int local_ring_connect(FAR struct local_conn_s *client,
+                       FAR struct local_conn_s *server)
+{
+  FAR struct local_ring_s *c2s;
+  FAR struct local_ring_s *s2c;
+
+  c2s = local_ring_alloc();
+  if (c2s == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  s2c = local_ring_alloc();
+  if (s2c == NULL)
+    {
+      local_ring_release(c2s);
+      return -ENOMEM;
+    }
+
+  /* Each ring is referenced by its receiver and its sender */
+
+  c2s->lr_crefs     = 2;
+  s2c->lr_crefs     = 2;
+
+  client->lc_txring = c2s;
+  client->lc_rxring = s2c;
+  server->lc_txring = s2c;
+  server->lc_rxring = c2s;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: local_ring_bind
+ *
+ * Description:
+ *   Create the receive ring of a SOCK_DGRAM socket bound to a path and make
+ *   the socket visible to senders.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+int local_ring_bind(FAR struct local_conn_s *conn)
+{
+  FAR struct local_ring_s *ring;
+
+  if (conn->lc_rxring != NULL)
+    {
+      return -EINVAL;
+    }
+
+  ring = local_ring_find(conn->lc_path);
+  if (ring != NULL)
+    {
+      local_ring_release(ring);
+      return -EADDRINUSE;
+    }
+
+  ring = local_ring_alloc();
+  if (ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  conn->lc_rxring = ring;
+  dq_addlast(&conn->lc_node, &g_local_dgrams);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: local_ring_find
+ *
+ * Description:
+ *   Return the receive ring of the SOCK_DGRAM socket bound to 'path' with
+ *   an additional reference, or NULL if there is no such socket.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+FAR struct local_ring_s *local_ring_find(FAR const char *path)
+{
+  FAR struct local_conn_s *conn;
+
+  for (conn = (FAR struct local_conn_s *)g_local_dgrams.head;
+       conn != NULL;
+       conn = (FAR struct local_conn_s *)dq_next(&conn->lc_node))
+    {
+      if (strncmp(conn->lc_path, path, UNIX_PATH_MAX - 1) == 0)
+        {
+          DEBUGASSERT(conn->lc_rxring->lr_crefs < UINT8_MAX);
+          conn->lc_rxring->lr_crefs++;
+          return conn->lc_rxring;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Drop a reference to a ring, freeing it with the last reference.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void local_ring_release(FAR struct local_ring_s *ring)
+{
+  DEBUGASSERT(ring->lr_crefs > 0);
+
+  if (--ring->lr_crefs == 0)
+    {
+      local_ring_flush(ring);
+      nxsem_destroy(&ring->lr_rdsem);
+      nxsem_destroy(&ring->lr_wrsem);
+      kmm_free(ring);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_detach
+ *
+ * Description:
+ *   Disconnect a socket that is being freed from its rings.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void local_ring_detach(FAR struct local_conn_s *conn)
+{
+  if (conn->lc_rxring != NULL)
+    {
+#ifdef CONFIG_NET_LOCAL_DGRAM
+      if (conn->lc_proto == SOCK_DGRAM)
+        {
+          dq_rem(&conn->lc_node, &g_local_dgrams);
+        }
+#endif
+
+      local_ring_shutdown(conn->lc_rxring, true);
+      local_ring_release(conn->lc_rxring);
+      conn->lc_rxring = NULL;
+    }
+
+  if (conn->lc_txring != NULL)
+    {
+      local_ring_shutdown(conn->lc_txring, false);
+      local_ring_release(conn->lc_txring);
+      conn->lc_txring = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_write
+ *
+ * Description:
+ *   Queue a message in a receive ring.
+ *
+ * Input Parameters:
+ *   ring     - The receive ring of the peer
+ *   buf      - Data to send
+ *   len      - Length of data to send
+ *   stream   - True for SOCK_STREAM, false for SOCK_DGRAM
+ *   nonblock - Return -EAGAIN rather than waiting for space
+ *   timeout  - The time in milliseconds a blocking send waits for space
+ *              or for a lent message to be consumed; UINT_MAX waits
+ *              forever
+ *   fds      - Descriptors to pass with the message, or NULL.  Set to NULL
+ *              if the descriptors were queued.
+ *
+ * Returned Value:
+ *   The number of bytes sent; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_write(FAR struct local_ring_s *ring,
+                         FAR const uint8_t *buf, size_t len, bool stream,
+                         bool nonblock, unsigned int timeout,
+                         FAR struct local_fds_s **fds)
+{
+  struct local_hdr_s hdr;
+  size_t nsent = 0;
+  size_t chunk;
+  size_t need;
+  int ret = OK;
+
+  /* A stream message must carry data */
+
+  if (stream && len == 0)
+    {
+      return (fds != NULL && *fds != NULL) ? -EINVAL : 0;
+    }
+
+#ifdef HAVE_LOCAL_LEND
+  /* Lend large messages rather than copying them if the sender can wait */
+
+  if (len >= CONFIG_NET_LOCAL_RING_LENDSIZE && !nonblock)
+    {
+      return local_ring_lend(ring, buf, len, stream, timeout, fds);
+    }
+#endif
+
+  if (!stream && LOCAL_HDRLEN + len > CONFIG_NET_LOCAL_RING_SIZE)
+    {
+      return -EMSGSIZE;
+    }
+
+  do
+    {
+      if ((ring->lr_flags & LOCAL_RING_RDCLOSED) != 0)
+        {
+          ret = stream ? -EPIPE : -ECONNREFUSED;
+          break;
+        }
+
+      /* A datagram is queued whole, a stream message in chunks of at least
+       * one byte.
+       */
+
+      need = LOCAL_HDRLEN + (stream ? 1 : len);
+      if (LOCAL_RING_SPACE(ring) < need)
+        {
+          if (nonblock)
+            {
+              ret = -EAGAIN;
+              break;
+            }
+
+          ret = local_ring_wait(&ring->lr_wrsem, &ring->lr_nwrwait,
+                                timeout);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      chunk = MIN(len - nsent, LOCAL_RING_SPACE(ring) - LOCAL_HDRLEN);
+
+      hdr.lh_lend    = NULL;
+      hdr.lh_fds     = NULL;
+      hdr.lh_len     = chunk;
+      hdr.lh_dropped = false;
+
+      /* Only the first chunk carries the descriptors */
+
+      if (fds != NULL)
+        {
+          hdr.lh_fds = *fds;
+          *fds       = NULL;
+        }
+
+      local_ring_append(ring, &hdr, LOCAL_HDRLEN);
+      local_ring_append(ring, buf + nsent, chunk);
+      nsent += chunk;
+
+      local_ring_rdnotify(ring, POLLIN);
+    }
+  while (nsent < len);
+
+  /* Report a failure only if nothing was sent */
+
+  if (nsent > 0 || ret >= 0)
+    {
+      return nsent;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_read
+ *
+ * Description:
+ *   Receive data from a receive ring.
+ *
+ * Input Parameters:
+ *   ring     - The receive ring of the socket
+ *   buf      - Buffer to receive data
+ *   len      - Length of buffer
+ *   stream   - True for SOCK_STREAM, false for SOCK_DGRAM
+ *   nonblock - Return -EAGAIN rather than waiting for data
+ *   fds      - Location to return passed descriptors, or NULL to discard
+ *              them
+ *   flags    - Location to report MSG_TRUNC, or NULL
+ *
+ * Returned Value:
+ *   The number of bytes received, zero at the end of the stream; a negated
+ *   errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_read(FAR struct local_ring_s *ring, FAR uint8_t *buf,
+                        size_t len, bool stream, bool nonblock,
+                        FAR struct local_fds_s **fds,
+                        FAR unsigned int *flags)
+{
+  FAR struct local_hdr_s *hdr = &ring->lr_hdr;
+  FAR struct local_lend_s *lend;
+  size_t nread = 0;
+  size_t ncopy;
+  int ret;
+
+  for (; ; )
+    {
+      if (!ring->lr_reading)
+        {
+          if (ring->lr_count == 0)
+            {
+              if (nread > 0 ||
+                  (ring->lr_flags & LOCAL_RING_WRCLOSED) != 0)
+                {
+                  break;
+                }
+
+              if (nonblock)
+                {
+                  return -EAGAIN;
+                }
+
+              ret = local_ring_wait(&ring->lr_rdsem, &ring->lr_nrdwait,
+                                    UINT_MAX);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              continue;
+            }
+
+          /* Descriptors are returned with the first byte of their
+           * message, so a message carrying descriptors ends the read.
+           */
+
+          local_ring_peek(ring, hdr, LOCAL_HDRLEN);
+          if (nread > 0 && hdr->lh_fds != NULL)
+            {
+              break;
+            }
+
+          local_ring_skip(ring, LOCAL_HDRLEN);
+
+          /* A message withdrawn by its sender is only a header */
+
+          if (hdr->lh_dropped)
+            {
+              local_ring_wrnotify(ring, POLLOUT);
+              continue;
+            }
+
+          ring->lr_reading = true;
+          ring->lr_offset  = 0;
+
+          if (hdr->lh_fds != NULL)
+            {
+              if (fds != NULL && *fds == NULL)
+                {
+                  *fds = hdr->lh_fds;
+                }
+              else
+                {
+                  local_fds_free(hdr->lh_fds);
+                }
+
+              hdr->lh_fds = NULL;
+            }
+        }
+
+      /* Copy from the lent buffer or from the ring */
+
+      lend  = hdr->lh_lend;
+      ncopy = MIN(len - nread, hdr->lh_len - ring->lr_offset);
+
+      if (lend != NULL)
+        {
+          memcpy(buf + nread, lend->ll_buf + lend->ll_offset, ncopy);
+          lend->ll_offset += ncopy;
+        }
+      else
+        {
+          local_ring_copy(ring, buf + nread, ncopy);
+        }
+
+      nread           += ncopy;
+      ring->lr_offset += ncopy;
+
+      /* The rest of a datagram that does not fit is lost */
+
+      if (!stream && ring->lr_offset < hdr->lh_len)
+        {
+          if (lend == NULL)
+            {
+              local_ring_skip(ring, hdr->lh_len - ring->lr_offset);
+            }
+
+          if (flags != NULL)
+            {
+              *flags |= MSG_TRUNC;
+            }
+
+          ring->lr_offset = hdr->lh_len;
+        }
+
+      if (ring->lr_offset >= hdr->lh_len)
+        {
+          ring->lr_reading = false;
+          if (lend != NULL)
+            {
+              local_lend_done(lend);
+            }
+        }
+
+      local_ring_wrnotify(ring, POLLOUT);
+
+      if (!stream || nread >= len)
+        {
+          break;
+        }
+    }
+
+  return nread;
+}
+
+/****************************************************************************
+ * Name: local_ring_pollsetup
+ *
+ * Description:
+ *   Setup to monitor the rings of a connected stream socket or a bound
+ *   datagram socket.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+int local_ring_pollsetup(FAR struct local_conn_s *conn,
+                         FAR struct pollfd *fds)
+{
+  FAR struct local_ring_s *rx = conn->lc_rxring;
+  FAR struct local_ring_s *tx = conn->lc_txring;
+  FAR struct pollfd **rdslot = NULL;
+  FAR struct pollfd **wrslot = NULL;
+  pollevent_t eventset = 0;
+  int i;
+
+  net_lock();
+
+  if (rx != NULL && (fds->events & POLLIN) != 0)
+    {
+      for (i = 0; i < LOCAL_NPOLLWAITERS && rdslot == NULL; i++)
+        {
+          if (rx->lr_rdfds[i] == NULL)
+            {
+              rdslot = &rx->lr_rdfds[i];
+            }
+        }
+
+      if (rdslot == NULL)
+        {
+          net_unlock();
+          return -EBUSY;
+        }
+    }
+
+  if (tx != NULL && (fds->events & POLLOUT) != 0)
+    {
+      for (i = 0; i < LOCAL_NPOLLWAITERS && wrslot == NULL; i++)
+        {
+          if (tx->lr_wrfds[i] == NULL)
+            {
+              wrslot = &tx->lr_wrfds[i];
+            }
+        }
+
+      if (wrslot == NULL)
+        {
+          net_unlock();
+          return -EBUSY;
+        }
+    }
+
+  if (rdslot != NULL)
+    {
+      *rdslot = fds;
+    }
+
+  if (wrslot != NULL)
+    {
+      *wrslot = fds;
+    }
+
+  fds->priv = conn;
+
+  /* Report the events that are already pending */
+
+  if (rx != NULL)
+    {
+      if (rx->lr_count > 0 || rx->lr_reading)
+        {
+          eventset |= POLLIN;
+        }
+
+      if ((rx->lr_flags & LOCAL_RING_WRCLOSED) != 0)
+        {
+          eventset |= POLLIN | POLLHUP;
+        }
+    }
+
+  if (tx == NULL)
+    {
+      /* A datagram socket sends to the rings of other sockets */
+
+      eventset |= POLLOUT;
+    }
+  else if ((tx->lr_flags & LOCAL_RING_RDCLOSED) != 0)
+    {
+      eventset |= POLLOUT | POLLHUP;
+    }
+  else if (LOCAL_RING_SPACE(tx) > LOCAL_HDRLEN)
+    {
+      eventset |= POLLOUT;
+    }
+
+  fds->revents |= (fds->events & eventset) | (eventset & POLLHUP);
+  if (fds->revents != 0)
+    {
+      nxsem_post(fds->sem);
+    }
+
+  net_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_pollteardown
+ *
+ * Description:
+ *   Teardown the monitoring of the rings of a socket.
+ *
+ ****************************************************************************/
+
+int local_ring_pollteardown(FAR struct local_conn_s *conn,
+                            FAR struct pollfd *fds)
+{
+  int i;
+
+  if (fds->priv == NULL)
+    {
+      return OK;
+    }
+
+  net_lock();
+
+  for (i = 0; i < LOCAL_NPOLLWAITERS; i++)
+    {
+      if (conn->lc_rxring != NULL && conn->lc_rxring->lr_rdfds[i] == fds)
+        {
+          conn->lc_rxring->lr_rdfds[i] = NULL;
+        }
+
+      if (conn->lc_txring != NULL && conn->lc_txring->lr_wrfds[i] == fds)
+        {
+          conn->lc_txring->lr_wrfds[i] = NULL;
+        }
+    }
+
+  fds->priv = NULL;
+  net_unlock();
+  return OK;
+}
+#endif /* HAVE_LOCAL_POLL */
+
+/****************************************************************************
+ * Name: local_fds_free
+ *
+ * Description:
+ *   Release the references held on descriptors in flight and free the
+ *   container.
+ *
+ ****************************************************************************/
+
+void local_fds_free(FAR struct local_fds_s *fds)
+{
+  FAR struct local_fd_s *lfd;
+  int i;
+
+  for (i = 0; i < fds->lf_nfds; i++)
+    {
+      lfd = &fds->lf_fds[i];
+      if (lfd->lf_socket)
+        {
+          psock_close(&lfd->u.lf_sock);
+        }
+      else
+        {
+          file_close(&lfd->u.lf_file);
+        }
+    }
+
+  kmm_free(fds);
+}
+
+#endif /* CONFIG_NET_LOCAL_RING */
@@ -46,6 +46,7 @@
 
 #include <nuttx/net/net.h>
 
+#include "socket/socket.h"
 #include "local/local.h"
 
 #ifdef CONFIG_NET_LOCAL_STREAM
@@ -82,6 +83,25 @@ ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
   DEBUGASSERT(psock && psock->s_conn && buf);
   peer = (FAR struct local_conn_s *)psock->s_conn;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Verify that this is a connected peer socket */
+
+  if (peer->lc_state != LOCAL_STATE_CONNECTED || peer->lc_txring == NULL)
+    {
+      nerr("ERROR: not connected\n");
+      return -ENOTCONN;
+    }
+
+  /* Queue the data in the receive ring of the peer */
+
+  net_lock();
+  ret = local_ring_write(peer->lc_txring, (FAR const uint8_t *)buf, len,
+                         true, _SS_ISNONBLOCK(psock->s_flags) ||
+                         (flags & MSG_DONTWAIT) != 0,
+                         _SO_TIMEOUT(psock->s_sndtimeo), NULL);
+  net_unlock();
+  return ret;
+#else
   /* Verify that this is a connected peer socket and that it has opened the
    * outgoing FIFO for write-only access.
    */
@@ -100,6 +120,7 @@ ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
   /* If the send was successful, then the full packet will have been sent */
 
   return ret < 0 ? ret : len;
+#endif
 }
 
 #endif /* CONFIG_NET_LOCAL_STREAM */
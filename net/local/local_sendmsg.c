@@ -0,0 +1,268 @@
+/****************************************************************************
+ * net/local/local_sendmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "local/local.h"
+
+#if defined(CONFIG_NET_LOCAL_RING) && defined(CONFIG_NET_CMSG)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_fd_capture
+ *
+ * Description:
+ *   Take a reference on the file or socket of a descriptor of the sending
+ *   task.
+ *
+ ****************************************************************************/
+
+static int local_fd_capture(FAR struct local_fd_s *lfd, int fd)
+{
+  FAR struct socket *psock;
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  if (fd >= 0 && fd < CONFIG_NFILE_DESCRIPTORS)
+    {
+      FAR struct file *filep;
+      int ret;
+
+      ret = fs_getfilep(fd, &filep);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      lfd->lf_socket = false;
+      return file_dup2(filep, &lfd->u.lf_file);
+    }
+#endif
+
+  psock = sockfd_socket(fd);
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  lfd->lf_socket = true;
+  return psock_dup2(psock, &lfd->u.lf_sock);
+}
+
+/****************************************************************************
+ * Name: local_scm_capture
+ *
+ * Description:
+ *   Collect the descriptors of the SCM_RIGHTS control message, if any.
+ *   Other control messages are ignored.
+ *
+ ****************************************************************************/
+
+static int local_scm_capture(FAR struct msghdr *msg,
+                             FAR struct local_fds_s **fdsp)
+{
+  FAR struct local_fds_s *fds;
+  FAR struct cmsghdr *cmsg;
+  FAR int *fdv;
+  int nfds;
+  int ret;
+  int i;
+
+  *fdsp = NULL;
+
+  if (msg->msg_control == NULL)
+    {
+      return OK;
+    }
+
+  for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL;
+       cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+      if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+        {
+          continue;
+        }
+
+      nfds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      if (*fdsp != NULL || cmsg->cmsg_len < CMSG_LEN(sizeof(int)) ||
+          nfds > LOCAL_SCM_MAXFDS)
+        {
+          ret = -EINVAL;
+          goto errout;
+        }
+
+      fds = (FAR struct local_fds_s *)kmm_zalloc(SIZEOF_LOCAL_FDS(nfds));
+      if (fds == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+
+      *fdsp = fds;
+      fdv   = (FAR int *)CMSG_DATA(cmsg);
+
+      for (i = 0; i < nfds; i++)
+        {
+          ret = local_fd_capture(&fds->lf_fds[i], fdv[i]);
+          if (ret < 0)
+            {
+              goto errout;
+            }
+
+          fds->lf_nfds++;
+        }
+    }
+
+  return OK;
+
+errout:
+  if (*fdsp != NULL)
+    {
+      local_fds_free(*fdsp);
+      *fdsp = NULL;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_local_sendmsg
+ *
+ * Description:
+ *   Implements sendmsg() for Unix domain sockets.  The descriptors of an
+ *   SCM_RIGHTS control message are passed with the message and installed
+ *   in the receiving task by recvmsg().
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - The message to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On error, a
+ *   negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_local_sendmsg(FAR struct socket *psock,
+                            FAR struct msghdr *msg, int flags)
+{
+  FAR struct local_conn_s *conn = (FAR struct local_conn_s *)psock->s_conn;
+  FAR const uint8_t *buf = msg->msg_iov->iov_base;
+  size_t len = msg->msg_iov->iov_len;
+  FAR struct local_fds_s *fds;
+  unsigned int timeout;
+  bool nonblock;
+  ssize_t ret;
+
+  nonblock = _SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0;
+  timeout  = _SO_TIMEOUT(psock->s_sndtimeo);
+
+  ret = local_scm_capture(msg, &fds);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  net_lock();
+
+  switch (psock->s_type)
+    {
+#ifdef CONFIG_NET_LOCAL_STREAM
+      case SOCK_STREAM:
+        {
+          if (conn->lc_state != LOCAL_STATE_CONNECTED ||
+              conn->lc_txring == NULL)
+            {
+              ret = -ENOTCONN;
+              break;
+            }
+
+          ret = local_ring_write(conn->lc_txring, buf, len, true, nonblock,
+                                 timeout, &fds);
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+      case SOCK_DGRAM:
+        {
+          FAR struct sockaddr_un *unaddr = msg->msg_name;
+          FAR struct local_ring_s *ring;
+
+          if (unaddr == NULL || unaddr->sun_family != AF_LOCAL ||
+              msg->msg_namelen < sizeof(sa_family_t) + 2)
+            {
+              ret = -EDESTADDRREQ;
+              break;
+            }
+
+          ring = local_ring_find(unaddr->sun_path);
+          if (ring == NULL)
+            {
+              ret = -ECONNREFUSED;
+              break;
+            }
+
+          ret = local_ring_write(ring, buf, len, false, nonblock, timeout,
+                                 &fds);
+          local_ring_release(ring);
+        }
+        break;
+#endif
+
+      default:
+        ret = -EBADF;
+        break;
+    }
+
+  /* Release the descriptors if they were not queued */
+
+  if (fds != NULL)
+    {
+      local_fds_free(fds);
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_LOCAL_RING && CONFIG_NET_CMSG */
@@ -87,8 +87,12 @@ ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
 {
   FAR struct local_conn_s *conn = (FAR struct local_conn_s *)psock->s_conn;
   FAR struct sockaddr_un *unaddr = (FAR struct sockaddr_un *)to;
-  ssize_t nsent;
+#ifdef CONFIG_NET_LOCAL_RING
+  FAR struct local_ring_s *ring;
+#else
   int ret;
+#endif
+  ssize_t nsent;
 
   /* We keep packet sizes in a uint16_t, so there is a upper limit to the
    * 'len' that can be supported.
@@ -110,10 +114,6 @@ ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
       return -EISCONN;
     }
 
-  /* The outgoing FIFO should not be open */
-
-  DEBUGASSERT(conn->lc_outfile.f_inode == 0);
-
   /* At present, only standard pathname type address are support */
 
   if (tolen < sizeof(sa_family_t) + 2)
@@ -123,6 +123,34 @@ ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
       return -EFAULT;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Queue the datagram in the receive ring of the socket bound to the
+   * address.
+   */
+
+  net_lock();
+
+  ring = local_ring_find(unaddr->sun_path);
+  if (ring == NULL)
+    {
+      nsent = -ECONNREFUSED;
+    }
+  else
+    {
+      nsent = local_ring_write(ring, buf, len, false,
+                               _SS_ISNONBLOCK(psock->s_flags) ||
+                               (flags & MSG_DONTWAIT) != 0,
+                               _SO_TIMEOUT(psock->s_sndtimeo), NULL);
+      local_ring_release(ring);
+    }
+
+  net_unlock();
+  return nsent;
+#else
+  /* The outgoing FIFO should not be open */
+
+  DEBUGASSERT(conn->lc_outfile.f_inode == 0);
+
   /* Make sure that half duplex FIFO has been created.
    * REVISIT:  Or should be just make sure that it already exists?
    */
@@ -174,6 +202,7 @@ errout_with_halfduplex:
 
   local_release_halfduplex(conn);
   return nsent;
+#endif /* CONFIG_NET_LOCAL_RING */
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_LOCAL_DGRAM */
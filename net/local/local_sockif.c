@@ -111,8 +111,13 @@ const struct sock_intf_s g_local_sockif =
 #endif
   local_recvfrom,    /* si_recvfrom */
 #ifdef CONFIG_NET_CMSG
+#ifdef CONFIG_NET_LOCAL_RING
+  psock_local_recvmsg, /* si_recvmsg */
+  psock_local_sendmsg, /* si_sendmsg */
+#else
   NULL,              /* si_recvmsg */
   NULL,              /* si_sendmsg */
+#endif
 #endif
   local_close        /* si_close */
 };
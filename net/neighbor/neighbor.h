@@ -49,13 +49,69 @@
 
 #include <net/ethernet.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
 #include <nuttx/net/sixlowpan.h>
 #include <nuttx/net/neighbor.h>
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_IPv6_NCONF_MAXAGE
+#  define CONFIG_NET_IPv6_NCONF_MAXAGE 120
+#endif
+
+#define NEIGHBOR_MAXAGE_TICK     SEC2TICK(10 * CONFIG_NET_IPv6_NCONF_MAXAGE)
+
+/* Packets queued on an entry that is still unresolved after this time are
+ * discarded.
+ */
+
+#define NEIGHBOR_INCOMPLETE_TICK SEC2TICK(3)
+
+/* The number of hash chains.  Chains use the entry index + 1 so that the
+ * zero-initialized table is valid.
+ */
+
+#define NEIGHBOR_HASHSIZE        CONFIG_NET_IPv6_NCONF_ENTRIES
+#define NEIGHBOR_NOENTRY         0
+
+/* Values of nt_flags */
+
+#define NEIGHBOR_FLAG_INCOMPLETE (1 << 0) /* Waiting for the advertisement */
+
+#ifdef CONFIG_NET_STATISTICS
+#  define NEIGHBOR_STAT(f)       (g_netstats.neighbor.f++)
+#else
+#  define NEIGHBOR_STAT(f)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One entry in the Neighbor Table together with its table management
+ * state.
+ */
+
+struct neighbor_table_entry_s
+{
+  struct neighbor_entry_s  nt_entry;    /* The exported Neighbor Table entry */
+  uint16_t                 nt_next;     /* Next entry on the same hash chain */
+  uint8_t                  nt_flags;    /* See NEIGHBOR_FLAG_* definitions */
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+  uint8_t                  nt_npending; /* Number of queued packets */
+  FAR struct net_driver_s *nt_dev;      /* Device that queued the packets */
+  FAR struct iob_s        *nt_pending[CONFIG_NET_IPv6_NCONF_MAXPENDING];
+#endif
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -64,7 +120,18 @@
  * this table.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern struct neighbor_table_entry_s
+  g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* The head of each hash chain of the Neighbor Table */
+
+extern uint16_t g_neighbor_hash[NEIGHBOR_HASHSIZE];
+
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+/* The number of Neighbor Table entries that hold queued packets */
+
+extern uint16_t g_neighbor_npending;
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -90,6 +157,88 @@ struct net_driver_s; /* Forward reference */
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
 
+/****************************************************************************
+ * Name: neighbor_findslot
+ *
+ * Description:
+ *   Find the Neighbor Table entry of an IPv6 address, whether it is
+ *   resolved, incomplete or expired.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to use in the lookup;
+ *
+ * Returned Value:
+ *   The table entry corresponding to the IPv6 address;  NULL is returned
+ *   if the address is not in the Neighbor Table.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_table_entry_s *
+neighbor_findslot(FAR const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_allocslot
+ *
+ * Description:
+ *   Claim a Neighbor Table entry for an IPv6 address that is not in the
+ *   table.  A free entry is used if there is one, otherwise the oldest
+ *   entry is evicted.  The new entry is linked into its hash chain.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address of the new entry
+ *
+ * Returned Value:
+ *   The new table entry.  Only the IPv6 address is valid.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_table_entry_s *
+neighbor_allocslot(FAR const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_queue
+ *
+ * Description:
+ *   Queue the IPv6 packet in d_buf until the link layer address of
+ *   'ipaddr' has been resolved.  An incomplete Neighbor Table entry is
+ *   created for the address if there is none.  If the queue of the entry is
+ *   full, the oldest packet is discarded.
+ *
+ * Input Parameters:
+ *   dev    - The device that is sending the packet
+ *   ipaddr - The next hop IPv6 address to be resolved
+ *
+ * Returned Value:
+ *   Zero (OK) if the packet was queued.  A negated errno value is returned
+ *   if the packet could not be queued.  d_buf is not modified in any case.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+int neighbor_queue(FAR struct net_driver_s *dev,
+                   FAR const net_ipv6addr_t ipaddr);
+#endif
+
+/****************************************************************************
+ * Name: neighbor_free_pending
+ *
+ * Description:
+ *   Discard all packets queued on a Neighbor Table entry.
+ *
+ * Input Parameters:
+ *   slot - The Neighbor Table entry
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+void neighbor_free_pending(FAR struct neighbor_table_entry_s *slot);
+#else
+#  define neighbor_free_pending(s)
+#endif
+
 /****************************************************************************
  * Name: neighbor_add
  *
@@ -168,7 +317,9 @@ void neighbor_update(const net_ipv6addr_t ipaddr);
  *   the packet in the d_buf is replaced by an ICMPv6 Neighbor Solicit
  *   request packet for the IPv6 address. The IPv6 packet is dropped and
  *   it is assumed that the higher level protocols (e.g., TCP) eventually
- *   will retransmit the dropped packet.
+ *   will retransmit the dropped packet.  If CONFIG_NET_IPv6_NCONF_PENDING
+ *   is enabled, a copy of the IPv6 packet is queued instead and sent when
+ *   the Neighbor Advertisement arrives.
  *
  *   Upon return in either the case, a packet to be sent is present in the
  *   d_buf buffer and the d_len field holds the length of the Ethernet
@@ -205,6 +356,59 @@ unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
                                unsigned int nentries);
 #endif
 
+/****************************************************************************
+ * Name: neighbor_pending_poll
+ *
+ * Description:
+ *   Send the packets queued by neighbor_queue() on 'dev' whose next hop
+ *   address has been resolved, and discard those that waited too long for
+ *   the Neighbor Advertisement.  Each packet is placed in d_buf and passed
+ *   to the driver callback as an outgoing IPv6 packet.
+ *
+ * Input Parameters:
+ *   dev      - The device being polled
+ *   callback - The driver poll callback
+ *
+ * Returned Value:
+ *   The value returned by the last callback; non-zero if polling should
+ *   stop.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver indirectly through
+ *   devif_poll() and devif_timer().  The network must be locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+int neighbor_pending_poll(FAR struct net_driver_s *dev,
+                          devif_poll_callback_t callback);
+#endif
+
+/****************************************************************************
+ * Name: neighbor_pending_flush
+ *
+ * Description:
+ *   Discard the packets queued by neighbor_queue() on 'dev'.  Called when
+ *   the device is unregistered, so that no Neighbor Advertisement refers to
+ *   it later.
+ *
+ * Input Parameters:
+ *   dev - The device being unregistered
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+void neighbor_pending_flush(FAR struct net_driver_s *dev);
+#else
+#  define neighbor_pending_flush(d)
+#endif
+
 /****************************************************************************
  * Name: neighbor_dumpentry
  *
@@ -55,6 +55,7 @@
 #include <nuttx/net/neighbor.h>
 
 #include "netdev/netdev.h"
+#include "inet/inet.h"
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -81,53 +82,45 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
-  uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  int     i;
+  FAR struct neighbor_table_entry_s *slot;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
-   */
+  /* The unspecified address marks unused entries.  It is never added. */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  if (net_ipv6addr_cmp(ipaddr, g_ipv6_unspecaddr))
+    {
+      return;
+    }
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  /* Find the matching entry or claim a free or the oldest entry */
+
+  slot = neighbor_findslot(ipaddr);
+  if (slot == NULL)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
-        {
-          oldest_ndx = i;
-          break;
-        }
-
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
-        {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
-        }
+      slot = neighbor_allocslot(ipaddr);
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+  slot->nt_entry.ne_time = clock_systime_ticks();
+
+  slot->nt_entry.ne_addr.na_lltype = dev->d_lltype;
+  slot->nt_entry.ne_addr.na_llsize = netdev_lladdrsize(dev);
 
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  memcpy(&slot->nt_entry.ne_addr.u, addr, slot->nt_entry.ne_addr.na_llsize);
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+  /* If packets are waiting for this mapping, let the device send them */
+
+  if ((slot->nt_flags & NEIGHBOR_FLAG_INCOMPLETE) != 0 &&
+      slot->nt_npending > 0)
+    {
+      netdev_txnotify_dev(slot->nt_dev);
+    }
+#endif
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  slot->nt_flags &= ~NEIGHBOR_FLAG_INCOMPLETE;
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", &slot->nt_entry);
 }
@@ -180,6 +180,14 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev)
         {
            ninfo("IPv6 Neighbor solicitation for IPv6\n");
 
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+          /* Keep a copy of the IPv6 packet to send when the Neighbor
+           * Advertisement arrives.
+           */
+
+          neighbor_queue(dev, ipaddr);
+#endif
+
           /* The destination address was not in our Neighbor Table, so we
            * overwrite the IPv6 packet with an ICMDv6 Neighbor Solicitation
            * message.
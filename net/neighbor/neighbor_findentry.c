@@ -46,12 +46,150 @@
 #include <string.h>
 #include <debug.h>
 
+#include "inet/inet.h"
 #include "neighbor/neighbor.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain for an IPv6 address.  The interface identifier
+ *   (the low 64 bits) is folded into 32 bits and the high bits of a
+ *   multiplicative hash of the result are used.
+ *
+ ****************************************************************************/
+
+static inline unsigned int neighbor_hash(FAR const net_ipv6addr_t ipaddr)
+{
+  uint32_t hash;
+
+  hash = ((uint32_t)ipaddr[4] << 16 | ipaddr[5]) ^
+         ((uint32_t)ipaddr[6] << 16 | ipaddr[7]) ^ ipaddr[3];
+  return ((hash * 0x9e3779b1) >> 16) % NEIGHBOR_HASHSIZE;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: neighbor_findslot
+ *
+ * Description:
+ *   Find the Neighbor Table entry of an IPv6 address, whether it is
+ *   resolved, incomplete or expired.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address to use in the lookup;
+ *
+ * Returned Value:
+ *   The table entry corresponding to the IPv6 address;  NULL is returned
+ *   if the address is not in the Neighbor Table.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_table_entry_s *
+neighbor_findslot(FAR const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_table_entry_s *slot;
+  uint16_t ndx;
+
+  for (ndx = g_neighbor_hash[neighbor_hash(ipaddr)];
+       ndx != NEIGHBOR_NOENTRY;
+       ndx = slot->nt_next)
+    {
+      slot = &g_neighbors[ndx - 1];
+      if (net_ipv6addr_cmp(slot->nt_entry.ne_ipaddr, ipaddr))
+        {
+          return slot;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: neighbor_allocslot
+ *
+ * Description:
+ *   Claim a Neighbor Table entry for an IPv6 address that is not in the
+ *   table.  A free entry is used if there is one, otherwise the oldest
+ *   entry is evicted.  The new entry is linked into its hash chain.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address of the new entry
+ *
+ * Returned Value:
+ *   The new table entry.  Only the IPv6 address is valid.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_table_entry_s *
+neighbor_allocslot(FAR const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_table_entry_s *slot = &g_neighbors[0];
+  FAR uint16_t *link;
+  int i;
+
+  /* Find the first unused entry or the oldest used entry.  An unused entry
+   * has the unspecified IPv6 address.
+   */
+
+  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; i++)
+    {
+      FAR struct neighbor_table_entry_s *candidate = &g_neighbors[i];
+
+      if (net_ipv6addr_cmp(candidate->nt_entry.ne_ipaddr,
+                           g_ipv6_unspecaddr))
+        {
+          slot = candidate;
+          break;
+        }
+
+      if ((int)(candidate->nt_entry.ne_time - slot->nt_entry.ne_time) < 0)
+        {
+          slot = candidate;
+        }
+    }
+
+  if (!net_ipv6addr_cmp(slot->nt_entry.ne_ipaddr, g_ipv6_unspecaddr))
+    {
+      /* Evict the oldest entry: Remove it from its hash chain */
+
+      neighbor_dumpentry("Evict entry", &slot->nt_entry);
+
+      link = &g_neighbor_hash[neighbor_hash(slot->nt_entry.ne_ipaddr)];
+      while (*link != NEIGHBOR_NOENTRY)
+        {
+          if (&g_neighbors[*link - 1] == slot)
+            {
+              *link = slot->nt_next;
+              break;
+            }
+
+          link = &g_neighbors[*link - 1].nt_next;
+        }
+
+      neighbor_free_pending(slot);
+      NEIGHBOR_STAT(evicted);
+    }
+
+  /* Link the entry at the head of its hash chain */
+
+  link           = &g_neighbor_hash[neighbor_hash(ipaddr)];
+  slot->nt_flags = 0;
+  slot->nt_next  = *link;
+  *link          = slot - g_neighbors + 1;
+  net_ipv6addr_copy(slot->nt_entry.ne_ipaddr, ipaddr);
+
+  NEIGHBOR_STAT(added);
+  return slot;
+}
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
@@ -64,25 +202,25 @@
  *
  * Returned Value:
  *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
- *   returned if there is no matching entry in the Neighbor Table.
+ *   returned if there is no resolved, unexpired entry for the address in
+ *   the Neighbor Table.
  *
  ****************************************************************************/
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_table_entry_s *slot;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  slot = neighbor_findslot(ipaddr);
+  if (slot != NULL && (slot->nt_flags & NEIGHBOR_FLAG_INCOMPLETE) == 0 &&
+      clock_systime_ticks() - slot->nt_entry.ne_time <= NEIGHBOR_MAXAGE_TICK)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
-        {
-          neighbor_dumpentry("Entry found", neighbor);
-          return neighbor;
-        }
+      neighbor_dumpentry("Entry found", &slot->nt_entry);
+      NEIGHBOR_STAT(hits);
+      return &slot->nt_entry;
     }
 
   neighbor_dumpipaddr("Not found", ipaddr);
+  NEIGHBOR_STAT(misses);
   return NULL;
 }
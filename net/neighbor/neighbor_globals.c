@@ -54,7 +54,17 @@
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+struct neighbor_table_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* The head of each hash chain of the Neighbor Table */
+
+uint16_t g_neighbor_hash[NEIGHBOR_HASHSIZE];
+
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+/* The number of Neighbor Table entries that hold queued packets */
+
+uint16_t g_neighbor_npending;
+#endif
 
 /****************************************************************************
  * Public Functions
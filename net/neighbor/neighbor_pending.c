@@ -0,0 +1,305 @@
+/****************************************************************************
+ * net/neighbor/neighbor_pending.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "inet/inet.h"
+#include "neighbor/neighbor.h"
+
+#ifdef CONFIG_NET_IPv6_NCONF_PENDING
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_dequeue
+ *
+ * Description:
+ *   Remove the oldest packet queued on a Neighbor Table entry.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *
+neighbor_dequeue(FAR struct neighbor_table_entry_s *slot)
+{
+  FAR struct iob_s *iob = slot->nt_pending[0];
+
+  memmove(&slot->nt_pending[0], &slot->nt_pending[1],
+          (CONFIG_NET_IPv6_NCONF_MAXPENDING - 1) *
+          sizeof(FAR struct iob_s *));
+
+  if (--slot->nt_npending == 0)
+    {
+      slot->nt_dev = NULL;
+      g_neighbor_npending--;
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_free_pending
+ *
+ * Description:
+ *   Discard all packets queued on a Neighbor Table entry.
+ *
+ * Input Parameters:
+ *   slot - The Neighbor Table entry
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void neighbor_free_pending(FAR struct neighbor_table_entry_s *slot)
+{
+  while (slot->nt_npending > 0)
+    {
+      iob_free_chain(neighbor_dequeue(slot), IOBUSER_NET_NEIGHBOR);
+      NEIGHBOR_STAT(dropped);
+    }
+}
+
+/****************************************************************************
+ * Name: neighbor_queue
+ *
+ * Description:
+ *   Queue the IPv6 packet in d_buf until the link layer address of
+ *   'ipaddr' has been resolved.  An incomplete Neighbor Table entry is
+ *   created for the address if there is none.  If the queue of the entry is
+ *   full, the oldest packet is discarded.
+ *
+ * Input Parameters:
+ *   dev    - The device that is sending the packet
+ *   ipaddr - The next hop IPv6 address to be resolved
+ *
+ * Returned Value:
+ *   Zero (OK) if the packet was queued.  A negated errno value is returned
+ *   if the packet could not be queued.  d_buf is not modified in any case.
+ *
+ ****************************************************************************/
+
+int neighbor_queue(FAR struct net_driver_s *dev,
+                   FAR const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_table_entry_s *slot;
+  FAR struct iob_s *iob;
+  int ret;
+
+  if (net_ipv6addr_cmp(ipaddr, g_ipv6_unspecaddr))
+    {
+      return -EINVAL;
+    }
+
+  /* Copy the IPv6 packet into an I/O buffer chain */
+
+  iob = iob_tryalloc(false, IOBUSER_NET_NEIGHBOR);
+  if (iob == NULL)
+    {
+      NEIGHBOR_STAT(dropped);
+      return -ENOMEM;
+    }
+
+  ret = iob_trycopyin(iob, &dev->d_buf[NET_LL_HDRLEN(dev)], dev->d_len, 0,
+                      false, IOBUSER_NET_NEIGHBOR);
+  if (ret < 0)
+    {
+      iob_free_chain(iob, IOBUSER_NET_NEIGHBOR);
+      NEIGHBOR_STAT(dropped);
+      return ret;
+    }
+
+  /* Find or create the incomplete entry.  An expired entry is re-used and
+   * becomes incomplete until the new advertisement arrives.
+   */
+
+  slot = neighbor_findslot(ipaddr);
+  if (slot == NULL)
+    {
+      slot = neighbor_allocslot(ipaddr);
+    }
+
+  if ((slot->nt_flags & NEIGHBOR_FLAG_INCOMPLETE) == 0)
+    {
+      slot->nt_flags         |= NEIGHBOR_FLAG_INCOMPLETE;
+      slot->nt_entry.ne_time  = clock_systime_ticks();
+    }
+
+  if (slot->nt_npending > 0 && slot->nt_dev != dev)
+    {
+      /* The packets were queued by another device; the next hop moved */
+
+      neighbor_free_pending(slot);
+    }
+
+  if (slot->nt_npending >= CONFIG_NET_IPv6_NCONF_MAXPENDING)
+    {
+      /* The queue is full, discard the oldest packet */
+
+      iob_free_chain(neighbor_dequeue(slot), IOBUSER_NET_NEIGHBOR);
+      NEIGHBOR_STAT(dropped);
+    }
+
+  if (slot->nt_npending == 0)
+    {
+      g_neighbor_npending++;
+    }
+
+  slot->nt_dev = dev;
+  slot->nt_pending[slot->nt_npending++] = iob;
+
+  NEIGHBOR_STAT(queued);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: neighbor_pending_poll
+ *
+ * Description:
+ *   Send the packets queued by neighbor_queue() on 'dev' whose next hop
+ *   address has been resolved, and discard those that waited too long for
+ *   the Neighbor Advertisement.  Each packet is placed in d_buf and passed
+ *   to the driver callback as an outgoing IPv6 packet.
+ *
+ * Input Parameters:
+ *   dev      - The device being polled
+ *   callback - The driver poll callback
+ *
+ * Returned Value:
+ *   The value returned by the last callback; non-zero if polling should
+ *   stop.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver indirectly through
+ *   devif_poll() and devif_timer().  The network must be locked.
+ *
+ ****************************************************************************/
+
+int neighbor_pending_poll(FAR struct net_driver_s *dev,
+                          devif_poll_callback_t callback)
+{
+  FAR struct neighbor_table_entry_s *slot;
+  FAR struct iob_s *iob;
+  clock_t now;
+  int bstop = 0;
+  int i;
+
+  if (g_neighbor_npending == 0)
+    {
+      return 0;
+    }
+
+  now = clock_systime_ticks();
+  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES && !bstop; i++)
+    {
+      slot = &g_neighbors[i];
+      if (slot->nt_npending == 0 || slot->nt_dev != dev)
+        {
+          continue;
+        }
+
+      if ((slot->nt_flags & NEIGHBOR_FLAG_INCOMPLETE) != 0)
+        {
+          if (now - slot->nt_entry.ne_time > NEIGHBOR_INCOMPLETE_TICK)
+            {
+              /* No advertisement, give up */
+
+              neighbor_free_pending(slot);
+            }
+
+          continue;
+        }
+
+      /* The address has been resolved, send the packets in order */
+
+      while (slot->nt_npending > 0 && !bstop)
+        {
+          iob           = neighbor_dequeue(slot);
+          dev->d_len    = iob->io_pktlen;
+          dev->d_sndlen = 0;
+          iob_copyout(&dev->d_buf[NET_LL_HDRLEN(dev)], iob, dev->d_len, 0);
+          iob_free_chain(iob, IOBUSER_NET_NEIGHBOR);
+
+          IFF_SET_IPv6(dev->d_flags);
+          NEIGHBOR_STAT(sent);
+
+          bstop = callback(dev);
+        }
+    }
+
+  return bstop;
+}
+
+/****************************************************************************
+ * Name: neighbor_pending_flush
+ *
+ * Description:
+ *   Discard the packets queued by neighbor_queue() on 'dev'.  Called when
+ *   the device is unregistered, so that no Neighbor Advertisement refers to
+ *   it later.
+ *
+ * Input Parameters:
+ *   dev - The device being unregistered
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void neighbor_pending_flush(FAR struct net_driver_s *dev)
+{
+  FAR struct neighbor_table_entry_s *slot;
+  int i;
+
+  for (i = 0;
+       i < CONFIG_NET_IPv6_NCONF_ENTRIES && g_neighbor_npending > 0;
+       i++)
+    {
+      slot = &g_neighbors[i];
+      if (slot->nt_npending > 0 && slot->nt_dev == dev)
+        {
+          neighbor_free_pending(slot);
+        }
+    }
+}
+
+#endif /* CONFIG_NET_IPv6_NCONF_PENDING */
@@ -83,14 +83,17 @@ unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
        nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
        i++)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_table_entry_s *slot = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &slot->nt_entry;
 
       /* An unused entry table entry will be nullified.  In particularly,
        * the Neighbor IP address will be all zero (i.e., the unspecified
-       * IPv6 address).
+       * IPv6 address).  Entries that are still being resolved are not
+       * returned.
        */
 
-      if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr))
+      if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr) &&
+          (slot->nt_flags & NEIGHBOR_FLAG_INCOMPLETE) == 0)
         {
           memcpy(&snapshot[ncopied], neighbor, sizeof(struct neighbor_entry_s));
           ncopied++;
@@ -89,6 +89,7 @@
 #include "igmp/igmp.h"
 #include "icmpv6/icmpv6.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
 #include "netlink/netlink.h"
 
 /****************************************************************************
@@ -358,6 +359,7 @@ static void ioctl_set_ipv4addr(FAR in_addr_t *outaddr,
 {
   FAR const struct sockaddr_in *src = (FAR const struct sockaddr_in *)inaddr;
   *outaddr = src->sin_addr.s_addr;
+  ipfwd_flowflush();
 }
 #endif
 
@@ -381,6 +383,7 @@ static void ioctl_set_ipv6addr(FAR net_ipv6addr_t outaddr,
   FAR const struct sockaddr_in6 *src =
     (FAR const struct sockaddr_in6 *)inaddr;
   memcpy(outaddr, src->sin6_addr.in6_u.u6_addr8, 16);
+  ipfwd_flowflush();
 }
 #endif
 
@@ -1839,6 +1842,7 @@ void netdev_ifup(FAR struct net_driver_s *dev)
               /* Update the driver status */
 
               netlink_device_notify(dev);
+              ipfwd_flowflush();
             }
         }
     }
@@ -1865,6 +1869,7 @@ void netdev_ifdown(FAR struct net_driver_s *dev)
               /* Update the driver status */
 
               netlink_device_notify(dev);
+              ipfwd_flowflush();
             }
         }
 
@@ -0,0 +1,200 @@
+/****************************************************************************
+ * net/netdev/netdev_napi.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_NAPI
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Like the rest of the network, polling never runs on the high priority
+ * work queue.  NETDEV_NAPI depends on SCHED_LPWORK, so LPWORK does not fall
+ * back to HPWORK.
+ */
+
+#define NAPIWORK LPWORK
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_napi_work
+ *
+ * Description:
+ *   Receive up to one budget of frames.  If the budget was exhausted, there
+ *   may be more frames waiting and the poll is queued again, letting other
+ *   work run in between.  Otherwise the receive interrupt is re-enabled.
+ *
+ ****************************************************************************/
+
+static void netdev_napi_work(FAR void *arg)
+{
+  FAR struct net_driver_s *dev = (FAR struct net_driver_s *)arg;
+  FAR struct netdev_napi_s *napi = &dev->d_napi;
+  int nframes;
+
+  net_lock();
+
+  nframes = napi->nn_poll(dev, napi->nn_budget);
+  DEBUGASSERT(nframes >= 0 && nframes <= napi->nn_budget);
+
+#ifdef CONFIG_NETDEV_STATISTICS
+  /* The first frame after an interrupt is the one that raised it, all
+   * others were found by polling.
+   */
+
+  if (napi->nn_irq && nframes > 0)
+    {
+      dev->d_statistics.rx_intframes++;
+      dev->d_statistics.rx_pollframes += nframes - 1;
+    }
+  else
+    {
+      dev->d_statistics.rx_pollframes += nframes;
+    }
+#endif
+
+  napi->nn_irq = false;
+
+  if (nframes >= napi->nn_budget)
+    {
+      /* More frames may be waiting, keep polling */
+
+      work_queue(NAPIWORK, &napi->nn_work, netdev_napi_work, dev, 0);
+    }
+  else
+    {
+      /* The receive queue has drained, wait for the next interrupt */
+
+      napi->nn_rxint(dev);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_napi_init
+ *
+ * Description:
+ *   Prepare budgeted receive polling for a network device.  This must be
+ *   called by the driver before the device is brought up.
+ *
+ * Input Parameters:
+ *   dev    - The network device
+ *   poll   - Driver function that receives up to 'budget' frames
+ *   rxint  - Driver function that re-enables the receive interrupt
+ *   budget - The maximum number of frames per poll, or zero for the
+ *            default CONFIG_NETDEV_NAPI_BUDGET
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_napi_init(FAR struct net_driver_s *dev, netdev_rxpoll_t poll,
+                      netdev_rxint_t rxint, int budget)
+{
+  FAR struct netdev_napi_s *napi = &dev->d_napi;
+
+  DEBUGASSERT(poll != NULL && rxint != NULL && budget >= 0);
+
+  napi->nn_poll   = poll;
+  napi->nn_rxint  = rxint;
+  napi->nn_budget = budget > 0 ? budget : CONFIG_NETDEV_NAPI_BUDGET;
+  napi->nn_irq    = false;
+}
+
+/****************************************************************************
+ * Name: netdev_napi_schedule
+ *
+ * Description:
+ *   Schedule the receive polling of a device after the driver has disabled
+ *   its receive interrupt.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void netdev_napi_schedule(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_napi_s *napi = &dev->d_napi;
+
+  DEBUGASSERT(napi->nn_poll != NULL);
+
+#ifdef CONFIG_NETDEV_STATISTICS
+  dev->d_statistics.rx_interrupts++;
+#endif
+
+  if (work_available(&napi->nn_work))
+    {
+      napi->nn_irq = true;
+      work_queue(NAPIWORK, &napi->nn_work, netdev_napi_work, dev, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_napi_cancel
+ *
+ * Description:
+ *   Cancel any pending receive polling of a device.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_napi_cancel(FAR struct net_driver_s *dev)
+{
+  work_cancel(NAPIWORK, &dev->d_napi.nn_work);
+  dev->d_napi.nn_irq = false;
+}
+
+#endif /* CONFIG_NETDEV_NAPI */
@@ -79,8 +79,11 @@ void netdev_ipv4_txnotify(in_addr_t lipaddr, in_addr_t ripaddr)
   dev = netdev_findby_ripv4addr(lipaddr, ripaddr);
   if (dev && dev->d_txavail)
     {
-      /* Notify the device driver that new TX data is available. */
+      /* Notify the device driver that new TX data is available.  The TX
+       * latency is measured from the first of the pending notifications.
+       */
 
+      NETDEV_TXSTAMP(dev);
       dev->d_txavail(dev);
     }
 }
@@ -113,8 +116,11 @@ void netdev_ipv6_txnotify(FAR const net_ipv6addr_t lipaddr,
   dev = netdev_findby_ripv6addr(lipaddr, ripaddr);
   if (dev && dev->d_txavail)
     {
-      /* Notify the device driver that new TX data is available. */
+      /* Notify the device driver that new TX data is available.  The TX
+       * latency is measured from the first of the pending notifications.
+       */
 
+      NETDEV_TXSTAMP(dev);
       dev->d_txavail(dev);
     }
 }
@@ -140,8 +146,11 @@ void netdev_txnotify_dev(FAR struct net_driver_s *dev)
 {
   if (dev != NULL && dev->d_txavail != NULL)
     {
-      /* Notify the device driver that new TX data is available. */
+      /* Notify the device driver that new TX data is available.  The TX
+       * latency is measured from the first of the pending notifications.
+       */
 
+      NETDEV_TXSTAMP(dev);
       dev->d_txavail(dev);
     }
 }
@@ -52,6 +52,9 @@
 
 #include "utils/utils.h"
 #include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
+#include "arp/arp.h"
+#include "neighbor/neighbor.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -158,6 +161,19 @@ int netdev_unregister(FAR struct net_driver_s *dev)
             }
 
           curr->flink = NULL;
+
+          /* Forget the forwarding flows through the device */
+
+          ipfwd_flowflush();
+
+          /* Drop the packets waiting for address resolution on the device.
+           * A late response would otherwise notify the freed device.
+           */
+
+          arp_pending_flush(dev);
+#ifdef CONFIG_NET_IPv6
+          neighbor_pending_flush(dev);
+#endif
         }
 
 #ifdef CONFIG_NETDEV_IFINDEX
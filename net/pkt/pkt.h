@@ -43,8 +43,11 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <queue.h>
 
+#include <netpacket/packet.h>
+
 #ifdef CONFIG_NET_PKT
 
 /****************************************************************************
@@ -62,9 +65,25 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_PKT_MMAP
+/* A ring of frames shared with the application (PACKET_RX_RING and
+ * PACKET_TX_RING).  Each frame starts with a struct tpacket_hdr.
+ */
+
+struct pkt_ring_s
+{
+  FAR uint8_t *pr_base;        /* Frames, allocated from the user heap */
+  unsigned int pr_framesize;   /* Size of one frame */
+  unsigned int pr_nframes;     /* Number of frames */
+  unsigned int pr_head;        /* RX: Next frame to fill, TX: to send */
+  unsigned int pr_users;       /* TX: Threads sending from the ring */
+};
+#endif
+
 /* Representation of a packet socket connection */
 
 struct devif_callback_s; /* Forward reference */
+struct pollfd;           /* Forward reference */
 
 struct pkt_conn_s
 {
@@ -84,6 +103,18 @@ struct pkt_conn_s
   uint8_t    ifindex;
   uint16_t   proto;
   uint8_t    crefs;    /* Reference counts on this instance */
+
+#ifdef CONFIG_NET_PKT_MMAP
+  struct pkt_ring_s rxring;   /* Receive ring */
+  struct pkt_ring_s txring;   /* Transmit ring */
+  uint16_t   rxwakeup;        /* Frames filled before poll notification */
+  uint16_t   rxpending;       /* Frames filled since the last notification */
+  bool       rxlosing;        /* Frames were dropped since the last fill */
+
+  /* The threads waiting for frames in the receive ring */
+
+  FAR struct pollfd *fds[CONFIG_NET_PKT_NPOLLWAITERS];
+#endif
 };
 
 /****************************************************************************
@@ -308,6 +339,150 @@ struct socket;
 ssize_t psock_pkt_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len);
 
+#ifdef CONFIG_NET_PKT_MMAP
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the packet socket option specified by the
+ *   'option' argument to the value pointed to by the 'value' argument for
+ *   the socket specified by the 'psock' argument.
+ *
+ *   See <netpacket/packet.h> for the list of packet socket options.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_setcockopt() for
+ *   the list of possible error values.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len);
+
+/****************************************************************************
+ * Name: pkt_getsockopt
+ *
+ * Description:
+ *   pkt_getsockopt() retrieves the value for the packet socket option
+ *   specified by the 'option' argument for the socket specified by the
+ *   'psock' argument.  For PACKET_RX_RING and PACKET_TX_RING, this is the
+ *   address of the ring.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of the socket to query
+ *   option    identifies the option to get
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_getsockopt() for
+ *   the complete list of appropriate return error codes.
+ *
+ ****************************************************************************/
+
+int pkt_getsockopt(FAR struct socket *psock, int option,
+                   FAR void *value, FAR socklen_t *value_len);
+
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Allocate a ring with the geometry of a struct tpacket_req, or free the
+ *   ring if the request has no blocks.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+struct tpacket_req; /* Forward reference */
+int pkt_ring_setup(FAR struct pkt_ring_s *ring,
+                   FAR const struct tpacket_req *req);
+
+/****************************************************************************
+ * Name: pkt_ring_free
+ *
+ * Description:
+ *   Free the receive and transmit rings of a packet socket connection.
+ *
+ ****************************************************************************/
+
+void pkt_ring_free(FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame in d_buf into the next frame of the receive ring.  If
+ *   the application has not yet released that frame, the received frame is
+ *   dropped.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_ring_flush
+ *
+ * Description:
+ *   Notify the poll() waiters of frames filled in the receive ring that
+ *   are still below the wakeup threshold.  Called from the periodic device
+ *   poll so that the application sees the tail of a burst in bounded time.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_flush(FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down a poll() on a packet socket.  POLLIN is reported
+ *   when the receive ring holds frames for the application.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup);
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send all of the frames of the transmit ring that the application has
+ *   marked with TP_STATUS_SEND_REQUEST, in ring order.  The frame data
+ *   follows the frame header at offset TPACKET_HDRLEN.
+ *
+ * Returned Value:
+ *   The number of bytes sent, or a negated errno value if the first frame
+ *   could not be sent.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct socket *psock);
+#endif /* CONFIG_NET_PKT_MMAP */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -157,6 +157,9 @@ FAR struct pkt_conn_s *pkt_alloc(void)
       /* Make sure that the connection is marked as uninitialized */
 
       conn->ifindex = 0;
+#ifdef CONFIG_NET_PKT_MMAP
+      conn->rxwakeup = 1;
+#endif
 
       /* Enqueue the connection into the active list */
 
@@ -182,6 +185,10 @@ void pkt_free(FAR struct pkt_conn_s *conn)
 
   DEBUGASSERT(conn->crefs == 0);
 
+#ifdef CONFIG_NET_PKT_MMAP
+  pkt_ring_free(conn);
+#endif
+
   _pkt_semtake(&g_free_sem);
 
   /* Remove the connection from the active list */
@@ -0,0 +1,127 @@
+/****************************************************************************
+ * net/pkt/pkt_getsockopt.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_MMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_getsockopt
+ *
+ * Description:
+ *   pkt_getsockopt() retrieves the value for the packet socket option
+ *   specified by the 'option' argument for the socket specified by the
+ *   'psock' argument.  If the size of the option value is greater than
+ *   'value_len', the value stored in the object pointed to by the 'value'
+ *   argument will be silently truncated.  Otherwise, the length pointed to
+ *   by the 'value_len' argument will be modified to indicate the actual
+ *   length of the 'value'.
+ *
+ *   Sockets cannot be mmap'ed, so PACKET_RX_RING and PACKET_TX_RING return
+ *   the address of the ring set up by pkt_setsockopt() instead.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of the socket to query
+ *   option    identifies the option to get
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_getsockopt() for
+ *   the complete list of appropriate return error codes.
+ *
+ ****************************************************************************/
+
+int pkt_getsockopt(FAR struct socket *psock, int option,
+                   FAR void *value, FAR socklen_t *value_len)
+{
+  FAR struct pkt_conn_s *conn;
+  int ret = OK;
+
+  DEBUGASSERT(psock != NULL && value != NULL && value_len != NULL &&
+              psock->s_conn != NULL);
+  conn = (FAR struct pkt_conn_s *)psock->s_conn;
+
+  if (psock->s_type != SOCK_RAW)
+    {
+      nerr("ERROR:  Not a RAW packet socket\n");
+      return -ENOTCONN;
+    }
+
+  switch (option)
+    {
+      case PACKET_RX_RING:
+      case PACKET_TX_RING:
+        if (*value_len < sizeof(FAR void *))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            *(FAR void **)value = option == PACKET_RX_RING ?
+                                  conn->rxring.pr_base :
+                                  conn->txring.pr_base;
+            *value_len = sizeof(FAR void *);
+          }
+        break;
+
+      case PACKET_RX_WAKEUP:
+        if (*value_len < sizeof(int))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            *(FAR int *)value = conn->rxwakeup;
+            *value_len = sizeof(int);
+          }
+        break;
+
+      default:
+        nerr("ERROR: Unrecognized packet socket option: %d\n", option);
+        ret = -ENOPROTOOPT;
+        break;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_NET_PKT_MMAP */
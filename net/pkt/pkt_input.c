@@ -91,6 +91,15 @@ int pkt_input(struct net_driver_s *dev)
   int ret = OK;
 
   conn = pkt_active(pbuf);
+#ifdef CONFIG_NET_PKT_MMAP
+  if (conn != NULL && conn->rxring.pr_base != NULL)
+    {
+      /* Frames go directly into the receive ring */
+
+      pkt_ring_input(dev, conn);
+    }
+  else
+#endif
   if (conn)
     {
       uint16_t flags;
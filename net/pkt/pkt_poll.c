@@ -82,6 +82,12 @@ void pkt_poll(FAR struct net_driver_s *dev, FAR struct pkt_conn_s *conn)
 
   if (conn != NULL)
     {
+#ifdef CONFIG_NET_PKT_MMAP
+      /* Report frames left below the wakeup threshold of the receive ring */
+
+      pkt_ring_flush(conn);
+#endif
+
       /* Setup for the application callback */
 
       dev->d_appdata = &dev->d_buf[NET_LL_HDRLEN(dev)];
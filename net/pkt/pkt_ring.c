@@ -0,0 +1,508 @@
+/****************************************************************************
+ * net/pkt/pkt_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <poll.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "socket/socket.h"
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_MMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PKT_FRAME(r,i) \
+  ((FAR struct tpacket_hdr *)&(r)->pr_base[(i) * (r)->pr_framesize])
+
+/* Without spinlock support, there is no multi-CPU ordering to enforce */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_rxready
+ *
+ * Description:
+ *   Return true if the application has not yet released the most recently
+ *   filled frame of the receive ring.
+ *
+ ****************************************************************************/
+
+static bool pkt_ring_rxready(FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring = &conn->rxring;
+  unsigned int last;
+
+  if (ring->pr_base == NULL)
+    {
+      return false;
+    }
+
+  last = ring->pr_head > 0 ? ring->pr_head - 1 : ring->pr_nframes - 1;
+  return (PKT_FRAME(ring, last)->tp_status & TP_STATUS_USER) != 0;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_notify
+ *
+ * Description:
+ *   Report POLLIN to the threads polling the socket.
+ *
+ ****************************************************************************/
+
+static void pkt_ring_notify(FAR struct pkt_conn_s *conn)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  conn->rxpending = 0;
+
+  for (i = 0; i < CONFIG_NET_PKT_NPOLLWAITERS; i++)
+    {
+      fds = conn->fds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= fds->events & POLLIN;
+          if (fds->revents != 0)
+            {
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Allocate a ring with the geometry of a struct tpacket_req, or free the
+ *   ring if the request has no blocks.  The blocks are allocated as one
+ *   contiguous region so that frames never straddle a block boundary.
+ *   A ring that a thread is sending from cannot be changed.
+ *
+ * Input Parameters:
+ *   ring - The ring to set up
+ *   req  - The requested ring geometry
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  -EBUSY is
+ *   returned if the ring is set up or in use.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int pkt_ring_setup(FAR struct pkt_ring_s *ring,
+                   FAR const struct tpacket_req *req)
+{
+  FAR uint8_t *base;
+  size_t size;
+
+  /* The frames are in use while a thread sends from the ring */
+
+  if (ring->pr_users > 0)
+    {
+      return -EBUSY;
+    }
+
+  if (req->tp_block_nr == 0)
+    {
+      if (ring->pr_base != NULL)
+        {
+          kumm_free(ring->pr_base);
+        }
+
+      memset(ring, 0, sizeof(struct pkt_ring_s));
+      return OK;
+    }
+
+  if (ring->pr_base != NULL)
+    {
+      return -EBUSY;
+    }
+
+  /* Each frame must hold an aligned header and some data, and the frames
+   * must fill the blocks exactly.
+   */
+
+  if (req->tp_frame_size <= TPACKET_HDRLEN ||
+      (req->tp_frame_size & (TPACKET_ALIGNMENT - 1)) != 0 ||
+      req->tp_block_size < req->tp_frame_size ||
+      (req->tp_block_size % req->tp_frame_size) != 0 ||
+      req->tp_frame_nr !=
+        (req->tp_block_size / req->tp_frame_size) * req->tp_block_nr)
+    {
+      return -EINVAL;
+    }
+
+  size = (size_t)req->tp_block_size * req->tp_block_nr;
+  if (size / req->tp_block_nr != req->tp_block_size)
+    {
+      return -EINVAL;
+    }
+
+  /* Frames start out owned by the network (RX) or available to the
+   * application (TX); both states are zero.
+   */
+
+  base = (FAR uint8_t *)kumm_zalloc(size);
+  if (base == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ring->pr_base      = base;
+  ring->pr_framesize = req->tp_frame_size;
+  ring->pr_nframes   = req->tp_frame_nr;
+  ring->pr_head      = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_free
+ *
+ * Description:
+ *   Free the receive and transmit rings of a packet socket connection.
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pkt_ring_free(FAR struct pkt_conn_s *conn)
+{
+  DEBUGASSERT(conn->txring.pr_users == 0);
+
+  if (conn->rxring.pr_base != NULL)
+    {
+      kumm_free(conn->rxring.pr_base);
+    }
+
+  if (conn->txring.pr_base != NULL)
+    {
+      kumm_free(conn->txring.pr_base);
+    }
+
+  memset(&conn->rxring, 0, sizeof(struct pkt_ring_s));
+  memset(&conn->txring, 0, sizeof(struct pkt_ring_s));
+  conn->rxpending = 0;
+  conn->rxlosing  = false;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame in d_buf into the next frame of the receive ring.  If
+ *   the application has not yet released that frame, the received frame is
+ *   dropped and the next frame filled is marked with TP_STATUS_LOSING.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received frame
+ *   conn - The packet socket connection with a receive ring
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring = &conn->rxring;
+  FAR struct tpacket_hdr *hdr;
+  struct timespec ts;
+  unsigned int snaplen;
+
+  DEBUGASSERT(ring->pr_base != NULL);
+
+  hdr = PKT_FRAME(ring, ring->pr_head);
+  if (hdr->tp_status != TP_STATUS_KERNEL)
+    {
+      /* The ring is full */
+
+      ninfo("Receive ring full, frame dropped\n");
+      NETDEV_RXDROPPED(dev);
+      conn->rxlosing = true;
+      return;
+    }
+
+  snaplen = ring->pr_framesize - TPACKET_HDRLEN;
+  if (snaplen > dev->d_len)
+    {
+      snaplen = dev->d_len;
+    }
+
+  memcpy((FAR uint8_t *)hdr + TPACKET_HDRLEN, dev->d_buf, snaplen);
+
+  clock_systime_timespec(&ts);
+
+  hdr->tp_len     = dev->d_len;
+  hdr->tp_snaplen = snaplen;
+  hdr->tp_mac     = TPACKET_HDRLEN;
+  hdr->tp_net     = TPACKET_HDRLEN + NET_LL_HDRLEN(dev);
+  hdr->tp_sec     = ts.tv_sec;
+  hdr->tp_usec    = ts.tv_nsec / 1000;
+
+  /* The frame must be complete before it is handed to the application */
+
+  SP_DMB();
+  hdr->tp_status  = TP_STATUS_USER |
+                    (conn->rxlosing ? TP_STATUS_LOSING : 0);
+  conn->rxlosing  = false;
+
+  if (++ring->pr_head >= ring->pr_nframes)
+    {
+      ring->pr_head = 0;
+    }
+
+  if (++conn->rxpending >= conn->rxwakeup)
+    {
+      pkt_ring_notify(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_flush
+ *
+ * Description:
+ *   Notify the poll() waiters of frames filled in the receive ring that
+ *   are still below the wakeup threshold.
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_flush(FAR struct pkt_conn_s *conn)
+{
+  if (conn->rxpending > 0)
+    {
+      pkt_ring_notify(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down a poll() on a packet socket.  POLLIN is reported
+ *   when the receive ring holds frames for the application.  The socket is
+ *   always writable.
+ *
+ * Input Parameters:
+ *   conn  - The packet socket connection
+ *   fds   - The structure describing the events to be monitored
+ *   setup - true: Setup up the poll; false: Teardown the poll
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup)
+{
+  FAR struct pollfd **slot;
+  int ret = OK;
+  int i;
+
+  net_lock();
+
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_NET_PKT_NPOLLWAITERS; i++)
+        {
+          if (conn->fds[i] == NULL)
+            {
+              break;
+            }
+        }
+
+      if (i >= CONFIG_NET_PKT_NPOLLWAITERS)
+        {
+          ret = -EBUSY;
+          goto errout;
+        }
+
+      conn->fds[i] = fds;
+      fds->priv    = &conn->fds[i];
+
+      fds->revents = fds->events & POLLOUT;
+      if (pkt_ring_rxready(conn))
+        {
+          fds->revents |= fds->events & POLLIN;
+        }
+
+      if (fds->revents != 0)
+        {
+          nxsem_post(fds->sem);
+        }
+    }
+  else
+    {
+      slot = (FAR struct pollfd **)fds->priv;
+      if (slot != NULL)
+        {
+          *slot     = NULL;
+          fds->priv = NULL;
+        }
+    }
+
+errout:
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send all of the frames of the transmit ring that the application has
+ *   marked with TP_STATUS_SEND_REQUEST, in ring order.  The frame data
+ *   follows the frame header at offset TPACKET_HDRLEN and its length is
+ *   tp_len.
+ *
+ * Input Parameters:
+ *   psock - The packet socket with a transmit ring
+ *
+ * Returned Value:
+ *   The number of bytes sent, or a negated errno value if the first frame
+ *   could not be sent.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct socket *psock)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  FAR struct pkt_ring_s *ring = &conn->txring;
+  FAR struct tpacket_hdr *hdr;
+  ssize_t total = 0;
+  ssize_t ret = 0;
+
+  /* psock_pkt_send() releases the network lock while it waits for the
+   * device.  The ring is pinned for that time so that setsockopt() cannot
+   * free or replace it under the frame being sent.
+   */
+
+  net_lock();
+
+  if (ring->pr_base == NULL)
+    {
+      net_unlock();
+      return -EINVAL;
+    }
+
+  ring->pr_users++;
+
+  for (; ; )
+    {
+      hdr = PKT_FRAME(ring, ring->pr_head);
+      if (hdr->tp_status != TP_STATUS_SEND_REQUEST)
+        {
+          break;
+        }
+
+      if (hdr->tp_len > ring->pr_framesize - TPACKET_HDRLEN)
+        {
+          hdr->tp_status = TP_STATUS_WRONG_FORMAT;
+          ret = -EINVAL;
+        }
+      else
+        {
+          hdr->tp_status = TP_STATUS_SENDING;
+          ret = psock_pkt_send(psock, (FAR uint8_t *)hdr + TPACKET_HDRLEN,
+                               hdr->tp_len);
+          if (ret == -EINTR)
+            {
+              /* Leave the frame for the next send() */
+
+              hdr->tp_status = TP_STATUS_SEND_REQUEST;
+              break;
+            }
+
+          hdr->tp_status = ret < 0 ? TP_STATUS_WRONG_FORMAT :
+                                     TP_STATUS_AVAILABLE;
+        }
+
+      if (++ring->pr_head >= ring->pr_nframes)
+        {
+          ring->pr_head = 0;
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+
+      total += ret;
+    }
+
+  ring->pr_users--;
+  net_unlock();
+
+  return total > 0 ? total : ret;
+}
+
+#endif /* CONFIG_NET_PKT_MMAP */
@@ -0,0 +1,130 @@
+/****************************************************************************
+ * net/pkt/pkt_setsockopt.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_MMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the packet socket option specified by the
+ *   'option' argument to the value pointed to by the 'value' argument for
+ *   the socket specified by the 'psock' argument.
+ *
+ *   See <netpacket/packet.h> for the list of packet socket options.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_setcockopt() for
+ *   the list of possible error values.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len)
+{
+  FAR struct pkt_conn_s *conn;
+  int ret;
+
+  DEBUGASSERT(psock != NULL && value != NULL && psock->s_conn != NULL);
+  conn = (FAR struct pkt_conn_s *)psock->s_conn;
+
+  if (psock->s_type != SOCK_RAW)
+    {
+      nerr("ERROR:  Not a RAW packet socket\n");
+      return -ENOTCONN;
+    }
+
+  switch (option)
+    {
+      case PACKET_RX_RING:
+      case PACKET_TX_RING:
+        if (value_len < sizeof(struct tpacket_req))
+          {
+            return -EINVAL;
+          }
+
+        /* The network fills the receive ring, so it must not be changed
+         * while a frame is being received.
+         */
+
+        net_lock();
+        ret = pkt_ring_setup(option == PACKET_RX_RING ?
+                             &conn->rxring : &conn->txring,
+                             (FAR const struct tpacket_req *)value);
+        if (option == PACKET_RX_RING)
+          {
+            conn->rxpending = 0;
+            conn->rxlosing  = false;
+          }
+
+        net_unlock();
+        break;
+
+      case PACKET_RX_WAKEUP:
+        if (value_len != sizeof(int) || *(FAR const int *)value < 1 ||
+            *(FAR const int *)value > UINT16_MAX)
+          {
+            return -EINVAL;
+          }
+
+        conn->rxwakeup = *(FAR const int *)value;
+        ret = OK;
+        break;
+
+      default:
+        nerr("ERROR: Unrecognized packet socket option: %d\n", option);
+        ret = -ENOPROTOOPT;
+        break;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_NET_PKT_MMAP */
@@ -520,7 +520,11 @@ int pkt_listen(FAR struct socket *psock, int backlog)
 static int pkt_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
                           bool setup)
 {
+#ifdef CONFIG_NET_PKT_MMAP
+  return pkt_ring_poll((FAR struct pkt_conn_s *)psock->s_conn, fds, setup);
+#else
   return -ENOSYS;
+#endif
 }
 
 /****************************************************************************
@@ -551,6 +555,15 @@ static ssize_t pkt_send(FAR struct socket *psock, FAR const void *buf,
 
   if (psock->s_type == SOCK_RAW)
     {
+#ifdef CONFIG_NET_PKT_MMAP
+      /* A send() without data sends the frames of the transmit ring */
+
+      if (len == 0)
+        {
+          return pkt_ring_send(psock);
+        }
+#endif
+
       /* Raw packet send */
 
       ret = psock_pkt_send(psock, buf, len);
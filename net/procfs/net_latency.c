@@ -0,0 +1,270 @@
+/****************************************************************************
+ * net/procfs/net_latency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Output format (all times in microseconds):
+ *
+ *               IPin     L4in   Wakeup   TXpoll
+ *   Samples xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx
+ *   Average xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx
+ *   Maximum xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx
+ *   <1      xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx
+ *   <2      xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx
+ *   ...
+ *   <16384  xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx
+ *   >=16384 xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/net/netstats.h>
+
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_LATENCY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The lines before the histogram */
+
+#define LATENCY_HDRLINES 4
+
+#if NET_LATENCY_NBUCKETS != 16
+#  error The line generation table does not match NET_LATENCY_NBUCKETS
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int netprocfs_latency_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_samples(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_average(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_maximum(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_latency_bucket(FAR struct netprocfs_file_s *netfile);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static const linegen_t g_latency_linegen[] =
+{
+  netprocfs_latency_header,
+  netprocfs_latency_samples,
+  netprocfs_latency_average,
+  netprocfs_latency_maximum,
+
+  /* One line for each bucket of the histograms */
+
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket,
+  netprocfs_latency_bucket
+};
+
+#define NLATENCY_LINES (sizeof(g_latency_linegen) / sizeof(linegen_t))
+
+/* The column headers, in the order of enum net_latency_e */
+
+static const char *g_latency_stages[NET_LATENCY_NSTAGES] =
+{
+  "IPin",
+  "L4in",
+  "Wakeup",
+  "TXpoll"
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_latency_header
+ ****************************************************************************/
+
+static int netprocfs_latency_header(FAR struct netprocfs_file_s *netfile)
+{
+  int len;
+  int i;
+
+  len = snprintf(netfile->line, NET_LINELEN, "%-7s", "");
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      len += snprintf(&netfile->line[len], NET_LINELEN - len, " %8s",
+                      g_latency_stages[i]);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "\n");
+  return len;
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_samples
+ ****************************************************************************/
+
+static int netprocfs_latency_samples(FAR struct netprocfs_file_s *netfile)
+{
+  int len;
+  int i;
+
+  len = snprintf(netfile->line, NET_LINELEN, "%-7s", "Samples");
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      len += snprintf(&netfile->line[len], NET_LINELEN - len, " %8lu",
+                      (unsigned long)g_netlatency[i].nsamples);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "\n");
+  return len;
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_average
+ ****************************************************************************/
+
+static int netprocfs_latency_average(FAR struct netprocfs_file_s *netfile)
+{
+  uint32_t nsamples;
+  int len;
+  int i;
+
+  len = snprintf(netfile->line, NET_LINELEN, "%-7s", "Average");
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      nsamples = g_netlatency[i].nsamples;
+      len += snprintf(&netfile->line[len], NET_LINELEN - len, " %8lu",
+                      nsamples > 0 ?
+                      (unsigned long)(g_netlatency[i].total / nsamples) : 0);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "\n");
+  return len;
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_maximum
+ ****************************************************************************/
+
+static int netprocfs_latency_maximum(FAR struct netprocfs_file_s *netfile)
+{
+  int len;
+  int i;
+
+  len = snprintf(netfile->line, NET_LINELEN, "%-7s", "Maximum");
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      len += snprintf(&netfile->line[len], NET_LINELEN - len, " %8lu",
+                      (unsigned long)g_netlatency[i].max);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "\n");
+  return len;
+}
+
+/****************************************************************************
+ * Name: netprocfs_latency_bucket
+ ****************************************************************************/
+
+static int netprocfs_latency_bucket(FAR struct netprocfs_file_s *netfile)
+{
+  char label[8];
+  int bucket;
+  int len;
+  int i;
+
+  /* The line number selects the bucket */
+
+  bucket = netfile->lineno - LATENCY_HDRLINES;
+  if (bucket < NET_LATENCY_NBUCKETS - 1)
+    {
+      snprintf(label, sizeof(label), "<%lu", 1ul << bucket);
+    }
+  else
+    {
+      snprintf(label, sizeof(label), ">=%lu", 1ul << (bucket - 1));
+    }
+
+  len = snprintf(netfile->line, NET_LINELEN, "%-7s", label);
+  for (i = 0; i < NET_LATENCY_NSTAGES; i++)
+    {
+      len += snprintf(&netfile->line[len], NET_LINELEN - len, " %8lu",
+                      (unsigned long)g_netlatency[i].bucket[bucket]);
+    }
+
+  len += snprintf(&netfile->line[len], NET_LINELEN - len, "\n");
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_latency
+ *
+ * Description:
+ *   Read and format the network latency histograms.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which network status will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_latency(FAR struct netprocfs_file_s *priv,
+                               FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_linegen(priv, buffer, buflen, g_latency_linegen,
+                                NLATENCY_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_LATENCY */
@@ -74,9 +74,15 @@
 #  define STAT_INDEX     0
 #  ifdef CONFIG_NET_MLD
 #    define MLD_INDEX    1
-#    define _ROUTE_INDEX 2
+#    define _LAT_INDEX   2
 #  else
-#    define _ROUTE_INDEX 1
+#    define _LAT_INDEX   1
+#  endif
+#  ifdef CONFIG_NET_LATENCY
+#    define LATENCY_INDEX _LAT_INDEX
+#    define _ROUTE_INDEX (_LAT_INDEX + 1)
+#  else
+#    define _ROUTE_INDEX _LAT_INDEX
 #  endif
 #else
 #  define _ROUTE_INDEX   0
@@ -193,6 +199,18 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
     }
   else
 #endif
+#ifdef CONFIG_NET_LATENCY
+  /* "net/latency" is an acceptable value for the relpath only if the
+   * latency instrumentation is enabled.
+   */
+
+  if (strcmp(relpath, "net/latency") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_LATENCY;
+      dev   = NULL;
+    }
+  else
+#endif
 #endif
 
 #ifdef CONFIG_NET_ROUTE
@@ -323,6 +341,15 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
         nreturned = netprocfs_read_mldstats(priv, buffer, buflen);
         break;
 #endif
+
+#ifdef CONFIG_NET_LATENCY
+      case NETPROCFS_SUBDIR_LATENCY:
+
+        /* Show the latency histograms */
+
+        nreturned = netprocfs_read_latency(priv, buffer, buflen);
+        break;
+#endif
 #endif
 
 #ifdef CONFIG_NET_ROUTE
@@ -445,6 +472,9 @@ static int netprocfs_opendir(FAR const char *relpath,
 #ifdef CONFIG_NET_MLD
       level1->base.nentries++;
 #endif
+#ifdef CONFIG_NET_LATENCY
+      level1->base.nentries++;
+#endif
 #endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
@@ -551,6 +581,16 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
         }
       else
 #endif
+#ifdef CONFIG_NET_LATENCY
+      if (index == LATENCY_INDEX)
+        {
+          /* Copy the latency histograms directory entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "latency", NAME_MAX + 1);
+        }
+      else
+#endif
 #endif
 #ifdef CONFIG_NET_ROUTE
       if (index == ROUTE_INDEX)
@@ -682,6 +722,15 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
     }
   else
 #endif
+#ifdef CONFIG_NET_LATENCY
+  /* Check for the latency histograms "net/latency" */
+
+  if (strcmp(relpath, "net/latency") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
 #endif
 #ifdef CONFIG_NET_ROUTE
   /* Check for network statistics "net/stat" */
@@ -80,6 +80,19 @@ static int     netprocfs_sent(FAR struct netprocfs_file_s *netfile);
 #ifdef CONFIG_NET_TCP
 static int     netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NET_TCP */
+#if defined(CONFIG_NET_ARP) || defined(CONFIG_NET_IPv6)
+static int     netprocfs_neighbor_header(FAR struct netprocfs_file_s *netfile);
+#endif
+#ifdef CONFIG_NET_ARP
+static int     netprocfs_arp(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_ARP */
+#ifdef CONFIG_NET_IPv6
+static int     netprocfs_neighbor(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_IPv6 */
+#ifdef CONFIG_NET_IPFORWARD
+static int     netprocfs_ipfwd_header(FAR struct netprocfs_file_s *netfile);
+static int     netprocfs_ipfwd(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_IPFORWARD */
 
 /****************************************************************************
  * Private Data
@@ -114,6 +127,23 @@ static const linegen_t g_stat_linegen[] =
 #ifdef CONFIG_NET_TCP
   , netprocfs_retransmissions
 #endif /* CONFIG_NET_TCP */
+
+#if defined(CONFIG_NET_ARP) || defined(CONFIG_NET_IPv6)
+  , netprocfs_neighbor_header
+#endif
+
+#ifdef CONFIG_NET_ARP
+  , netprocfs_arp
+#endif /* CONFIG_NET_ARP */
+
+#ifdef CONFIG_NET_IPv6
+  , netprocfs_neighbor
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPFORWARD
+  , netprocfs_ipfwd_header
+  , netprocfs_ipfwd
+#endif /* CONFIG_NET_IPFORWARD */
 };
 
 #define NSTAT_LINES (sizeof(g_stat_linegen) / sizeof(linegen_t))
@@ -436,6 +466,77 @@ static int netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP */
 
+/****************************************************************************
+ * Name: netprocfs_neighbor_header
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_ARP) || defined(CONFIG_NET_IPv6)
+static int netprocfs_neighbor_header(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\nNeighbors    Hits  Miss   Add Evict Queue  Sent  Drop\n");
+}
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_arp
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP
+static int netprocfs_arp(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "  ARP        %04x  %04x  %04x  %04x  %04x  %04x  %04x\n",
+                  g_netstats.arp.hits, g_netstats.arp.misses,
+                  g_netstats.arp.added, g_netstats.arp.evicted,
+                  g_netstats.arp.queued, g_netstats.arp.sent,
+                  g_netstats.arp.dropped);
+}
+#endif /* CONFIG_NET_ARP */
+
+/****************************************************************************
+ * Name: netprocfs_neighbor
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static int netprocfs_neighbor(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "  IPv6       %04x  %04x  %04x  %04x  %04x  %04x  %04x\n",
+                  g_netstats.neighbor.hits, g_netstats.neighbor.misses,
+                  g_netstats.neighbor.added, g_netstats.neighbor.evicted,
+                  g_netstats.neighbor.queued, g_netstats.neighbor.sent,
+                  g_netstats.neighbor.dropped);
+}
+#endif /* CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Name: netprocfs_ipfwd_header
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD
+static int netprocfs_ipfwd_header(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\nForwarding   Fwd Inplc  Hits  Miss  Drop\n");
+}
+#endif /* CONFIG_NET_IPFORWARD */
+
+/****************************************************************************
+ * Name: netprocfs_ipfwd
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD
+static int netprocfs_ipfwd(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "  IP         %04x  %04x  %04x  %04x  %04x\n",
+                  g_netstats.ipfwd.forwarded, g_netstats.ipfwd.inplace,
+                  g_netstats.ipfwd.flowhits, g_netstats.ipfwd.flowmisses,
+                  g_netstats.ipfwd.dropped);
+}
+#endif /* CONFIG_NET_IPFORWARD */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -76,6 +76,10 @@ static int netprocfs_rxstatistics_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxstatistics(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxpackets_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile);
+#ifdef CONFIG_NETDEV_NAPI
+static int netprocfs_rxpolling_header(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_rxpolling(FAR struct netprocfs_file_s *netfile);
+#endif
 static int netprocfs_txstatistics_header(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_errors(FAR struct netprocfs_file_s *netfile);
@@ -106,6 +110,10 @@ static const linegen_t g_netstat_linegen[] =
   netprocfs_rxstatistics,
   netprocfs_rxpackets_header,
   netprocfs_rxpackets,
+#ifdef CONFIG_NETDEV_NAPI
+  netprocfs_rxpolling_header,
+  netprocfs_rxpolling,
+#endif
   netprocfs_txstatistics_header,
   netprocfs_txstatistics,
   netprocfs_errors
@@ -487,6 +495,40 @@ static int netprocfs_rxpackets(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
+/****************************************************************************
+ * Name: netprocfs_rxpolling_header
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_NAPI)
+static int netprocfs_rxpolling_header(FAR struct netprocfs_file_s *netfile)
+{
+  DEBUGASSERT(netfile != NULL);
+  return snprintf(netfile->line, NET_LINELEN, "\t    %-8s %-8s %-8s\n",
+                  "RxIntr", "IntFrame", "Polled");
+}
+#endif /* CONFIG_NETDEV_STATISTICS && CONFIG_NETDEV_NAPI */
+
+/****************************************************************************
+ * Name: netprocfs_rxpolling
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_NAPI)
+static int netprocfs_rxpolling(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct netdev_statistics_s *stats;
+  FAR struct net_driver_s *dev;
+
+  DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
+  dev = netfile->dev;
+  stats = &dev->d_statistics;
+
+  return snprintf(netfile->line, NET_LINELEN, "\t    %08lx %08lx %08lx\n",
+                  (unsigned long)stats->rx_interrupts,
+                  (unsigned long)stats->rx_intframes,
+                  (unsigned long)stats->rx_pollframes);
+}
+#endif /* CONFIG_NETDEV_STATISTICS && CONFIG_NETDEV_NAPI */
+
 /****************************************************************************
  * Name: netprocfs_txstatistics_header
  ****************************************************************************/
@@ -0,0 +1,162 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_LPM
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match index of the in-memory routing
+ *   tables.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void);
+
+/****************************************************************************
+ * Name: net_checklpm_ipv4 and net_checklpm_ipv6
+ *
+ * Description:
+ *   Check if a routing table entry can be added to the longest-prefix-match
+ *   index.
+ *
+ * Input Parameters:
+ *   route - The routing table entry
+ *
+ * Returned Value:
+ *   OK if the route can be indexed; -EINVAL if the netmask is not
+ *   contiguous.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_checklpm_ipv4(FAR const struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_checklpm_ipv6(FAR const struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_addlpm_ipv4 and net_addlpm_ipv6
+ *
+ * Description:
+ *   Add an in-memory routing table entry to the longest-prefix-match index.
+ *
+ * Input Parameters:
+ *   route - The routing table entry.  The entry must remain valid until it
+ *           is removed with net_dellpm_ipv4/6() or net_clearlpm_ipv4/6().
+ *
+ * Returned Value:
+ *   OK on success.  -EINVAL is returned if the netmask is not contiguous
+ *   and -EEXIST if there is already a route with the same target network
+ *   and netmask.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_addlpm_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_addlpm_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_dellpm_ipv4 and net_dellpm_ipv6
+ *
+ * Description:
+ *   Remove an in-memory routing table entry from the longest-prefix-match
+ *   index.
+ *
+ * Input Parameters:
+ *   route - The routing table entry
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_dellpm_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_dellpm_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_clearlpm_ipv4 and net_clearlpm_ipv6
+ *
+ * Description:
+ *   Remove all routes from the longest-prefix-match index.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_clearlpm_ipv4(void);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_clearlpm_ipv6(void);
+#endif
+
+#endif /* CONFIG_ROUTE_LPM */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -50,6 +50,7 @@
 
 #include "route/fileroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
 
@@ -99,7 +100,13 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   nwritten = net_writeroute_ipv4(&fshandle, &route);
 
   net_closeroute_ipv4(&fshandle);
-  return nwritten >= 0 ? 0 : (int)nwritten;
+  if (nwritten < 0)
+    {
+      return (int)nwritten;
+    }
+
+  ipfwd_flowflush();
+  return OK;
 }
 #endif
 
@@ -133,7 +140,13 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   nwritten = net_writeroute_ipv6(&fshandle, &route);
 
   net_closeroute_ipv6(&fshandle);
-  return nwritten >= 0 ? 0 : (int)nwritten;
+  if (nwritten < 0)
+    {
+      return (int)nwritten;
+    }
+
+  ipfwd_flowflush();
+  return OK;
 }
 #endif
 
@@ -50,7 +50,9 @@
 #include <arch/irq.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 
@@ -75,6 +77,9 @@
 int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 {
   FAR struct net_route_ipv4_s *route;
+#ifdef CONFIG_ROUTE_LPM
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -96,11 +101,26 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   net_lock();
 
+#ifdef CONFIG_ROUTE_LPM
+  /* Index the new entry for longest-prefix-match lookups */
+
+  ret = net_addlpm_ipv4(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      nerr("ERROR:  Failed to index the route: %d\n", ret);
+      net_freeroute_ipv4(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
   net_unlock();
+
+  ipfwd_flowflush();
   return OK;
 }
 #endif
@@ -110,6 +130,9 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
                       net_ipv6addr_t router)
 {
   FAR struct net_route_ipv6_s *route;
+#ifdef CONFIG_ROUTE_LPM
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -131,11 +154,26 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   net_lock();
 
+#ifdef CONFIG_ROUTE_LPM
+  /* Index the new entry for longest-prefix-match lookups */
+
+  ret = net_addlpm_ipv6(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      nerr("ERROR:  Failed to index the route: %d\n", ret);
+      net_freeroute_ipv6(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
   net_unlock();
+
+  ipfwd_flowflush();
   return OK;
 }
 #endif
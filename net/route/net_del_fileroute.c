@@ -54,6 +54,7 @@
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
 
@@ -264,6 +265,8 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
   net_flushcache_ipv4();
 #endif
 
+  ipfwd_flowflush();
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
@@ -413,6 +416,8 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
   net_flushcache_ipv6();
 #endif
 
+  ipfwd_flowflush();
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
@@ -48,7 +48,9 @@
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 
@@ -122,6 +124,10 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+#ifdef CONFIG_ROUTE_LPM
+      net_dellpm_ipv4(route);
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv4(route);
@@ -175,6 +181,10 @@ static int net_match_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+#ifdef CONFIG_ROUTE_LPM
+      net_dellpm_ipv6(route);
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv6(route);
@@ -221,7 +231,13 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv4(net_match_ipv4, &match) ? OK : -ENOENT;
+  if (!net_foreachroute_ipv4(net_match_ipv4, &match))
+    {
+      return -ENOENT;
+    }
+
+  ipfwd_flowflush();
+  return OK;
 }
 #endif
 
@@ -238,7 +254,13 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv6(net_match_ipv6, &match) ? OK : -ENOENT;
+  if (!net_foreachroute_ipv6(net_match_ipv6, &match))
+    {
+      return -ENOENT;
+    }
+
+  ipfwd_flowflush();
+  return OK;
 }
 #endif
 
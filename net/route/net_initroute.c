@@ -42,6 +42,7 @@
 #include "route/ramroute.h"
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #ifdef CONFIG_NET_ROUTE
@@ -70,6 +71,10 @@ void net_init_route(void)
   net_init_ramroute();
 #endif
 
+#ifdef CONFIG_ROUTE_LPM
+  net_init_lpmroute();
+#endif
+
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
   net_init_fileroute();
 #endif
@@ -0,0 +1,713 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_LPM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the largest key held in a trie node */
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+#  define LPM_KEYSIZE       sizeof(net_ipv6addr_t)
+#else
+#  define LPM_KEYSIZE       sizeof(in_addr_t)
+#endif
+
+/* A path-compressed trie holding n prefixes never needs more than n nodes
+ * for the prefixes plus n - 1 branching nodes.
+ */
+
+#define LPM_NNODES(n)       (2 * (n))
+
+/* Return bit 'n' of a key, counting from the most significant bit of the
+ * first byte.
+ */
+
+#define LPM_BIT(k,n)        (((k)[(n) >> 3] >> (7 - ((n) & 7))) & 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A node of the trie.  A node either holds a route for its prefix, or it is
+ * a branching node with no route and exactly two children.  All prefixes
+ * in the sub-trie ln_child[b] extend the prefix of the node with bit b.
+ */
+
+struct lpm_node_s
+{
+  FAR struct lpm_node_s *ln_child[2]; /* Sub-tries, indexed by the next bit */
+  FAR void *ln_route;                 /* Route of this prefix, or NULL */
+  uint8_t ln_plen;                    /* Prefix length in bits */
+  uint8_t ln_key[LPM_KEYSIZE];        /* Prefix, network order, masked */
+};
+
+struct lpm_trie_s
+{
+  FAR struct lpm_node_s *lt_root;     /* The root of the trie */
+  FAR struct lpm_node_s *lt_free;     /* Free nodes, linked by ln_child[0] */
+  FAR struct lpm_node_s *lt_nodes;    /* The pool of nodes */
+  unsigned int lt_nnodes;             /* The number of nodes in the pool */
+  uint8_t lt_maxplen;                 /* The length of an address in bits */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static struct lpm_trie_s g_ipv4_lpm;
+static struct lpm_node_s
+  g_ipv4_lpmnodes[LPM_NNODES(CONFIG_ROUTE_MAX_IPv4_RAMROUTES)];
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static struct lpm_trie_s g_ipv6_lpm;
+static struct lpm_node_s
+  g_ipv6_lpmnodes[LPM_NNODES(CONFIG_ROUTE_MAX_IPv6_RAMROUTES)];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_initialize
+ *
+ * Description:
+ *   Empty a trie and put all of its nodes on the free list.
+ *
+ ****************************************************************************/
+
+static void lpm_initialize(FAR struct lpm_trie_s *trie)
+{
+  unsigned int i;
+
+  trie->lt_root = NULL;
+  trie->lt_free = NULL;
+
+  for (i = 0; i < trie->lt_nnodes; i++)
+    {
+      trie->lt_nodes[i].ln_child[0] = trie->lt_free;
+      trie->lt_free                 = &trie->lt_nodes[i];
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_allocnode
+ *
+ * Description:
+ *   Allocate a node for the first 'plen' bits of 'key'.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_allocnode(FAR struct lpm_trie_s *trie,
+                                            FAR const uint8_t *key,
+                                            unsigned int plen,
+                                            FAR void *route)
+{
+  FAR struct lpm_node_s *node = trie->lt_free;
+  unsigned int nbytes = plen >> 3;
+
+  if (node != NULL)
+    {
+      trie->lt_free = node->ln_child[0];
+
+      memset(node, 0, sizeof(struct lpm_node_s));
+      memcpy(node->ln_key, key, nbytes);
+
+      if ((plen & 7) != 0)
+        {
+          node->ln_key[nbytes] = key[nbytes] & (0xff << (8 - (plen & 7)));
+        }
+
+      node->ln_plen  = plen;
+      node->ln_route = route;
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: lpm_freenode
+ ****************************************************************************/
+
+static void lpm_freenode(FAR struct lpm_trie_s *trie,
+                         FAR struct lpm_node_s *node)
+{
+  node->ln_child[0] = trie->lt_free;
+  trie->lt_free     = node;
+}
+
+/****************************************************************************
+ * Name: lpm_matchlen
+ *
+ * Description:
+ *   Return the number of leading bits that the prefix of 'node' and the
+ *   first 'plen' bits of 'key' have in common.
+ *
+ ****************************************************************************/
+
+static unsigned int lpm_matchlen(FAR const struct lpm_node_s *node,
+                                 FAR const uint8_t *key, unsigned int plen)
+{
+  unsigned int limit = node->ln_plen < plen ? node->ln_plen : plen;
+  unsigned int n;
+  uint8_t diff;
+
+  for (n = 0; n < limit; n += 8)
+    {
+      diff = node->ln_key[n >> 3] ^ key[n >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              n++;
+            }
+
+          break;
+        }
+    }
+
+  return n < limit ? n : limit;
+}
+
+/****************************************************************************
+ * Name: lpm_prefixlen
+ *
+ * Description:
+ *   Return the prefix length represented by a network mask, or -EINVAL if
+ *   the mask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int lpm_prefixlen(FAR const uint8_t *mask, unsigned int size)
+{
+  unsigned int plen = 0;
+  unsigned int i;
+  uint8_t byte;
+
+  for (i = 0; i < size && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < size)
+    {
+      for (byte = mask[i]; (byte & 0x80) != 0; byte <<= 1)
+        {
+          plen++;
+        }
+
+      if (byte != 0)
+        {
+          return -EINVAL;
+        }
+
+      for (i++; i < size; i++)
+        {
+          if (mask[i] != 0)
+            {
+              return -EINVAL;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add the route for the first 'plen' bits of 'key' to the trie.
+ *
+ ****************************************************************************/
+
+static int lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                      unsigned int plen, FAR void *route)
+{
+  FAR struct lpm_node_s **link = &trie->lt_root;
+  FAR struct lpm_node_s *branch;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *leaf;
+  unsigned int matchlen = 0;
+
+  /* Descend while the node is a proper prefix of the new one */
+
+  while ((node = *link) != NULL)
+    {
+      matchlen = lpm_matchlen(node, key, plen);
+      if (matchlen < node->ln_plen || node->ln_plen == plen)
+        {
+          break;
+        }
+
+      link = &node->ln_child[LPM_BIT(key, node->ln_plen)];
+    }
+
+  if (node != NULL && node->ln_plen == plen && matchlen == plen)
+    {
+      /* The prefix is already in the trie.  It may be a branching node. */
+
+      if (node->ln_route != NULL)
+        {
+          return -EEXIST;
+        }
+
+      node->ln_route = route;
+      return OK;
+    }
+
+  leaf = lpm_allocnode(trie, key, plen, route);
+  if (leaf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  if (node == NULL)
+    {
+      *link = leaf;
+    }
+  else if (matchlen == plen)
+    {
+      /* The new prefix is a prefix of the node:  Insert it above */
+
+      leaf->ln_child[LPM_BIT(node->ln_key, plen)] = node;
+      *link = leaf;
+    }
+  else
+    {
+      /* The prefixes diverge at bit 'matchlen':  Join them with a branching
+       * node.
+       */
+
+      branch = lpm_allocnode(trie, key, matchlen, NULL);
+      if (branch == NULL)
+        {
+          lpm_freenode(trie, leaf);
+          return -ENOMEM;
+        }
+
+      branch->ln_child[LPM_BIT(key, matchlen)]          = leaf;
+      branch->ln_child[LPM_BIT(node->ln_key, matchlen)] = node;
+      *link = branch;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_remove
+ *
+ * Description:
+ *   Remove the route for the first 'plen' bits of 'key' from the trie.
+ *
+ ****************************************************************************/
+
+static void lpm_remove(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                       unsigned int plen)
+{
+  FAR struct lpm_node_s **plink = NULL;
+  FAR struct lpm_node_s **link = &trie->lt_root;
+  FAR struct lpm_node_s *parent;
+  FAR struct lpm_node_s *node;
+
+  while ((node = *link) != NULL)
+    {
+      if (lpm_matchlen(node, key, plen) < node->ln_plen)
+        {
+          return;
+        }
+
+      if (node->ln_plen == plen)
+        {
+          break;
+        }
+
+      plink = link;
+      link  = &node->ln_child[LPM_BIT(key, node->ln_plen)];
+    }
+
+  if (node == NULL || node->ln_route == NULL)
+    {
+      return;
+    }
+
+  node->ln_route = NULL;
+
+  /* A node with two children remains as a branching node */
+
+  if (node->ln_child[0] != NULL && node->ln_child[1] != NULL)
+    {
+      return;
+    }
+
+  *link = node->ln_child[0] != NULL ? node->ln_child[0] : node->ln_child[1];
+  lpm_freenode(trie, node);
+
+  /* If a leaf was removed, its parent may be a branching node that is left
+   * with a single child.  Such a node is no longer needed.
+   */
+
+  if (*link == NULL && plink != NULL)
+    {
+      parent = *plink;
+      if (parent->ln_route == NULL)
+        {
+          *plink = parent->ln_child[0] != NULL ? parent->ln_child[0] :
+                                                 parent->ln_child[1];
+          lpm_freenode(trie, parent);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_match
+ *
+ * Description:
+ *   Return the node with the longest prefix shorter than 'limit' bits that
+ *   holds a route and matches the address 'key'.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_match(FAR struct lpm_trie_s *trie,
+                                        FAR const uint8_t *key,
+                                        unsigned int limit)
+{
+  FAR struct lpm_node_s *node = trie->lt_root;
+  FAR struct lpm_node_s *best = NULL;
+
+  while (node != NULL && node->ln_plen < limit)
+    {
+      if (lpm_matchlen(node, key, node->ln_plen) < node->ln_plen)
+        {
+          break;
+        }
+
+      if (node->ln_route != NULL)
+        {
+          best = node;
+        }
+
+      if (node->ln_plen >= trie->lt_maxplen)
+        {
+          break;
+        }
+
+      node = node->ln_child[LPM_BIT(key, node->ln_plen)];
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match index of the in-memory routing
+ *   tables.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void)
+{
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+  g_ipv4_lpm.lt_nodes   = g_ipv4_lpmnodes;
+  g_ipv4_lpm.lt_nnodes  = LPM_NNODES(CONFIG_ROUTE_MAX_IPv4_RAMROUTES);
+  g_ipv4_lpm.lt_maxplen = 8 * sizeof(in_addr_t);
+  lpm_initialize(&g_ipv4_lpm);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+  g_ipv6_lpm.lt_nodes   = g_ipv6_lpmnodes;
+  g_ipv6_lpm.lt_nnodes  = LPM_NNODES(CONFIG_ROUTE_MAX_IPv6_RAMROUTES);
+  g_ipv6_lpm.lt_maxplen = 8 * sizeof(net_ipv6addr_t);
+  lpm_initialize(&g_ipv6_lpm);
+#endif
+}
+
+/****************************************************************************
+ * Name: net_checklpm_ipv4 and net_checklpm_ipv6
+ *
+ * Description:
+ *   Check if a routing table entry can be added to the longest-prefix-match
+ *   index.
+ *
+ * Input Parameters:
+ *   route - The routing table entry
+ *
+ * Returned Value:
+ *   OK if the route can be indexed; -EINVAL if the netmask is not
+ *   contiguous.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_checklpm_ipv4(FAR const struct net_route_ipv4_s *route)
+{
+  int ret;
+
+  ret = lpm_prefixlen((FAR const uint8_t *)&route->netmask,
+                      sizeof(in_addr_t));
+  return ret < 0 ? ret : OK;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_checklpm_ipv6(FAR const struct net_route_ipv6_s *route)
+{
+  int ret;
+
+  ret = lpm_prefixlen((FAR const uint8_t *)route->netmask,
+                      sizeof(net_ipv6addr_t));
+  return ret < 0 ? ret : OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_addlpm_ipv4 and net_addlpm_ipv6
+ *
+ * Description:
+ *   Add an in-memory routing table entry to the longest-prefix-match index.
+ *
+ * Input Parameters:
+ *   route - The routing table entry
+ *
+ * Returned Value:
+ *   OK on success; Negated errno on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_addlpm_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)&route->netmask,
+                       sizeof(in_addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  return lpm_insert(&g_ipv4_lpm, (FAR const uint8_t *)&route->target, plen,
+                    route);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_addlpm_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)route->netmask,
+                       sizeof(net_ipv6addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  return lpm_insert(&g_ipv6_lpm, (FAR const uint8_t *)route->target, plen,
+                    route);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_dellpm_ipv4 and net_dellpm_ipv6
+ *
+ * Description:
+ *   Remove an in-memory routing table entry from the longest-prefix-match
+ *   index.
+ *
+ * Input Parameters:
+ *   route - The routing table entry
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_dellpm_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)&route->netmask,
+                       sizeof(in_addr_t));
+  if (plen >= 0)
+    {
+      lpm_remove(&g_ipv4_lpm, (FAR const uint8_t *)&route->target, plen);
+    }
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_dellpm_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)route->netmask,
+                       sizeof(net_ipv6addr_t));
+  if (plen >= 0)
+    {
+      lpm_remove(&g_ipv6_lpm, (FAR const uint8_t *)route->target, plen);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: net_clearlpm_ipv4 and net_clearlpm_ipv6
+ *
+ * Description:
+ *   Remove all routes from the longest-prefix-match index.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_clearlpm_ipv4(void)
+{
+  lpm_initialize(&g_ipv4_lpm);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_clearlpm_ipv6(void)
+{
+  lpm_initialize(&g_ipv6_lpm);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lookuproute_ipv4 and net_lookuproute_ipv6
+ *
+ * Description:
+ *   Visit the routes whose target network contains the address, in order of
+ *   decreasing prefix length.  Each step costs at most one walk down the
+ *   trie, i.e. time proportional to the length of the address and not to
+ *   the number of routes.
+ *
+ * Input Parameters:
+ *   target  - The address to be routed
+ *   handler - Will be called for each matching route.  The handler must not
+ *             modify the routing table.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) if no handler terminated the search; otherwise the non-zero
+ *   value returned by the handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_lookuproute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                         FAR void *arg)
+{
+  FAR struct lpm_node_s *node;
+  unsigned int limit = 8 * sizeof(in_addr_t) + 1;
+  int ret = 0;
+
+  net_lock();
+
+  while (ret == 0 &&
+         (node = lpm_match(&g_ipv4_lpm, (FAR const uint8_t *)&target,
+                           limit)) != NULL)
+    {
+      ret   = handler((FAR struct net_route_ipv4_s *)node->ln_route, arg);
+      limit = node->ln_plen;
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_lookuproute_ipv6(FAR const net_ipv6addr_t target,
+                         route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR struct lpm_node_s *node;
+  unsigned int limit = 8 * sizeof(net_ipv6addr_t) + 1;
+  int ret = 0;
+
+  net_lock();
+
+  while (ret == 0 &&
+         (node = lpm_match(&g_ipv6_lpm, (FAR const uint8_t *)target,
+                           limit)) != NULL)
+    {
+      ret   = handler((FAR struct net_route_ipv6_s *)node->ln_route, arg);
+      limit = node->ln_plen;
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_LPM */
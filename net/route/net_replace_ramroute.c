@@ -0,0 +1,222 @@
+/****************************************************************************
+ * net/route/net_replace_ramroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/lpmroute.h"
+#include "route/route.h"
+#include "ipforward/ipforward.h"
+
+#if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_replaceroutes_ipv4 and net_replaceroutes_ipv6
+ *
+ * Description:
+ *   Atomically replace the entire content of the in-memory routing table.
+ *   The network does not see any intermediate state:  Either all of the new
+ *   routes are installed or, on failure, the routing table is unchanged.
+ *
+ *   If the table holds several routes for the same target network and
+ *   netmask, only the first is used.  With CONFIG_ROUTE_LPM the others are
+ *   not added to the table at all.
+ *
+ * Input Parameters:
+ *   routes  - The new routes
+ *   nroutes - The number of entries in 'routes'.  Zero clears the table.
+ *
+ * Returned Value:
+ *   OK on success; Negated errno on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_replaceroutes_ipv4(FAR const struct net_route_ipv4_s *routes,
+                           unsigned int nroutes)
+{
+  FAR struct net_route_ipv4_entry_s *entry;
+  FAR struct net_route_ipv4_s *route;
+  unsigned int i;
+
+  DEBUGASSERT(routes != NULL || nroutes == 0);
+
+  /* Everything that could fail is checked before the table is modified */
+
+  if (nroutes > CONFIG_ROUTE_MAX_IPv4_RAMROUTES)
+    {
+      return -ENOMEM;
+    }
+
+#ifdef CONFIG_ROUTE_LPM
+  for (i = 0; i < nroutes; i++)
+    {
+      int ret = net_checklpm_ipv4(&routes[i]);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  /* Get exclusive address to the networking data structures for the whole
+   * replacement.
+   */
+
+  net_lock();
+
+  /* Release all of the current routes */
+
+  while ((entry = ramroute_ipv4_remfirst(&g_ipv4_routes)) != NULL)
+    {
+      net_freeroute_ipv4(&entry->entry);
+    }
+
+#ifdef CONFIG_ROUTE_LPM
+  net_clearlpm_ipv4();
+#endif
+
+  /* Then add the new routes.  The allocations cannot fail because all of
+   * the entries were just freed.
+   */
+
+  for (i = 0; i < nroutes; i++)
+    {
+      route = net_allocroute_ipv4();
+      DEBUGASSERT(route != NULL);
+
+      memcpy(route, &routes[i], sizeof(struct net_route_ipv4_s));
+
+#ifdef CONFIG_ROUTE_LPM
+      if (net_addlpm_ipv4(route) < 0)
+        {
+          /* A duplicate of an earlier route */
+
+          net_freeroute_ipv4(route);
+          continue;
+        }
+#endif
+
+      ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
+                            &g_ipv4_routes);
+    }
+
+  net_unlock();
+
+  ipfwd_flowflush();
+  return OK;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_replaceroutes_ipv6(FAR const struct net_route_ipv6_s *routes,
+                           unsigned int nroutes)
+{
+  FAR struct net_route_ipv6_entry_s *entry;
+  FAR struct net_route_ipv6_s *route;
+  unsigned int i;
+
+  DEBUGASSERT(routes != NULL || nroutes == 0);
+
+  /* Everything that could fail is checked before the table is modified */
+
+  if (nroutes > CONFIG_ROUTE_MAX_IPv6_RAMROUTES)
+    {
+      return -ENOMEM;
+    }
+
+#ifdef CONFIG_ROUTE_LPM
+  for (i = 0; i < nroutes; i++)
+    {
+      int ret = net_checklpm_ipv6(&routes[i]);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
+  /* Get exclusive address to the networking data structures for the whole
+   * replacement.
+   */
+
+  net_lock();
+
+  /* Release all of the current routes */
+
+  while ((entry = ramroute_ipv6_remfirst(&g_ipv6_routes)) != NULL)
+    {
+      net_freeroute_ipv6(&entry->entry);
+    }
+
+#ifdef CONFIG_ROUTE_LPM
+  net_clearlpm_ipv6();
+#endif
+
+  /* Then add the new routes.  The allocations cannot fail because all of
+   * the entries were just freed.
+   */
+
+  for (i = 0; i < nroutes; i++)
+    {
+      route = net_allocroute_ipv6();
+      DEBUGASSERT(route != NULL);
+
+      memcpy(route, &routes[i], sizeof(struct net_route_ipv6_s));
+
+#ifdef CONFIG_ROUTE_LPM
+      if (net_addlpm_ipv6(route) < 0)
+        {
+          /* A duplicate of an earlier route */
+
+          net_freeroute_ipv6(route);
+          continue;
+        }
+#endif
+
+      ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
+                            &g_ipv6_routes);
+    }
+
+  net_unlock();
+
+  ipfwd_flowflush();
+  return OK;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_IPv4_RAMROUTE || CONFIG_ROUTE_IPv6_RAMROUTE */
@@ -128,8 +128,8 @@ static int net_ipv4_devmatch(FAR struct net_route_ipv4_s *route,
   /* To match, (1) the masked target addresses must be the same, and (2) the
    * router address must like on the network provided by the device.
    *
-   * In the event of multiple matches, only the first is returned.  There
-   * not (yet) any concept for the precedence of networks.
+   * In the event of multiple matches, only the first is returned.  With
+   * CONFIG_ROUTE_LPM, the most specific network is visited first.
    */
 
   if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask) &&
@@ -177,8 +177,8 @@ static int net_ipv6_devmatch(FAR struct net_route_ipv6_s *route,
   /* To match, (1) the masked target addresses must be the same, and (2) the
    * router address must like on the network provided by the device.
    *
-   * In the event of multiple matches, only the first is returned.  There
-   * not (yet) any concept for the precedence of networks.
+   * In the event of multiple matches, only the first is returned.  With
+   * CONFIG_ROUTE_LPM, the most specific network is visited first.
    */
 
   if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask) &&
@@ -250,7 +250,7 @@ void netdev_ipv4_router(FAR struct net_driver_s *dev, in_addr_t target,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv4(net_ipv4_devmatch, &match);
+      ret = net_lookuproute_ipv4(target, net_ipv4_devmatch, &match);
     }
 
   /* Did we find a route? */
@@ -329,7 +329,7 @@ void netdev_ipv6_router(FAR struct net_driver_s *dev,
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv6(net_ipv6_devmatch, &match);
+      ret = net_lookuproute_ipv6(target, net_ipv6_devmatch, &match);
     }
 
   /* Did we find a route? */
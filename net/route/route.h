@@ -162,6 +162,33 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask);
 int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask);
 #endif
 
+/****************************************************************************
+ * Name: net_replaceroutes_ipv4 and net_replaceroutes_ipv6
+ *
+ * Description:
+ *   Atomically replace the entire content of the in-memory routing table.
+ *   The network does not see any intermediate state:  Either all of the new
+ *   routes are installed or, on failure, the routing table is unchanged.
+ *
+ * Input Parameters:
+ *   routes  - The new routes
+ *   nroutes - The number of entries in 'routes'.  Zero clears the table.
+ *
+ * Returned Value:
+ *   OK on success; Negated errno on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_replaceroutes_ipv4(FAR const struct net_route_ipv4_s *routes,
+                           unsigned int nroutes);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_replaceroutes_ipv6(FAR const struct net_route_ipv6_s *routes,
+                           unsigned int nroutes);
+#endif
+
 /****************************************************************************
  * Name: net_ipv4_router
  *
@@ -284,6 +311,43 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg);
 int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: net_lookuproute_ipv4/net_lookuproute_ipv6
+ *
+ * Description:
+ *   Traverse the routes of the routing table that may forward to the target
+ *   address.  If the in-memory routing table is indexed by the longest-
+ *   prefix-match trie, only the routes whose target network contains the
+ *   address are visited, in order of decreasing prefix length.  Otherwise,
+ *   this is the same as net_foreachroute_ipv4/6().
+ *
+ * Input Parameters:
+ *   target  - The address to be routed
+ *   handler - Will be called for each candidate route.  The handler must
+ *             not modify the routing table.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   The same as net_foreachroute_ipv4/6().
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_ROUTE_LPM) && \
+    defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+int net_lookuproute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                         FAR void *arg);
+#elif defined(CONFIG_NET_IPv4)
+#  define net_lookuproute_ipv4(t,h,a) net_foreachroute_ipv4(h,a)
+#endif
+
+#if defined(CONFIG_NET_IPv6) && defined(CONFIG_ROUTE_LPM) && \
+    defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+int net_lookuproute_ipv6(FAR const net_ipv6addr_t target,
+                         route_handler_ipv6_t handler, FAR void *arg);
+#elif defined(CONFIG_NET_IPv6)
+#  define net_lookuproute_ipv6(t,h,a) net_foreachroute_ipv6(h,a)
+#endif
+
 /****************************************************************************
  * Name: net_ipv4_dumproute and net_ipv6_dumproute
  *
@@ -53,6 +53,7 @@
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 #include "can/can.h"
+#include "pkt/pkt.h"
 
 /****************************************************************************
  * Private Functions
@@ -292,6 +293,28 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_TCP_REUSEPORT
+      case SO_REUSEPORT:
+        {
+          FAR struct tcp_conn_s *conn;
+
+          if ((psock->s_domain != PF_INET && psock->s_domain != PF_INET6) ||
+              psock->s_type != SOCK_STREAM)
+            {
+              return -ENOPROTOOPT;
+            }
+
+          if (*value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          conn = (FAR struct tcp_conn_s *)psock->s_conn;
+          *(FAR int *)value = (int)conn->reuseport;
+        }
+        break;
+#endif
+
       /* The following are not yet implemented
        * (return values other than {0,1})
        */
@@ -391,6 +414,12 @@ int psock_getsockopt(FAR struct socket *psock, int level, int option,
 #endif
        break;
 
+#ifdef CONFIG_NET_PKT_MMAP
+      case SOL_PACKET: /* Packet socket options (see include/netpacket/packet.h) */
+       ret = pkt_getsockopt(psock, option, value, value_len);
+       break;
+#endif
+
       /* These levels are defined in sys/socket.h, but are not yet
        * implemented.
        */
@@ -0,0 +1,117 @@
+/****************************************************************************
+ * net/socket/net_recvrelease.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvrelease
+ *
+ * Description:
+ *   Return the I/O buffer chain lent by a MSG_ZEROCOPY receive operation.
+ *
+ * Input Parameters:
+ *   psock - The socket that received the chain
+ *   iob   - The I/O buffer chain to release (may be NULL)
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int psock_recvrelease(FAR struct socket *psock, FAR struct iob_s *iob)
+{
+  enum iob_user_e producerid;
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  /* The chain is still accounted to the read-ahead buffering of the
+   * protocol that received it.
+   */
+
+  switch (psock->s_type)
+    {
+#ifdef CONFIG_NET_TCP
+      case SOCK_STREAM:
+        producerid = IOBUSER_NET_TCP_READAHEAD;
+        break;
+#endif
+
+#ifdef CONFIG_NET_UDP
+      case SOCK_DGRAM:
+        producerid = IOBUSER_NET_UDP_READAHEAD;
+        break;
+#endif
+
+      default:
+        return -EOPNOTSUPP;
+    }
+
+  if (iob != NULL)
+    {
+      iob_free_chain(iob, producerid);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: net_recvrelease
+ *
+ * Description:
+ *   Return the I/O buffer chain lent by a MSG_ZEROCOPY receive operation.
+ *
+ * Input Parameters:
+ *   sockfd - The socket descriptor that received the chain
+ *   iob    - The I/O buffer chain to release (may be NULL)
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int net_recvrelease(int sockfd, FAR struct iob_s *iob)
+{
+  return psock_recvrelease(sockfd_socket(sockfd), iob);
+}
+
+#endif /* CONFIG_NET_RECV_ZEROCOPY */
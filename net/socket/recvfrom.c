@@ -108,6 +108,29 @@ ssize_t psock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       return -EBADF;
     }
 
+  /* A zero-copy receive returns the I/O buffer chain holding the data in
+   * a buffer for a single pointer.  Only TCP and UDP sockets lend their
+   * read-ahead buffers.
+   */
+
+  if ((flags & MSG_ZEROCOPY) != 0)
+    {
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+      if ((psock->s_domain != PF_INET && psock->s_domain != PF_INET6) ||
+          (psock->s_type != SOCK_STREAM && psock->s_type != SOCK_DGRAM))
+        {
+          return -EOPNOTSUPP;
+        }
+
+      if (len != sizeof(FAR struct iob_s *))
+        {
+          return -EINVAL;
+        }
+#else
+      return -EOPNOTSUPP;
+#endif
+    }
+
   /* Let logic specific to this address family handle the recvfrom()
    * operation.
    */
@@ -89,9 +89,11 @@ ssize_t psock_send(FAR struct socket *psock, FAR const void *buf, size_t len,
 {
   ssize_t ret;
 
-  /* Verify that non-NULL pointers were passed */
+  /* Verify that non-NULL pointers were passed.  A send without data may
+   * have no buffer; packet sockets use it to flush their transmit ring.
+   */
 
-  if (buf == NULL)
+  if (buf == NULL && len > 0)
     {
       return -EINVAL;
     }
@@ -125,9 +125,11 @@ ssize_t psock_sendto(FAR struct socket *psock, FAR const void *buf,
 {
   ssize_t nsent;
 
-  /* Verify that non-NULL pointers were passed */
+  /* Verify that non-NULL pointers were passed.  A send without data may
+   * have no buffer; packet sockets use it to flush their transmit ring.
+   */
 
-  if (buf == NULL)
+  if (buf == NULL && len > 0)
     {
       return -EINVAL;
     }
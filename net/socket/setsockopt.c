@@ -58,6 +58,7 @@
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 #include "can/can.h"
+#include "pkt/pkt.h"
 
 /****************************************************************************
  * Public Functions
@@ -303,6 +304,35 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
         break;
 #endif
+
+#ifdef CONFIG_NET_TCP_REUSEPORT
+      case SO_REUSEPORT:  /* Allow several sockets to bind the same port */
+        {
+          FAR struct tcp_conn_s *conn;
+
+          /* The option is only supported for TCP sockets */
+
+          if ((psock->s_domain != PF_INET && psock->s_domain != PF_INET6) ||
+              psock->s_type != SOCK_STREAM)
+            {
+              return -ENOPROTOOPT;
+            }
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          net_lock();
+
+          conn = (FAR struct tcp_conn_s *)psock->s_conn;
+          conn->reuseport = (*(FAR int *)value != 0);
+
+          net_unlock();
+        }
+        break;
+#endif
+
       /* The following are not yet implemented */
 
       case SO_RCVBUF:     /* Sets receive buffer size */
@@ -429,6 +459,12 @@ int psock_setsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_PKT_MMAP
+      case SOL_PACKET:    /* Packet socket options (see include/netpacket/packet.h) */
+        ret = pkt_setsockopt(psock, option, value, value_len);
+        break;
+#endif
+
       default:         /* The provided level is invalid */
         ret = -EINVAL;
         break;
@@ -262,6 +262,10 @@ struct tcp_conn_s
   uint8_t    keepretries; /* Number of retries attempted */
 #endif
 
+#ifdef CONFIG_NET_TCP_REUSEPORT
+  bool       reuseport;   /* True: SO_REUSEPORT enabled; false: disabled */
+#endif
+
   /* connevents is a list of callbacks for each socket the uses this
    * connection (there can be more that one in the event that the the socket
    * was dup'ed).  It is used with the network monitor to handle
@@ -845,6 +849,21 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno, uint8_t domain);
 FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno);
 #endif
 
+/****************************************************************************
+ * Name: tcp_connlistener
+ *
+ * Description:
+ *   Return the listener that owns a connection received on one of its
+ *   ports (if any).  When several sockets listen on the port with
+ *   SO_REUSEPORT, the same listener is always selected for the connection.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+FAR struct tcp_conn_s *tcp_connlistener(FAR struct tcp_conn_s *conn);
+
 /****************************************************************************
  * Name: tcp_unlisten
  *
@@ -925,6 +944,34 @@ int tcp_accept_connection(FAR struct net_driver_s *dev,
 void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
               uint16_t flags, uint16_t len);
 
+/****************************************************************************
+ * Name: tcp_sndmss
+ *
+ * Description:
+ *   Return the maximum amount of payload that may be placed in one
+ *   outgoing segment on the connection.  This is normally the MSS, but if
+ *   the device supports generic segmentation offload, it is the largest
+ *   multiple of the MSS that fits into the device's d_gsosize.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information
+ *   dev  - The device driver structure to use in the send operation
+ *
+ * Returned Value:
+ *   The maximum payload size in bytes.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_GSO
+uint16_t tcp_sndmss(FAR struct tcp_conn_s *conn,
+                    FAR struct net_driver_s *dev);
+#else
+#  define tcp_sndmss(conn,dev) ((conn)->mss)
+#endif
+
 /****************************************************************************
  * Name: tcp_sendfile
  *
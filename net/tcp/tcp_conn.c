@@ -74,6 +74,12 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_TCP_REUSEPORT
+#  define TCP_REUSEPORT(conn) ((conn)->reuseport)
+#else
+#  define TCP_REUSEPORT(conn) false
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,6 +100,29 @@ static dq_queue_t g_active_tcp_connections;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_shareport
+ *
+ * Description:
+ *   Return true if a connection bound with the same local port does not
+ *   prevent a new SO_REUSEPORT binding of the port.  That is the case for
+ *   the other SO_REUSEPORT sockets and for the connections that were
+ *   accepted on the port.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_REUSEPORT
+static inline bool tcp_shareport(FAR struct tcp_conn_s *conn,
+                                 bool reuseport)
+{
+  return reuseport &&
+         (conn->reuseport ||
+          (conn->tcpstateflags & TCP_STATE_MASK) != TCP_ALLOCATED);
+}
+#else
+#  define tcp_shareport(c,r) false
+#endif
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -108,7 +137,8 @@ static dq_queue_t g_active_tcp_connections;
 
 #ifdef CONFIG_NET_IPv4
 static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
-                                                       uint16_t portno)
+                                                       uint16_t portno,
+                                                       bool reuseport)
 {
   FAR struct tcp_conn_s *conn;
   int i;
@@ -123,7 +153,8 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
        * matches the requested port number.
        */
 
-      if (conn->tcpstateflags != TCP_CLOSED && conn->lport == portno)
+      if (conn->tcpstateflags != TCP_CLOSED && conn->lport == portno &&
+          !tcp_shareport(conn, reuseport))
         {
           /* If there are multiple interface devices, then the local IP
            * address of the connection must also match.  INADDR_ANY is a
@@ -159,7 +190,8 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
 
 #ifdef CONFIG_NET_IPv6
 static inline FAR struct tcp_conn_s *
-tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
+tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno,
+                  bool reuseport)
 {
   FAR struct tcp_conn_s *conn;
   int i;
@@ -174,7 +206,8 @@ tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
        * matches the requested port number.
        */
 
-      if (conn->tcpstateflags != TCP_CLOSED && conn->lport == portno)
+      if (conn->tcpstateflags != TCP_CLOSED && conn->lport == portno &&
+          !tcp_shareport(conn, reuseport))
         {
           /* If there are multiple interface devices, then the local IP
            * address of the connection must also match.  The IPv6
@@ -210,14 +243,14 @@ tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 
 static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
-               uint16_t portno)
+               uint16_t portno, bool reuseport)
 {
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   if (domain == PF_INET)
 #endif
     {
-      return tcp_ipv4_listener(ipaddr->ipv4, portno);
+      return tcp_ipv4_listener(ipaddr->ipv4, portno, reuseport);
     }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -226,7 +259,7 @@ static FAR struct tcp_conn_s *
   else
 #endif
     {
-      return tcp_ipv6_listener(ipaddr->ipv6, portno);
+      return tcp_ipv6_listener(ipaddr->ipv6, portno, reuseport);
     }
 #endif /* CONFIG_NET_IPv6 */
 }
@@ -242,6 +275,8 @@ static FAR struct tcp_conn_s *
  * Input Parameters:
  *   portno -- the selected port number in host order. Zero means no port
  *     selected.
+ *   reuseport -- True if the port may be shared with other SO_REUSEPORT
+ *     sockets.
  *
  * Returned Value:
  *   Selected or verified port number in host order on success, a negated
@@ -258,7 +293,7 @@ static FAR struct tcp_conn_s *
  ****************************************************************************/
 
 static int tcp_selectport(uint8_t domain, FAR const union ip_addr_u *ipaddr,
-                          uint16_t portno)
+                          uint16_t portno, bool reuseport)
 {
   static uint16_t g_last_tcp_port;
 
@@ -297,7 +332,7 @@ static int tcp_selectport(uint8_t domain, FAR const union ip_addr_u *ipaddr,
               g_last_tcp_port = 4096;
             }
         }
-      while (tcp_listener(domain, ipaddr, htons(g_last_tcp_port)));
+      while (tcp_listener(domain, ipaddr, htons(g_last_tcp_port), false));
     }
   else
     {
@@ -305,7 +340,7 @@ static int tcp_selectport(uint8_t domain, FAR const union ip_addr_u *ipaddr,
        * connection is using this local port.
        */
 
-      if (tcp_listener(domain, ipaddr, portno))
+      if (tcp_listener(domain, ipaddr, portno, reuseport))
         {
           /* It is in use... return EADDRINUSE */
 
@@ -482,7 +517,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET,
                        (FAR const union ip_addr_u *)&addr->sin_addr.s_addr,
-                        ntohs(addr->sin_port));
+                        ntohs(addr->sin_port), TCP_REUSEPORT(conn));
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -549,7 +584,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET6,
                 (FAR const union ip_addr_u *)addr->sin6_addr.in6_u.u6_addr16,
-                ntohs(addr->sin6_port));
+                ntohs(addr->sin6_port), TCP_REUSEPORT(conn));
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -1144,7 +1179,8 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
       port = tcp_selectport(PF_INET,
                             (FAR const union ip_addr_u *)&conn->u.ipv4.laddr,
-                            ntohs(conn->lport));
+                            ntohs(conn->lport),
+                            TCP_REUSEPORT(conn));
     }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -1159,7 +1195,8 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
       port = tcp_selectport(PF_INET6,
                             (FAR const union ip_addr_u *)conn->u.ipv6.laddr,
-                            ntohs(conn->lport));
+                            ntohs(conn->lport),
+                            TCP_REUSEPORT(conn));
     }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -111,6 +111,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   g_netstats.tcp.recv++;
 #endif
 
+#ifdef CONFIG_NET_LATENCY
+  net_latency_record(NET_LATENCY_L4IN, dev->d_rxstamp);
+#endif
+
   /* Get a pointer to the TCP header.  The TCP header lies just after the
    * the link layer header and the IP header.
    */
@@ -131,11 +135,13 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   hdrlen = tcpiplen + NET_LL_HDRLEN(dev);
 
-  /* Start of TCP input header processing code. */
+  /* Start of TCP input header processing code.  Compute and check the TCP
+   * checksum unless the device has already verified it.
+   */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!IFF_IS_NOCHKSUM(dev->d_flags) && tcp_chksum(dev) != 0xffff)
     {
-      /* Compute and check the TCP checksum. */
+      /* The TCP checksum is bad. */
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.tcp.drop++;
@@ -350,11 +356,7 @@ found:
 
           /* Notify the listener for the connection of the reset event */
 
-#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-          listener = tcp_findlistener(conn->lport, domain);
-#else
-          listener = tcp_findlistener(conn->lport);
-#endif
+          listener = tcp_connlistener(conn);
 
           /* We must free this TCP connection structure; this connection
            * will never be established.  There should only be one reference
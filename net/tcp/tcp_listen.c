@@ -46,6 +46,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -111,10 +112,124 @@ FAR struct tcp_conn_s *tcp_findlistener(uint16_t portno)
   return NULL;
 }
 
+/****************************************************************************
+ * Name: tcp_reuseport_hash
+ *
+ * Description:
+ *   Hash the local and remote address and port of a connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_REUSEPORT
+static uint32_t tcp_reuseport_hash(FAR struct tcp_conn_s *conn)
+{
+  uint32_t hash = ((uint32_t)conn->rport << 16) | conn->lport;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      hash ^= conn->u.ipv4.raddr;
+      hash ^= (conn->u.ipv4.laddr << 16) | (conn->u.ipv4.laddr >> 16);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      int i;
+
+      for (i = 0; i < 8; i++)
+        {
+          hash ^= (uint32_t)conn->u.ipv6.raddr[i] << ((i & 1) << 4);
+          hash ^= (uint32_t)conn->u.ipv6.laddr[i] << ((~i & 1) << 4);
+        }
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  /* Mix the bits so that all of them take part in the selection */
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+  return hash;
+}
+#endif /* CONFIG_NET_TCP_REUSEPORT */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_connlistener
+ *
+ * Description:
+ *   Return the listener that owns a connection received on one of its
+ *   ports (if any).  When several sockets listen on the port with
+ *   SO_REUSEPORT, the listener is selected by a hash of the addresses and
+ *   ports of the connection so that the same listener is always found.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+FAR struct tcp_conn_s *tcp_connlistener(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_REUSEPORT
+  FAR struct tcp_conn_s *listener;
+  uint32_t nlisteners = 0;
+  uint32_t select;
+  int ndx;
+
+  /* Count the listeners sharing the port */
+
+  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+    {
+      listener = tcp_listenports[ndx];
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+      if (listener && listener->lport == conn->lport &&
+          listener->domain == conn->domain)
+#else
+      if (listener && listener->lport == conn->lport)
+#endif
+        {
+          nlisteners++;
+        }
+    }
+
+  if (nlisteners > 1)
+    {
+      /* Pick one of them by the hash of the connection */
+
+      select = tcp_reuseport_hash(conn) % nlisteners;
+
+      for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+        {
+          listener = tcp_listenports[ndx];
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+          if (listener && listener->lport == conn->lport &&
+              listener->domain == conn->domain && select-- == 0)
+#else
+          if (listener && listener->lport == conn->lport && select-- == 0)
+#endif
+            {
+              return listener;
+            }
+        }
+    }
+#endif /* CONFIG_NET_TCP_REUSEPORT */
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  return tcp_findlistener(conn->lport, conn->domain);
+#else
+  return tcp_findlistener(conn->lport);
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_listen_initialize
  *
@@ -180,6 +295,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+  FAR struct tcp_conn_s *listener;
   int ndx;
   int ret;
 
@@ -189,12 +305,20 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
   net_lock();
 
-  /* First, check if there is already a socket listening on this port */
+  /* First, check if there is already a socket listening on this port.
+   * Sockets with SO_REUSEPORT may share the port, the bind() logic
+   * assures that either all or none of the listeners have the option.
+   */
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  if (tcp_islistener(conn->lport, conn->domain))
+  listener = tcp_findlistener(conn->lport, conn->domain);
 #else
-  if (tcp_islistener(conn->lport))
+  listener = tcp_findlistener(conn->lport);
+#endif
+#ifdef CONFIG_NET_TCP_REUSEPORT
+  if (listener != NULL && !(listener->reuseport && conn->reuseport))
+#else
+  if (listener != NULL)
 #endif
     {
       /* Yes, then we must refuse this request */
@@ -275,11 +399,9 @@ int tcp_accept_connection(FAR struct net_driver_s *dev,
    * the connection.
    */
 
-#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  listener = tcp_findlistener(portno, conn->domain);
-#else
-  listener = tcp_findlistener(portno);
-#endif
+  DEBUGASSERT(conn->lport == portno);
+
+  listener = tcp_connlistener(conn);
   if (listener != NULL)
     {
       /* Yes, there is a listener.  Is it accepting connections now? */
@@ -36,6 +36,7 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/tcp.h>
+#include <nuttx/net/netstats.h>
 
 #include "netdev/netdev.h"
 #include "devif/devif.h"
@@ -67,6 +68,12 @@ struct tcp_recvfrom_s
   FAR socklen_t           *ir_fromlen;   /* Number of bytes allocated for address of sender */
   ssize_t                  ir_recvlen;   /* The received length */
   int                      ir_result;    /* Success:OK, failure:negated errno */
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  bool                     ir_zerocopy;  /* Leave new data to the read-ahead buffers */
+#endif
+#ifdef CONFIG_NET_LATENCY
+  uint32_t                 ir_rxstamp;   /* Time stamp of the data that woke up the receiver */
+#endif
 };
 
 /****************************************************************************
@@ -412,6 +419,25 @@ static uint16_t tcp_eventhandler(FAR struct net_driver_s *dev,
     {
       /* If new data is available, then complete the read action. */
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+      if ((flags & TCP_NEWDATA) != 0 && pstate->ir_zerocopy)
+        {
+          /* Leave TCP_NEWDATA set so that the data is put in the read-ahead
+           * buffers, from where the waiting thread will take it.
+           */
+
+          pstate->ir_cb->flags   = 0;
+          pstate->ir_cb->priv    = NULL;
+          pstate->ir_cb->event   = NULL;
+
+#ifdef CONFIG_NET_LATENCY
+          pstate->ir_rxstamp = dev->d_rxstamp;
+#endif
+
+          nxsem_post(&pstate->ir_sem);
+        }
+      else
+#endif
       if ((flags & TCP_NEWDATA) != 0)
         {
           /* Copy the data from the packet (saving any unused bytes from the
@@ -449,6 +475,10 @@ static uint16_t tcp_eventhandler(FAR struct net_driver_s *dev,
               pstate->ir_cb->priv    = NULL;
               pstate->ir_cb->event   = NULL;
 
+#ifdef CONFIG_NET_LATENCY
+              pstate->ir_rxstamp = dev->d_rxstamp;
+#endif
+
               /* Wake up the waiting thread, returning the number of bytes
                * actually read.
                */
@@ -606,6 +636,115 @@ static ssize_t tcp_recvfrom_result(int result, struct tcp_recvfrom_s *pstate)
   return pstate->ir_recvlen;
 }
 
+/****************************************************************************
+ * Name: tcp_recvfrom_zerocopy
+ *
+ * Description:
+ *   Perform a MSG_ZEROCOPY receive.  The I/O buffer chain at the head of
+ *   the read-ahead queue is removed and lent to the caller as a whole.  If
+ *   the queue is empty, wait until new data has been buffered there.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_STREAM socket
+ *   iobp     Location to return the I/O buffer chain
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes in the lent I/O buffer chain.
+ *   Zero is returned if the peer has closed the connection.  On error,
+ *   -errno is returned.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+static ssize_t tcp_recvfrom_zerocopy(FAR struct socket *psock,
+                                     FAR struct iob_s **iobp, int flags)
+{
+  FAR struct tcp_conn_s *conn = (FAR struct tcp_conn_s *)psock->s_conn;
+  struct tcp_recvfrom_s state;
+  FAR struct iob_s *iob;
+  ssize_t ret;
+
+  tcp_recvfrom_initialize(psock, NULL, 0, NULL, NULL, &state);
+  state.ir_zerocopy = true;
+
+  for (; ; )
+    {
+      /* NOTE that there may be read-ahead data to be retrieved even after
+       * the socket has been disconnected.
+       */
+
+      iob = iob_remove_queue(&conn->readahead);
+      if (iob != NULL)
+        {
+          DEBUGASSERT(iob->io_pktlen > 0);
+          ninfo("Lent %d bytes\n", iob->io_pktlen);
+
+          *iobp = iob;
+          ret   = iob->io_pktlen;
+          break;
+        }
+
+      if (!_SS_ISCONNECTED(psock->s_flags))
+        {
+          ret = _SS_ISCLOSED(psock->s_flags) ? 0 : -ENOTCONN;
+          break;
+        }
+
+      if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      /* Wait for new data to be buffered or for the connection to be
+       * lost.
+       */
+
+      state.ir_cb = tcp_callback_alloc(conn);
+      if (state.ir_cb == NULL)
+        {
+          ret = -EBUSY;
+          break;
+        }
+
+      state.ir_cb->flags   = (TCP_NEWDATA | TCP_DISCONN_EVENTS);
+      state.ir_cb->priv    = (FAR void *)&state;
+      state.ir_cb->event   = tcp_eventhandler;
+
+      ret = net_timedwait(&state.ir_sem, _SO_TIMEOUT(psock->s_rcvtimeo));
+      if (ret == -ETIMEDOUT)
+        {
+          ret = -EAGAIN;
+        }
+
+#ifdef CONFIG_NET_LATENCY
+      if (ret >= 0)
+        {
+          net_latency_record(NET_LATENCY_WAKEUP, state.ir_rxstamp);
+        }
+#endif
+
+      tcp_callback_free(conn, state.ir_cb);
+
+      if (ret < 0)
+        {
+          break;
+        }
+
+      /* A lost connection is reported above once the read-ahead data is
+       * exhausted.
+       */
+    }
+
+  tcp_recvfrom_uninitialize(&state);
+  return ret;
+}
+#endif /* CONFIG_NET_RECV_ZEROCOPY */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -639,6 +778,18 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR void *buf,
   struct tcp_recvfrom_s state;
   int               ret;
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  if ((flags & MSG_ZEROCOPY) != 0)
+    {
+      ssize_t nrecvd;
+
+      net_lock();
+      nrecvd = tcp_recvfrom_zerocopy(psock, (FAR struct iob_s **)buf, flags);
+      net_unlock();
+      return nrecvd;
+    }
+#endif
+
   /* Initialize the state structure.  This is done with the network locked
    * because we don't want anything to happen until we are ready.
    */
@@ -749,6 +900,13 @@ ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR void *buf,
               ret = -EAGAIN;
             }
 
+#ifdef CONFIG_NET_LATENCY
+          if (ret >= 0)
+            {
+              net_latency_record(NET_LATENCY_WAKEUP, state.ir_rxstamp);
+            }
+#endif
+
           /* Make sure that no further events are processed */
 
           tcp_callback_free(conn, state.ir_cb);
@@ -153,7 +153,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]      = 0;
 
   tcp->tcpchksum    = 0;
-  tcp->tcpchksum    = ~tcp_ipv4_chksum(dev);
+  if (!IFF_IS_NOCHKSUM(dev->d_flags))
+    {
+      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+    }
 
   /* Finish initializing the IP header and calculate the IP checksum */
 
@@ -168,7 +171,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   /* Calculate IP checksum. */
 
   ipv4->ipchksum    = 0;
-  ipv4->ipchksum    = ~ipv4_chksum(dev);
+  if (!IFF_IS_NOCHKSUM(dev->d_flags))
+    {
+      ipv4->ipchksum = ~ipv4_chksum(dev);
+    }
 
   ninfo("IPv4 length: %d\n", ((int)ipv4->len[0] << 8) + ipv4->len[1]);
 
@@ -225,7 +231,10 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]     = 0;
 
   tcp->tcpchksum   = 0;
-  tcp->tcpchksum   = ~tcp_ipv6_chksum(dev);
+  if (!IFF_IS_NOCHKSUM(dev->d_flags))
+    {
+      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+    }
 
   /* Finish initializing the IP header (no IPv6 checksum) */
 
@@ -350,6 +359,12 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     }
 #endif /* CONFIG_NET_IPv4 */
 
+#ifdef CONFIG_NET_GSO
+  /* Super-segments are split into segments of the connection's MSS */
+
+  dev->d_gsomss = conn->mss;
+#endif
+
   /* Set TCP sequence numbers and port numbers */
 
   memcpy(tcp->ackno, conn->rcvseq, 4);
@@ -639,4 +654,60 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp_sendcommon(dev, conn, tcp);
 }
 
+/****************************************************************************
+ * Name: tcp_sndmss
+ *
+ * Description:
+ *   Return the maximum amount of payload that may be placed in one
+ *   outgoing segment on the connection.  This is normally the MSS, but if
+ *   the device supports generic segmentation offload, it is the largest
+ *   multiple of the MSS that fits into the device's d_gsosize.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection structure holding connection information
+ *   dev  - The device driver structure to use in the send operation
+ *
+ * Returned Value:
+ *   The maximum payload size in bytes.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_GSO
+uint16_t tcp_sndmss(FAR struct tcp_conn_s *conn,
+                    FAR struct net_driver_s *dev)
+{
+  uint16_t hdrlen;
+  uint16_t maxlen;
+
+  if (dev->d_gsosize <= dev->d_pktsize || conn->mss == 0)
+    {
+      return conn->mss;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      hdrlen = NET_LL_HDRLEN(dev) + IPv6TCP_HDRLEN;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      hdrlen = NET_LL_HDRLEN(dev) + IPv4TCP_HDRLEN;
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  maxlen = dev->d_gsosize - hdrlen;
+  return maxlen - (maxlen % conn->mss);
+}
+#endif /* CONFIG_NET_GSO */
+
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
@@ -724,9 +724,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
        */
 
       sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-      if (sndlen > conn->mss)
+      if (sndlen > tcp_sndmss(conn, dev))
         {
-          sndlen = conn->mss;
+          sndlen = tcp_sndmss(conn, dev);
         }
 
       if (sndlen > conn->winsize)
@@ -249,11 +249,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
                   /* Find the listener for this connection. */
 
-#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-                  listener = tcp_findlistener(conn->lport, conn->domain);
-#else
-                  listener = tcp_findlistener(conn->lport);
-#endif
+                  listener = tcp_connlistener(conn);
                   if (listener != NULL)
                     {
                       /* We call tcp_callback() for the connection with
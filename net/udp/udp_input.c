@@ -107,6 +107,10 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   g_netstats.udp.recv++;
 #endif
 
+#ifdef CONFIG_NET_LATENCY
+  net_latency_record(NET_LATENCY_L4IN, dev->d_rxstamp);
+#endif
+
   /* Get a pointer to the UDP header.  The UDP header lies just after the
    * the link layer header and the IP header.
    */
@@ -131,7 +135,13 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
   chksum = udp->udpchksum;
-  if (chksum != 0)
+  if (IFF_IS_NOCHKSUM(dev->d_flags))
+    {
+      /* The checksum was already verified by the device (or is not needed) */
+
+      chksum = 0;
+    }
+  else if (chksum != 0)
     {
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
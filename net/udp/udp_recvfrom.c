@@ -51,6 +51,7 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/udp.h>
+#include <nuttx/net/netstats.h>
 
 #include "netdev/netdev.h"
 #include "devif/devif.h"
@@ -82,6 +83,12 @@ struct udp_recvfrom_s
   FAR socklen_t           *ir_fromlen;   /* Number of bytes allocated for address of sender */
   ssize_t                  ir_recvlen;   /* The received length */
   int                      ir_result;    /* Success:OK, failure:negated errno */
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  bool                     ir_zerocopy;  /* Leave new data to the read-ahead buffers */
+#endif
+#ifdef CONFIG_NET_LATENCY
+  uint32_t                 ir_rxstamp;   /* Time stamp of the data that woke up the receiver */
+#endif
 };
 
 /****************************************************************************
@@ -461,6 +468,21 @@ static uint16_t udp_eventhandler(FAR struct net_driver_s *dev,
           udp_terminate(pstate, -ENETUNREACH);
         }
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+      /* Leave UDP_NEWDATA set so that the datagram is put in the read-ahead
+       * buffers, from where the waiting thread will take it.
+       */
+
+      else if ((flags & UDP_NEWDATA) != 0 && pstate->ir_zerocopy)
+        {
+#ifdef CONFIG_NET_LATENCY
+          pstate->ir_rxstamp = dev->d_rxstamp;
+#endif
+
+          udp_terminate(pstate, OK);
+        }
+#endif
+
       /* If new data is available, then complete the read action. */
 
       else if ((flags & UDP_NEWDATA) != 0)
@@ -477,6 +499,10 @@ static uint16_t udp_eventhandler(FAR struct net_driver_s *dev,
 
           udp_sender(dev, pstate);
 
+#ifdef CONFIG_NET_LATENCY
+          pstate->ir_rxstamp = dev->d_rxstamp;
+#endif
+
           /* Don't allow any further UDP call backs. */
 
           udp_terminate(pstate, OK);
@@ -586,6 +612,159 @@ static ssize_t udp_recvfrom_result(int result, struct udp_recvfrom_s *pstate)
   return pstate->ir_recvlen;
 }
 
+/****************************************************************************
+ * Name: udp_zerocopy_readahead
+ *
+ * Description:
+ *   Remove the datagram at the head of the read-ahead queue, return the
+ *   sender's address and lend the I/O buffer chain holding the payload.
+ *
+ * Input Parameters:
+ *   pstate   recvfrom state structure
+ *   iobp     Location to return the I/O buffer chain
+ *
+ * Returned Value:
+ *   The size of the datagram, or -EAGAIN if the read-ahead queue is empty.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+static ssize_t udp_zerocopy_readahead(FAR struct udp_recvfrom_s *pstate,
+                                      FAR struct iob_s **iobp)
+{
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)
+                                pstate->ir_sock->s_conn;
+  FAR struct iob_s *iob;
+  uint8_t src_addr_size;
+
+  iob = iob_remove_queue(&conn->readahead);
+  if (iob == NULL)
+    {
+      return -EAGAIN;
+    }
+
+  /* The payload follows the size and the address of the sender */
+
+  if (iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0) !=
+      sizeof(uint8_t))
+    {
+      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+      return -EIO;
+    }
+
+  if (pstate->ir_from != NULL)
+    {
+      socklen_t len = *pstate->ir_fromlen;
+      len = (socklen_t)src_addr_size > len ? len : (socklen_t)src_addr_size;
+
+      iob_copyout((FAR uint8_t *)pstate->ir_from, iob, len,
+                  sizeof(uint8_t));
+    }
+
+  iob = iob_trimhead(iob, src_addr_size + sizeof(uint8_t),
+                     IOBUSER_NET_UDP_READAHEAD);
+
+  if (iob != NULL && iob->io_pktlen == 0)
+    {
+      /* An empty datagram, there is nothing to lend */
+
+      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+      iob = NULL;
+    }
+
+  *iobp = iob;
+  return iob != NULL ? iob->io_pktlen : 0;
+}
+
+/****************************************************************************
+ * Name: udp_recvfrom_zerocopy
+ *
+ * Description:
+ *   Perform a MSG_ZEROCOPY receive, waiting until a datagram has been
+ *   buffered in the read-ahead queue if it is empty.
+ *
+ * Input Parameters:
+ *   pstate   recvfrom state structure
+ *   iobp     Location to return the I/O buffer chain
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the size of the datagram.  On error, -errno is
+ *   returned.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static ssize_t udp_recvfrom_zerocopy(FAR struct udp_recvfrom_s *pstate,
+                                     FAR struct iob_s **iobp, int flags)
+{
+  FAR struct socket *psock = pstate->ir_sock;
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
+  FAR struct net_driver_s *dev;
+  ssize_t ret;
+
+  pstate->ir_zerocopy = true;
+
+  while ((ret = udp_zerocopy_readahead(pstate, iobp)) == -EAGAIN)
+    {
+      if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
+        {
+          break;
+        }
+
+      /* Wait for a datagram to be buffered.  The device may be NULL if
+       * the UDP socket is bound to INADDR_ANY.
+       */
+
+      dev = udp_find_laddr_device(conn);
+
+      pstate->ir_cb = udp_callback_alloc(dev, conn);
+      if (pstate->ir_cb == NULL)
+        {
+          ret = -EBUSY;
+          break;
+        }
+
+      pstate->ir_cb->flags   = (UDP_NEWDATA | NETDEV_DOWN);
+      pstate->ir_cb->priv    = (FAR void *)pstate;
+      pstate->ir_cb->event   = udp_eventhandler;
+
+      ret = net_timedwait(&pstate->ir_sem, _SO_TIMEOUT(psock->s_rcvtimeo));
+      if (ret == -ETIMEDOUT)
+        {
+          ret = -EAGAIN;
+        }
+
+#ifdef CONFIG_NET_LATENCY
+      if (ret >= 0)
+        {
+          net_latency_record(NET_LATENCY_WAKEUP, pstate->ir_rxstamp);
+        }
+#endif
+
+      udp_callback_free(dev, conn, pstate->ir_cb);
+
+      if (ret < 0)
+        {
+          break;
+        }
+
+      if (pstate->ir_result < 0)
+        {
+          ret = pstate->ir_result;
+          break;
+        }
+    }
+
+  return ret;
+}
+#endif /* CONFIG_NET_RECV_ZEROCOPY */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -628,6 +807,14 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
   net_lock();
   udp_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+  if ((flags & MSG_ZEROCOPY) != 0)
+    {
+      ret = udp_recvfrom_zerocopy(&state, (FAR struct iob_s **)buf, flags);
+      goto out;
+    }
+#endif
+
   /* Copy the read-ahead data from the packet */
 
   udp_readahead(&state);
@@ -695,6 +882,13 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
               ret = -EAGAIN;
             }
 
+#ifdef CONFIG_NET_LATENCY
+          if (ret >= 0)
+            {
+              net_latency_record(NET_LATENCY_WAKEUP, state.ir_rxstamp);
+            }
+#endif
+
           /* Make sure that no further events are processed */
 
           udp_callback_free(dev, conn, state.ir_cb);
@@ -706,6 +900,9 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
         }
     }
 
+#ifdef CONFIG_NET_RECV_ZEROCOPY
+out:
+#endif
   net_unlock();
   udp_recvfrom_uninitialize(&state);
   return ret;
@@ -122,6 +122,7 @@ struct usrsock_conn_s
     sem_t    sem;         /* Request semaphore (only one outstanding request) */
     uint8_t  xid;         /* Expected message exchange id */
     bool     inprogress;  /* Request was received but daemon is still processing */
+    bool     unlock;      /* Give sem when the response arrives */
     uint16_t valuelen;    /* Length of value from daemon */
     uint16_t valuelen_nontrunc; /* Actual length of value at daemon */
     int      result;      /* Result for request */
@@ -132,6 +133,9 @@ struct usrsock_conn_s
       int    iovcnt;         /* Number of input buffers */
       size_t total;          /* Total length of buffers */
       size_t pos;            /* Writer position on input buffer */
+#ifdef CONFIG_NET_USRSOCK_SHM
+      bool   direct;         /* Data buffer is written by the daemon */
+#endif
     } datain;
   } resp;
 
@@ -303,6 +307,19 @@ int usrsock_event(FAR struct usrsock_conn_s *conn, uint16_t events);
 int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
                           FAR struct iovec *iov, unsigned int iovcnt);
 
+/****************************************************************************
+ * Name: usrsockdev_shm
+ *
+ * Description:
+ *   Return true if the daemon has enabled USRSOCK_FEATURE_SHM, i.e. the
+ *   payloads of requests are passed by address.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_USRSOCK_SHM
+bool usrsockdev_shm(FAR struct usrsock_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: usrsockdev_register
  *
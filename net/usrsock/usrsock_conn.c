@@ -305,7 +305,19 @@ void usrsock_teardown_request_callback(FAR struct usrsock_reqstate_s *pstate)
 
   if (pstate->unlock)
     {
-      _usrsock_semgive(&conn->resp.sem);
+      /* If the wait was interrupted before the daemon has acknowledged the
+       * request, its response is still to come.  Keep the lock until then
+       * so that no other request of this socket can take the response.
+       */
+
+      if (conn->resp.xid != 0 && !conn->resp.inprogress)
+        {
+          conn->resp.unlock = true;
+        }
+      else
+        {
+          _usrsock_semgive(&conn->resp.sem);
+        }
     }
 
   /* Make sure that no further events are processed */
@@ -329,6 +341,9 @@ void usrsock_setup_datain(FAR struct usrsock_conn_s *conn,
   conn->resp.datain.pos = 0;
   conn->resp.datain.total = 0;
   conn->resp.datain.iovcnt = iovcnt;
+#ifdef CONFIG_NET_USRSOCK_SHM
+  conn->resp.datain.direct = false;
+#endif
 
   for (i = 0; i < iovcnt; i++)
     {
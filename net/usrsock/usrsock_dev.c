@@ -46,6 +46,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <poll.h>
+#include <queue.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -69,27 +70,39 @@
 #  define CONFIG_NET_USRSOCKDEV_NPOLLWAITERS 1
 #endif
 
+/* Protocol extensions that the daemon may enable */
+
+#ifdef CONFIG_NET_USRSOCK_SHM
+#  define USRSOCKDEV_FEATURES (USRSOCK_FEATURE_PIPELINE | USRSOCK_FEATURE_SHM)
+#else
+#  define USRSOCKDEV_FEATURES USRSOCK_FEATURE_PIPELINE
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* A request waiting to be read by the daemon.  It lives on the stack of
+ * the requesting thread.
+ */
+
+struct usrsockdev_req_s
+{
+  sq_entry_t node;               /* Supports a singly linked list */
+  FAR const struct iovec *iov;   /* Request buffers */
+  int     iovcnt;                /* Number of request buffers */
+  size_t  pos;                   /* Reader position on request buffers */
+  size_t  len;                   /* Total length of request buffers */
+  uint8_t xid;                   /* Exchange id of the request */
+  sem_t   acksem;                /* Request read or answered by daemon */
+};
+
 struct usrsockdev_s
 {
   sem_t   devsem;     /* Lock for device node */
   uint8_t ocount;     /* The number of times the device has been opened */
-
-  struct
-  {
-    FAR const struct iovec *iov; /* Pending request buffers */
-    int     iovcnt;              /* Number of request buffers */
-    size_t  pos;                 /* Reader position on request buffer */
-    sem_t   sem;                 /* Request semaphore (only one outstanding
-                                  * request) */
-    sem_t   acksem;              /* Request acknowledgment notification */
-    uint8_t ack_xid;             /* Exchange id for which waiting ack */
-    uint16_t nbusy;              /* Number of requests blocked from different
-                                  * threads */
-  } req;
+  uint8_t features;   /* Protocol extensions enabled by the daemon */
+  sq_queue_t reqs;    /* Requests not yet read or answered, oldest first */
 
   FAR struct usrsock_conn_s *datain_conn; /* Connection instance to receive
                                            * data buffers. */
@@ -115,6 +128,9 @@ static int usrsockdev_open(FAR struct file *filep);
 
 static int usrsockdev_close(FAR struct file *filep);
 
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
+
 static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
 
@@ -129,7 +145,7 @@ static const struct file_operations g_usrsockdevops =
   usrsockdev_read,    /* read */
   usrsockdev_write,   /* write */
   usrsockdev_seek,    /* seek */
-  NULL,               /* ioctl */
+  usrsockdev_ioctl,   /* ioctl */
   usrsockdev_poll     /* poll */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL              /* unlink */
@@ -283,6 +299,27 @@ static uint8_t usrsockdev_get_xid(FAR struct usrsock_conn_s *conn)
   return conn_idx + 1;
 }
 
+/****************************************************************************
+ * Name: usrsockdev_resp_done()
+ *
+ * Description:
+ *   The request of the connection has been answered or aborted.  Release
+ *   the request lock if the requester has already given up waiting.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_resp_done(FAR struct usrsock_conn_s *conn)
+{
+  conn->resp.inprogress = false;
+  conn->resp.xid = 0;
+
+  if (conn->resp.unlock)
+    {
+      conn->resp.unlock = false;
+      nxsem_post(&conn->resp.sem);
+    }
+}
+
 /****************************************************************************
  * Name: usrsockdev_semtake() and usrsockdev_semgive()
  *
@@ -340,6 +377,29 @@ static void usrsockdev_pollnotify(FAR struct usrsockdev_s *dev,
     }
 }
 
+/****************************************************************************
+ * Name: usrsockdev_req_done
+ *
+ * Description:
+ *   Remove a request from the queue and wake up the requesting thread.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_req_done(FAR struct usrsockdev_s *dev,
+                                FAR struct usrsockdev_req_s *req)
+{
+  sq_rem(&req->node, &dev->reqs);
+  nxsem_post(&req->acksem);
+
+  /* The next request may have become visible to the daemon */
+
+  req = (FAR struct usrsockdev_req_s *)sq_peek(&dev->reqs);
+  if (req != NULL && req->pos < req->len)
+    {
+      usrsockdev_pollnotify(dev, POLLIN);
+    }
+}
+
 /****************************************************************************
  * Name: usrsockdev_read
  ****************************************************************************/
@@ -349,6 +409,9 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct inode        *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
+  FAR struct usrsockdev_req_s *req;
+  ssize_t                  rlen;
+  size_t                   total;
   int                      ret;
 
   if (len == 0)
@@ -375,37 +438,37 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
 
   net_lock();
 
-  /* Is request available? */
+  /* Copy the queued requests to user-space.  Without pipelining, only the
+   * oldest request is visible until the daemon has responded to it.
+   */
 
-  if (dev->req.iov)
+  total = 0;
+  while (total < len &&
+         (req = (FAR struct usrsockdev_req_s *)sq_peek(&dev->reqs)) != NULL)
     {
-      ssize_t rlen;
-
-      /* Copy request to user-space. */
-
-      rlen = iovec_get(buffer, len, dev->req.iov, dev->req.iovcnt,
-                       dev->req.pos);
-      if (rlen < 0)
+      rlen = iovec_get(buffer + total, len - total, req->iov, req->iovcnt,
+                       req->pos);
+      if (rlen > 0)
         {
-          /* Tried reading beyond buffer. */
-
-          len = 0;
+          req->pos += rlen;
+          total    += rlen;
         }
-      else
+
+      if (req->pos < req->len ||
+          (dev->features & USRSOCK_FEATURE_PIPELINE) == 0)
         {
-          dev->req.pos += rlen;
-          len = rlen;
+          break;
         }
-    }
-  else
-    {
-      len = 0;
+
+      /* The daemon has the whole request, let it read the next one */
+
+      usrsockdev_req_done(dev, req);
     }
 
   net_unlock();
   usrsockdev_semgive(&dev->devsem);
 
-  return len;
+  return total;
 }
 
 /****************************************************************************
@@ -417,6 +480,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
 {
   FAR struct inode        *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
+  FAR struct usrsockdev_req_s *req;
   off_t pos;
   int ret;
 
@@ -441,13 +505,14 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
 
   /* Is request available? */
 
-  if (dev->req.iov)
+  req = (FAR struct usrsockdev_req_s *)sq_peek(&dev->reqs);
+  if (req != NULL)
     {
       ssize_t rlen;
 
       if (whence == SEEK_CUR)
         {
-          pos = dev->req.pos + offset;
+          pos = req->pos + offset;
         }
       else
         {
@@ -456,7 +521,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
 
       /* Copy request to user-space. */
 
-      rlen = iovec_get(NULL, 0, dev->req.iov, dev->req.iovcnt, pos);
+      rlen = iovec_get(NULL, 0, req->iov, req->iovcnt, pos);
       if (rlen < 0)
         {
           /* Tried seek beyond buffer. */
@@ -465,7 +530,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
         }
       else
         {
-          dev->req.pos = pos;
+          req->pos = pos;
         }
     }
   else
@@ -561,8 +626,7 @@ static ssize_t usrsockdev_handle_response(FAR struct usrsockdev_s *dev,
     }
   else
     {
-      conn->resp.inprogress = false;
-      conn->resp.xid = 0;
+      usrsockdev_resp_done(conn);
 
       /* Get result for common request. */
 
@@ -616,8 +680,7 @@ usrsockdev_handle_datareq_response(FAR struct usrsockdev_s *dev,
       goto unlock_out;
     }
 
-  conn->resp.inprogress = false;
-  conn->resp.xid = 0;
+  usrsockdev_resp_done(conn);
 
   /* Prepare to read buffers. */
 
@@ -701,7 +764,15 @@ usrsockdev_handle_datareq_response(FAR struct usrsockdev_s *dev,
       /* Adjust read size. */
 
       conn->resp.datain.iov[iovpos].iov_len = hdr->result;
-      conn->resp.datain.total += conn->resp.datain.iov[iovpos].iov_len;
+#ifdef CONFIG_NET_USRSOCK_SHM
+      /* With USRSOCK_FEATURE_SHM, the daemon has already copied the data */
+
+      if (!conn->resp.datain.direct)
+#endif
+        {
+          conn->resp.datain.total += conn->resp.datain.iov[iovpos].iov_len;
+        }
+
       iovpos++;
     }
 
@@ -727,6 +798,7 @@ static ssize_t usrsockdev_handle_req_response(FAR struct usrsockdev_s *dev,
                                               size_t len)
 {
   FAR const struct usrsock_message_req_ack_s *hdr = buffer;
+  FAR struct usrsockdev_req_s *req;
   FAR struct usrsock_conn_s *conn;
   unsigned int hdrlen;
   ssize_t ret;
@@ -783,15 +855,19 @@ static ssize_t usrsockdev_handle_req_response(FAR struct usrsockdev_s *dev,
       goto unlock_out;
     }
 
-  if (dev->req.ack_xid == hdr->xid && dev->req.iov)
-    {
-      /* Signal that request was received and read by daemon and
-       * acknowledgment response was received.
-       */
-
-      dev->req.iov = NULL;
+  /* If the request is still queued, the daemon has received it and
+   * responded without reading all of it (or without pipelining).
+   */
 
-      nxsem_post(&dev->req.acksem);
+  for (req = (FAR struct usrsockdev_req_s *)sq_peek(&dev->reqs);
+       req != NULL;
+       req = (FAR struct usrsockdev_req_s *)sq_next(&req->node))
+    {
+      if (req->xid == hdr->xid)
+        {
+          usrsockdev_req_done(dev, req);
+          break;
+        }
     }
 
   ret = handle_response(dev, conn, buffer);
@@ -859,70 +935,88 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
       return ret;
     }
 
-  if (!dev->datain_conn)
-    {
-      /* Start of message, buffer length should be at least size of common
-       * message header.
-       */
+  /* A single write may carry several messages, each possibly followed by
+   * the data of a data response.
+   */
 
-      if (len < sizeof(struct usrsock_message_common_s))
+  while (len > 0)
+    {
+      if (!dev->datain_conn)
         {
-          nwarn("message too short, %d < %d.\n", len,
-                sizeof(struct usrsock_message_common_s));
+          /* Start of message, buffer length should be at least size of
+           * common message header.
+           */
 
-          ret = -EINVAL;
-          goto errout;
-        }
+          if (len < sizeof(struct usrsock_message_common_s))
+            {
+              nwarn("message too short, %d < %d.\n", len,
+                    sizeof(struct usrsock_message_common_s));
+
+              ret = -EINVAL;
+              break;
+            }
 
-      /* Handle message. */
+          /* Handle message. */
+
+          ret = usrsockdev_handle_message(dev, buffer, len);
+          if (ret < 0)
+            {
+              break;
+            }
 
-      ret = usrsockdev_handle_message(dev, buffer, len);
-      if (ret >= 0)
-        {
           buffer += ret;
           len -= ret;
-          ret = origlen - len;
         }
-    }
 
-  /* Data input handling. */
+      /* Data input handling. */
 
-  if (dev->datain_conn)
-    {
-      conn = dev->datain_conn;
+      if (dev->datain_conn)
+        {
+          conn = dev->datain_conn;
 
-      /* Copy data from user-space. */
+          /* Copy data from user-space. */
 
-      ret = iovec_put(conn->resp.datain.iov, conn->resp.datain.iovcnt,
-                      conn->resp.datain.pos, buffer, len);
-      if (ret < 0)
-        {
-          /* Tried writing beyond buffer. */
+          ret = iovec_put(conn->resp.datain.iov, conn->resp.datain.iovcnt,
+                          conn->resp.datain.pos, buffer, len);
+          if (ret < 0)
+            {
+              /* Tried writing beyond buffer. */
 
-          ret = -EINVAL;
-          conn->resp.result = -EINVAL;
-          conn->resp.datain.pos =
-              conn->resp.datain.total;
-        }
-      else
-        {
-          conn->resp.datain.pos += ret;
-          buffer += ret;
-          len -= ret;
-          ret = origlen - len;
-        }
+              ret = -EINVAL;
+              conn->resp.result = -EINVAL;
+              conn->resp.datain.pos =
+                  conn->resp.datain.total;
+            }
+          else
+            {
+              conn->resp.datain.pos += ret;
+              buffer += ret;
+              len -= ret;
+            }
 
-      if (conn->resp.datain.pos == conn->resp.datain.total)
-        {
-          dev->datain_conn = NULL;
+          if (conn->resp.datain.pos == conn->resp.datain.total)
+            {
+              dev->datain_conn = NULL;
+
+              /* Done with data response. */
 
-          /* Done with data response. */
+              usrsock_event(conn, USRSOCK_EVENT_REQ_COMPLETE);
+            }
 
-          usrsock_event(conn, USRSOCK_EVENT_REQ_COMPLETE);
+          if (ret < 0)
+            {
+              break;
+            }
         }
     }
 
-errout:
+  /* Report the messages that were handled before any error */
+
+  if (len < origlen)
+    {
+      ret = origlen - len;
+    }
+
   usrsockdev_semgive(&dev->devsem);
   return ret;
 }
@@ -982,6 +1076,7 @@ static int usrsockdev_close(FAR struct file *filep)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
+  FAR struct usrsockdev_req_s *req;
   FAR struct usrsock_conn_s *conn;
   int ret;
 
@@ -1006,8 +1101,7 @@ static int usrsockdev_close(FAR struct file *filep)
     {
       net_lock();
 
-      conn->resp.inprogress = false;
-      conn->resp.xid = 0;
+      usrsockdev_resp_done(conn);
       usrsock_event(conn, USRSOCK_EVENT_ABORT);
 
       net_unlock();
@@ -1023,49 +1117,69 @@ static int usrsockdev_close(FAR struct file *filep)
   DEBUGASSERT(dev->ocount == 0);
   ret = OK;
 
-  do
+  /* Wake up the threads of the requests that were not read or answered;
+   * their sockets have been aborted.
+   */
+
+  while ((req = (FAR struct usrsockdev_req_s *)sq_peek(&dev->reqs)) != NULL)
     {
-      /* Give other threads short time window to complete recently completed
-       * requests.
-       */
+      usrsockdev_req_done(dev, req);
+    }
 
-      ret = net_timedwait(&dev->req.sem, 10);
-      if (ret < 0)
-        {
-          if (ret != -ETIMEDOUT && ret != -EINTR)
-            {
-              ninfo("net_timedwait errno: %d\n", ret);
-              DEBUGASSERT(false);
-            }
-        }
-      else
-        {
-          usrsockdev_semgive(&dev->req.sem);
-        }
+  /* The next daemon starts without protocol extensions */
 
-      /* Wake-up pending requests. */
+  dev->features = 0;
+  net_unlock();
 
-      if (dev->req.nbusy == 0)
-        {
-          break;
-        }
+  usrsockdev_semgive(&dev->devsem);
 
-      dev->req.iov = NULL;
-      nxsem_post(&dev->req.acksem);
-    }
-  while (true);
+  return ret;
+}
 
-  net_unlock();
+/****************************************************************************
+ * Name: usrsockdev_ioctl
+ ****************************************************************************/
+
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_s *dev;
+  int ret;
 
-  /* Check if request line is active */
+  DEBUGASSERT(inode);
+
+  dev = inode->i_private;
 
-  if (dev->req.iov != NULL)
+  DEBUGASSERT(dev);
+
+  ret = usrsockdev_semtake(&dev->devsem);
+  if (ret < 0)
     {
-      dev->req.iov = NULL;
+      return ret;
     }
 
-  usrsockdev_semgive(&dev->devsem);
+  switch (cmd)
+    {
+    case USRSOCKIOC_FEATURES:
+      if ((arg & ~USRSOCKDEV_FEATURES) != 0)
+        {
+          ret = -ENOTSUP;
+        }
+      else
+        {
+          net_lock();
+          dev->features = arg;
+          net_unlock();
+        }
+      break;
+
+    default:
+      ret = -ENOTTY;
+      break;
+    }
 
+  usrsockdev_semgive(&dev->devsem);
   return ret;
 }
 
@@ -1078,6 +1192,7 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct usrsockdev_s *dev;
+  FAR struct usrsockdev_req_s *req;
   pollevent_t eventset;
   int ret;
   int i;
@@ -1137,9 +1252,8 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
       /* Notify the POLLIN event if pending request. */
 
-      if (dev->req.iov != NULL &&
-          !(iovec_get(NULL, 0, dev->req.iov,
-                      dev->req.iovcnt, dev->req.pos) < 0))
+      req = (FAR struct usrsockdev_req_s *)sq_peek(&dev->reqs);
+      if (req != NULL && req->pos < req->len)
         {
           eventset |= POLLIN;
         }
@@ -1186,6 +1300,8 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
 {
   FAR struct usrsockdev_s *dev = conn->dev;
   FAR struct usrsock_request_common_s *req_head = iov[0].iov_base;
+  struct usrsockdev_req_s req;
+  unsigned int i;
 
   if (!dev)
     {
@@ -1202,6 +1318,18 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
       return -ENETDOWN;
     }
 
+  /* The response state of a connection has a single slot and the exchange
+   * id is that of the connection.  The callers hold conn->resp.sem until
+   * the response; a request still in flight here would take it over.
+   */
+
+  if (conn->resp.xid != 0 && !conn->resp.inprogress)
+    {
+      nwarn("usockid=%d; request still pending.\n", conn->usockid);
+
+      return -EBUSY;
+    }
+
   /* Get exchange id. */
 
   req_head->xid = usrsockdev_get_xid(conn);
@@ -1211,43 +1339,68 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
   conn->resp.xid = req_head->xid;
   conn->resp.result = -EACCES;
 
-  ++dev->req.nbusy; /* net_lock held. */
-
-  /* Set outstanding request for daemon to handle. */
+  /* Queue the request for the daemon to read.  Requests of other sockets
+   * may be queued at the same time.
+   */
 
-  net_lockedwait_uninterruptible(&dev->req.sem);
+  req.iov    = iov;
+  req.iovcnt = iovcnt;
+  req.pos    = 0;
+  req.len    = 0;
+  req.xid    = req_head->xid;
 
-  if (usrsockdev_is_opened(dev))
+  for (i = 0; i < iovcnt; i++)
     {
-      DEBUGASSERT(dev->req.iov == NULL);
-      dev->req.ack_xid = req_head->xid;
-      dev->req.iov = iov;
-      dev->req.pos = 0;
-      dev->req.iovcnt = iovcnt;
+      req.len += iov[i].iov_len;
+    }
 
-      /* Notify daemon of new request. */
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
 
-      usrsockdev_pollnotify(dev, POLLIN);
+  nxsem_init(&req.acksem, 0, 0);
+  nxsem_set_protocol(&req.acksem, SEM_PRIO_NONE);
 
-      /* Wait ack for request. */
+  sq_addlast(&req.node, &dev->reqs); /* net_lock held. */
 
-      net_lockedwait_uninterruptible(&dev->req.acksem);
-    }
-  else
+  /* Notify daemon of new request, unless it is still hidden behind an
+   * older request.
+   */
+
+  if ((dev->features & USRSOCK_FEATURE_PIPELINE) != 0 ||
+      sq_peek(&dev->reqs) == &req.node)
     {
-      ninfo("usockid=%d; daemon abruptly closed /dev/usrsock.\n",
-            conn->usockid);
+      usrsockdev_pollnotify(dev, POLLIN);
     }
 
-  /* Free request line for next command. */
-
-  usrsockdev_semgive(&dev->req.sem);
+  /* Wait until the daemon has read or answered the request, or has closed
+   * /dev/usrsock.
+   */
 
-  --dev->req.nbusy; /* net_lock held. */
+  net_lockedwait_uninterruptible(&req.acksem);
+  nxsem_destroy(&req.acksem);
 
   return OK;
 }
 
+#ifdef CONFIG_NET_USRSOCK_SHM
+/****************************************************************************
+ * Name: usrsockdev_shm
+ *
+ * Description:
+ *   Return true if the daemon has enabled USRSOCK_FEATURE_SHM, i.e. the
+ *   payloads of requests are passed by address.
+ *
+ ****************************************************************************/
+
+bool usrsockdev_shm(FAR struct usrsock_conn_s *conn)
+{
+  FAR struct usrsockdev_s *dev = conn->dev ? conn->dev : &g_usrsockdev;
+
+  return (dev->features & USRSOCK_FEATURE_SHM) != 0;
+}
+#endif
+
 /****************************************************************************
  * Name: usrsockdev_register
  *
@@ -1261,11 +1414,9 @@ void usrsockdev_register(void)
   /* Initialize device private structure. */
 
   g_usrsockdev.ocount = 0;
-  g_usrsockdev.req.nbusy = 0;
+  g_usrsockdev.features = 0;
   nxsem_init(&g_usrsockdev.devsem, 0, 1);
-  nxsem_init(&g_usrsockdev.req.sem, 0, 1);
-  nxsem_init(&g_usrsockdev.req.acksem, 0, 0);
-  nxsem_set_protocol(&g_usrsockdev.req.acksem, SEM_PRIO_NONE);
+  sq_init(&g_usrsockdev.reqs);
 
   register_driver("/dev/usrsock", &g_usrsockdevops, 0666,
                   &g_usrsockdev);
@@ -160,14 +160,20 @@ static uint16_t recvfrom_event(FAR struct net_driver_s *dev,
  ****************************************************************************/
 
 static int do_recvfrom_request(FAR struct usrsock_conn_s *conn,
-                               size_t buflen, socklen_t addrlen,
-                               int32_t flags)
+                               FAR void *buf, size_t buflen,
+                               socklen_t addrlen, int32_t flags)
 {
   struct usrsock_request_recvfrom_s req =
   {
   };
 
+#ifdef CONFIG_NET_USRSOCK_SHM
+  struct usrsock_request_shm_s shm;
+  struct iovec bufs[2];
+#else
   struct iovec bufs[1];
+#endif
+  unsigned int nbufs = 1;
 
   if (addrlen > UINT16_MAX)
     {
@@ -190,7 +196,19 @@ static int do_recvfrom_request(FAR struct usrsock_conn_s *conn,
   bufs[0].iov_base = (FAR void *)&req;
   bufs[0].iov_len = sizeof(req);
 
-  return usrsockdev_do_request(conn, bufs, ARRAY_SIZE(bufs));
+#ifdef CONFIG_NET_USRSOCK_SHM
+  if (conn->resp.datain.direct)
+    {
+      /* Pass the receive buffer by address, the daemon fills it directly. */
+
+      shm.addr = (uintptr_t)buf;
+      bufs[1].iov_base = (FAR void *)&shm;
+      bufs[1].iov_len = sizeof(shm);
+      nbufs++;
+    }
+#endif
+
+  return usrsockdev_do_request(conn, bufs, nbufs);
 }
 
 /****************************************************************************
@@ -398,6 +416,9 @@ ssize_t usrsock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       inbufs[1].iov_len = len;
 
       usrsock_setup_datain(conn, inbufs, ARRAY_SIZE(inbufs));
+#ifdef CONFIG_NET_USRSOCK_SHM
+      conn->resp.datain.direct = usrsockdev_shm(conn);
+#endif
 
       /* MSG_DONTWAIT is only use in usrsock. */
 
@@ -405,7 +426,7 @@ ssize_t usrsock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 
       /* Request user-space daemon to close socket. */
 
-      ret = do_recvfrom_request(conn, len, addrlen, flags);
+      ret = do_recvfrom_request(conn, buf, len, addrlen, flags);
       if (ret >= 0)
         {
           /* Wait for completion of request. */
@@ -156,6 +156,9 @@ static int do_sendto_request(FAR struct usrsock_conn_s *conn,
   {
   };
 
+#ifdef CONFIG_NET_USRSOCK_SHM
+  struct usrsock_request_shm_s shm;
+#endif
   struct iovec bufs[3];
 
   if (addrlen > UINT16_MAX)
@@ -183,6 +186,17 @@ static int do_sendto_request(FAR struct usrsock_conn_s *conn,
   bufs[2].iov_base = (FAR void *)buf;
   bufs[2].iov_len = buflen;
 
+#ifdef CONFIG_NET_USRSOCK_SHM
+  if (usrsockdev_shm(conn))
+    {
+      /* Pass the payload by address, the daemon copies it directly. */
+
+      shm.addr = (uintptr_t)buf;
+      bufs[2].iov_base = (FAR void *)&shm;
+      bufs[2].iov_len = sizeof(shm);
+    }
+#endif
+
   return usrsockdev_do_request(conn, bufs, ARRAY_SIZE(bufs));
 }
 
@@ -41,8 +41,69 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <arpa/inet.h>
+
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The generic chksum() accumulates the one's complement sum a word at a
+ * time in native byte order and converts the folded result to host order
+ * only once at the end (RFC1071, section 2(B)).  If the architecture
+ * supports 64-bit integers, 32-bit words are summed into a 64-bit
+ * accumulator; otherwise 16-bit words are summed into a 32-bit
+ * accumulator.  In either case the accumulator cannot overflow for any
+ * length representable by a uint16_t.
+ */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+#  define CHKSUM_WORD_SIZE 4
+#else
+#  define CHKSUM_WORD_SIZE 2
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_HAVE_LONG_LONG
+typedef uint64_t chksum_acc_t;
+typedef uint32_t chksum_word_t;
+#else
+typedef uint32_t chksum_acc_t;
+typedef uint16_t chksum_word_t;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum_fold
+ *
+ * Description:
+ *   Fold the wide accumulator down to a 16-bit one's complement sum.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+static inline uint16_t chksum_fold(chksum_acc_t acc)
+{
+#ifdef CONFIG_HAVE_LONG_LONG
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffffffff) + (acc >> 32);
+#endif
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  return (uint16_t)acc;
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -69,40 +130,104 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const chksum_word_t *wptr;
+  chksum_acc_t acc = 0;
+  bool odd;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* If the buffer begins on an odd address, then consume the first byte
+   * separately.  The remaining, aligned words are then paired with their
+   * bytes swapped, which is corrected after folding.
+   */
+
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc = *data;
+#else
+      acc = (chksum_acc_t)*data << 8;
+#endif
+      data++;
+      len--;
+    }
+
+#if CHKSUM_WORD_SIZE > 2
+  /* Align to the accumulator word size */
+
+  if (len >= 2 && ((uintptr_t)data & 2) != 0)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+#endif
+
+  /* Sum whole words, unrolled four at a time */
+
+  wptr = (FAR const chksum_word_t *)data;
+  while (len >= 4 * CHKSUM_WORD_SIZE)
+    {
+      acc += wptr[0];
+      acc += wptr[1];
+      acc += wptr[2];
+      acc += wptr[3];
+      wptr += 4;
+      len  -= 4 * CHKSUM_WORD_SIZE;
+    }
 
-  while (dataptr < last_byte)
+  while (len >= CHKSUM_WORD_SIZE)
     {
-      /* At least two more bytes */
+      acc += *wptr++;
+      len -= CHKSUM_WORD_SIZE;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  data = (FAR const uint8_t *)wptr;
+
+  /* Then any trailing half word and byte */
+
+#if CHKSUM_WORD_SIZE > 2
+  if (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+#endif
 
-      dataptr += 2;
+  if (len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (chksum_acc_t)*data << 8;
+#else
+      acc += *data;
+#endif
     }
 
-  if (dataptr == last_byte)
+  /* Fold to 16-bits, undo the odd alignment swap and convert the native
+   * order sum to host order.
+   */
+
+  acc = chksum_fold(acc);
+  if (odd)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      acc = ((acc & 0xff) << 8) | ((acc >> 8) & 0xff);
     }
 
+  acc = NTOHS((uint16_t)acc);
+
+  /* Finally, add in the partial sum from any previous call */
+
+  acc += sum;
+  acc  = (acc & 0xffff) + (acc >> 16);
+
   /* Return sum in host byte order. */
 
-  return sum;
+  return (uint16_t)acc;
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
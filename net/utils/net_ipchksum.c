@@ -56,6 +56,43 @@
 #define IPv4BUF  ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF  ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: upperlayer_maxlen
+ *
+ * Description:
+ *   Return the largest packet that may be present in the device buffer.
+ *   This is normally the MTU, but segments built by GSO or merged by GRO
+ *   may be larger.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_NET_ARCH_CHKSUM)
+static inline uint16_t upperlayer_maxlen(FAR struct net_driver_s *dev)
+{
+  uint16_t maxlen = NETDEV_PKTSIZE(dev);
+
+#ifdef CONFIG_NET_GSO
+  if (dev->d_gsosize > maxlen)
+    {
+      maxlen = dev->d_gsosize;
+    }
+#endif
+
+#ifdef CONFIG_NET_GRO
+  if (dev->d_gro.ng_bufsize > maxlen)
+    {
+      maxlen = dev->d_gro.ng_bufsize;
+    }
+#endif
+
+  return maxlen;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -98,7 +135,7 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   /* Verify some minimal assumptions */
 
-  if (upperlen > NETDEV_PKTSIZE(dev))
+  if (upperlen > upperlayer_maxlen(dev))
     {
       return 0;
     }
@@ -164,7 +201,7 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
 
   /* Verify some minimal assumptions */
 
-  if (upperlen > NETDEV_PKTSIZE(dev))
+  if (upperlen > upperlayer_maxlen(dev))
     {
       return 0;
     }
@@ -0,0 +1,138 @@
+/****************************************************************************
+ * net/utils/net_latency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+#include <assert.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sched_note.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_LATENCY
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* This is the array in which the latency histograms are gathered. */
+
+struct net_latency_s g_netlatency[NET_LATENCY_NSTAGES];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_latency_stamp
+ *
+ * Description:
+ *   Return a time stamp for the network latency instrumentation.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The current time in microseconds.  The value is never zero, zero is
+ *   reserved to mean "no time stamp".
+ *
+ ****************************************************************************/
+
+uint32_t net_latency_stamp(void)
+{
+  struct timespec ts;
+  uint32_t stamp;
+
+  clock_systime_timespec(&ts);
+
+  /* Only differences of time stamps are used, so it does not matter that
+   * the value wraps around.
+   */
+
+  stamp = (uint32_t)ts.tv_sec * 1000000 + (uint32_t)(ts.tv_nsec / 1000);
+  return stamp != 0 ? stamp : 1;
+}
+
+/****************************************************************************
+ * Name: net_latency_record
+ *
+ * Description:
+ *   Add the time elapsed since a time stamp to the histogram of a stage of
+ *   the network latency instrumentation.
+ *
+ * Input Parameters:
+ *   stage - See enum net_latency_e
+ *   stamp - The time stamp returned by net_latency_stamp().  Nothing is
+ *           recorded if it is zero.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void net_latency_record(int stage, uint32_t stamp)
+{
+  FAR struct net_latency_s *latency;
+  uint32_t elapsed;
+  int n;
+
+  DEBUGASSERT(stage >= 0 && stage < NET_LATENCY_NSTAGES);
+
+  if (stamp == 0)
+    {
+      return;
+    }
+
+  elapsed = net_latency_stamp() - stamp;
+  latency = &g_netlatency[stage];
+
+  latency->nsamples++;
+  latency->total += elapsed;
+  if (elapsed > latency->max)
+    {
+      latency->max = elapsed;
+    }
+
+  /* Find the smallest power of two that is greater than the sample */
+
+  for (n = 0; n < NET_LATENCY_NBUCKETS - 1 && elapsed >= (1u << n); n++)
+    {
+    }
+
+  latency->bucket[n]++;
+
+  /* And add the sample to the scheduler instrumentation */
+
+  sched_note_netlatency(stage, elapsed);
+}
+
+#endif /* CONFIG_NET_LATENCY */
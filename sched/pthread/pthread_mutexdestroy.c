@@ -95,12 +95,21 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
 
               mutex->pid = -1;
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+              /* Give the mutex on behalf of the dead holder.  If threads
+               * wait for the mutex, then this will hand it over to one of
+               * them and make destruction of the semaphore impossible here.
+               */
+
+              status = -pthread_mutex_give(mutex);
+#else
               /* Reset the semaphore.  If threads are were on this
                * semaphore, then this will awakened them and make
                * destruction of the semaphore impossible here.
                */
 
               status = nxsem_reset((FAR sem_t *)&mutex->sem, 1);
+#endif
               if (status < 0)
                 {
                   ret = -status;
@@ -110,7 +119,11 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
                * mutex.
                */
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+              else if (mutex->nlockers > 0)
+#else
               else if (mutex->pid != -1)
+#endif
                 {
                   /* Yes.. then we cannot destroy the mutex now. */
 
@@ -0,0 +1,227 @@
+/****************************************************************************
+ * sched/pthread/pthread_mutexfast.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#include "pthread/pthread.h"
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The memory barrier is provided with the spinlocks of SMP architectures */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_abandon
+ *
+ * Description:
+ *   A thread counted in nlockers could not take the mutex.  If the holder
+ *   has already handed the mutex over, take it now.  Otherwise, leave the
+ *   count to the next holder:  It will be discarded when the mutex is
+ *   given.
+ *
+ * Input Parameters:
+ *   mutex   - The mutex that could not be taken
+ *   errcode - The error to return if the mutex was not handed over
+ *
+ * Returned Value:
+ *   0 if the mutex was taken or errcode otherwise.
+ *
+ ****************************************************************************/
+
+static int pthread_mutex_abandon(FAR struct pthread_mutex_s *mutex,
+                                 int errcode)
+{
+  irqstate_t flags;
+  int ret = errcode;
+
+  flags = enter_critical_section();
+
+  if (nxsem_trywait(&mutex->sem) == OK)
+    {
+      ret = OK;
+    }
+  else
+    {
+      mutex->nabandoned++;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_take
+ *
+ * Description:
+ *   Take the pthread_mutex, waiting if necessary.  An uncontended mutex is
+ *   taken with a single atomic increment of the count of the threads that
+ *   hold or wait for it; only the waiters use the underlying semaphore.
+ *
+ * Input Parameters:
+ *  mutex       - The mutex to be locked
+ *  abs_timeout - max wait time (NULL wait forever)
+ *  intr        - false: ignore EINTR errors when locking; true treat EINTR
+ *                as other errors by returning the errno value
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
+                       FAR const struct timespec *abs_timeout, bool intr)
+{
+  int ret;
+
+  DEBUGASSERT(mutex != NULL);
+
+  /* Are we the only thread that holds or waits for the mutex?  The
+   * barrier keeps the accesses of the critical section after the atomic
+   * increment that took the mutex.
+   */
+
+  if (up_fetchadd32(&mutex->nlockers, 1) == 1)
+    {
+      SP_DMB();
+      return OK;
+    }
+
+  /* No.. wait until the holder hands the mutex over */
+
+  ret = pthread_sem_take(&mutex->sem, abs_timeout, intr);
+  if (ret != OK)
+    {
+      ret = pthread_mutex_abandon(mutex, ret);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_trytake
+ *
+ * Description:
+ *   Try to take the pthread_mutex without waiting.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be locked
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
+{
+  DEBUGASSERT(mutex != NULL);
+
+  if (up_fetchadd32(&mutex->nlockers, 1) == 1)
+    {
+      SP_DMB();
+      return OK;
+    }
+
+  return pthread_mutex_abandon(mutex, EAGAIN);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_give
+ *
+ * Description:
+ *   Release the pthread_mutex.  If other threads wait for the mutex, hand
+ *   it over to one of them.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be unlocked
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_give(FAR struct pthread_mutex_s *mutex)
+{
+  irqstate_t flags;
+  int32_t nlockers;
+  int ret = OK;
+
+  DEBUGASSERT(mutex != NULL);
+
+  /* Complete the accesses of the critical section before the mutex is
+   * released.  Are there other threads that wait for the mutex?
+   */
+
+  SP_DMB();
+  nlockers = up_fetchsub32(&mutex->nlockers, 1);
+  if (nlockers > 0)
+    {
+      /* Yes.. discard the waiters that gave up, then wake up one of the
+       * remaining waiters, if any.
+       */
+
+      flags = enter_critical_section();
+
+      while (nlockers > 0 && mutex->nabandoned > 0)
+        {
+          mutex->nabandoned--;
+          nlockers = up_fetchsub32(&mutex->nlockers, 1);
+        }
+
+      if (nlockers > 0)
+        {
+          ret = pthread_sem_give(&mutex->sem);
+        }
+
+      leave_critical_section(flags);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
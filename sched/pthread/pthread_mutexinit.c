@@ -101,9 +101,13 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
 
       mutex->pid = -1;
 
-      /* Initialize the mutex like a semaphore with initial count = 1 */
+      /* Initialize the mutex like a semaphore with initial count = 1.  With
+       * the fast path, the semaphore only queues the waiters and the count
+       * is zero.
+       */
 
-      status = nxsem_init((FAR sem_t *)&mutex->sem, pshared, 1);
+      status = nxsem_init((FAR sem_t *)&mutex->sem, pshared,
+                          __PTHREAD_MUTEX_SEMCOUNT);
       if (status < 0)
         {
           ret = -ret;
@@ -133,6 +137,11 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
       mutex->type   = type;
       mutex->nlocks = 0;
 #endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+      mutex->nlockers   = 0;
+      mutex->nabandoned = 0;
+#endif
     }
 
   sinfo("Returning %d\n", ret);
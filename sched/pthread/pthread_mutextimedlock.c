@@ -101,11 +101,15 @@ int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
 
   if (mutex != NULL)
     {
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
       /* Make sure the semaphore is stable while we make the following
-       * checks.  This all needs to be one atomic action.
+       * checks.  This all needs to be one atomic action.  This is not
+       * necessary with the fast path:  The mutex is taken atomically and
+       * only the calling thread can make it the holder of the mutex.
        */
 
       sched_lock();
+#endif
 
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
       /* All mutex types except for NORMAL (and DEFAULT) will return
@@ -217,7 +221,9 @@ int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
             }
         }
 
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
       sched_unlock();
+#endif
     }
 
   sinfo("Returning %d\n", ret);
@@ -78,11 +78,15 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
     {
       int mypid = (int)getpid();
 
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
       /* Make sure the semaphore is stable while we make the following
-       * checks.  This all needs to be one atomic action.
+       * checks.  This all needs to be one atomic action.  This is not
+       * necessary with the fast path:  The mutex is taken atomically and
+       * only the calling thread can make it the holder of the mutex.
        */
 
       sched_lock();
+#endif
 
       /* Try to get the semaphore. */
 
@@ -195,7 +199,9 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
           ret = status;
         }
 
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
       sched_unlock();
+#endif
     }
 
   sinfo("Returning %d\n", ret);
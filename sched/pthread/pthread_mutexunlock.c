@@ -68,6 +68,11 @@
 
 static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
 {
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  /* The mutex is locked if any thread holds or waits for it */
+
+  return mutex->nlockers > 0;
+#else
   int semcount = mutex->sem.semcount;
 
   /* The underlying semaphore should have a count less than 2:
@@ -79,6 +84,7 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
 
   DEBUGASSERT(semcount < 2);
   return semcount < 1;
+#endif
 }
 
 /****************************************************************************
@@ -124,11 +130,14 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
       return EINVAL;
     }
 
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
   /* Make sure the semaphore is stable while we make the following checks.
-   * This all needs to be one atomic action.
+   * This all needs to be one atomic action.  This is not necessary with
+   * the fast path:  The mutex is given atomically.
    */
 
   sched_lock();
+#endif
 
   /* The unlock operation is only performed if the mutex is actually locked.
    * EPERM *must* be returned if the mutex type is PTHREAD_MUTEX_ERRORCHECK
@@ -236,7 +245,9 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
         }
     }
 
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
   sched_unlock();
+#endif
   sinfo("Returning %d\n", ret);
   return ret;
 }
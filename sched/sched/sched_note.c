@@ -787,6 +787,35 @@ void sched_note_irqhandler(int irq, FAR void *handler, bool enter)
 }
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_NET
+void sched_note_netlatency(int stage, uint32_t elapsed)
+{
+  struct note_netlatency_s note;
+  FAR struct tcb_s *tcb = this_task();
+
+  if (!note_isenabled())
+    {
+      return;
+    }
+
+  /* Format the note */
+
+  note_common(tcb, &note.nnl_cmn, sizeof(struct note_netlatency_s),
+              NOTE_NET_LATENCY);
+  DEBUGASSERT(stage <= UCHAR_MAX);
+  note.nnl_stage      = (uint8_t)stage;
+  note.nnl_elapsed[0] = (uint8_t)(elapsed         & 0xff);
+  note.nnl_elapsed[1] = (uint8_t)((elapsed >> 8)  & 0xff);
+  note.nnl_elapsed[2] = (uint8_t)((elapsed >> 16) & 0xff);
+  note.nnl_elapsed[3] = (uint8_t)((elapsed >> 24) & 0xff);
+
+  /* Add the note to circular buffer */
+
+  sched_note_add((FAR const uint8_t *)&note,
+                 sizeof(struct note_netlatency_s));
+}
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
 
 /****************************************************************************
@@ -0,0 +1,431 @@
+/****************************************************************************
+ * sched/semaphore/sem_rwlock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/rwlock.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The memory barrier is provided with the spinlocks of SMP architectures */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rwlock_addreader
+ *
+ * Description:
+ *   Add to the count of readers of the calling CPU.  The update is visible
+ *   to the other CPUs before the caller looks at the writer flag.
+ *
+ ****************************************************************************/
+
+static inline void rwlock_addreader(FAR rwlock_t *rwlock, int32_t value)
+{
+#ifdef CONFIG_ARCH_HAVE_FETCHADD
+  up_fetchadd32(&rwlock->readers[this_cpu()], value);
+#else
+  irqstate_t flags = enter_critical_section();
+  rwlock->readers[this_cpu()] += value;
+  leave_critical_section(flags);
+#endif
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: rwlock_nreaders
+ *
+ * Description:
+ *   Return the number of readers that hold the lock.
+ *
+ ****************************************************************************/
+
+static int32_t rwlock_nreaders(FAR rwlock_t *rwlock)
+{
+  int32_t nreaders = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < RWLOCK_NCPUS; cpu++)
+    {
+      nreaders += rwlock->readers[cpu];
+    }
+
+  return nreaders;
+}
+
+/****************************************************************************
+ * Name: rwlock_drained
+ *
+ * Description:
+ *   Wake up the writer if it waits for the readers and the last one has
+ *   left.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+static void rwlock_drained(FAR rwlock_t *rwlock)
+{
+  if (rwlock->drain && rwlock_nreaders(rwlock) == 0)
+    {
+      rwlock->drain = false;
+      nxsem_post(&rwlock->wrwait);
+    }
+}
+
+/****************************************************************************
+ * Name: rwlock_wakereaders
+ *
+ * Description:
+ *   Wake up all of the readers that wait for the writer.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+static void rwlock_wakereaders(FAR rwlock_t *rwlock)
+{
+  while (rwlock->nrdwait > 0)
+    {
+      rwlock->nrdwait--;
+      nxsem_post(&rwlock->rdwait);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxrwlock_init
+ *
+ * Description:
+ *   Initialize a reader/writer lock.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be initialized
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int nxrwlock_init(FAR rwlock_t *rwlock)
+{
+  int cpu;
+
+  DEBUGASSERT(rwlock != NULL);
+
+  for (cpu = 0; cpu < RWLOCK_NCPUS; cpu++)
+    {
+      rwlock->readers[cpu] = 0;
+    }
+
+  rwlock->writer  = false;
+  rwlock->drain   = false;
+  rwlock->nrdwait = 0;
+
+  nxsem_init(&rwlock->wrsem, 0, 1);
+  nxsem_init(&rwlock->rdwait, 0, 0);
+  nxsem_init(&rwlock->wrwait, 0, 0);
+
+  /* rdwait and wrwait are used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_set_protocol(&rwlock->rdwait, SEM_PRIO_NONE);
+  nxsem_set_protocol(&rwlock->wrwait, SEM_PRIO_NONE);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxrwlock_destroy
+ *
+ * Description:
+ *   Destroy a reader/writer lock that is not held.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be destroyed
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int nxrwlock_destroy(FAR rwlock_t *rwlock)
+{
+  DEBUGASSERT(rwlock != NULL);
+
+  if (rwlock->writer || rwlock_nreaders(rwlock) != 0)
+    {
+      return -EBUSY;
+    }
+
+  nxsem_destroy(&rwlock->wrsem);
+  nxsem_destroy(&rwlock->rdwait);
+  nxsem_destroy(&rwlock->wrwait);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxrwlock_rdlock
+ *
+ * Description:
+ *   Take the lock for reading, waiting while a writer holds or waits for
+ *   it.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure:  -ECANCELED if the thread was canceled while waiting.
+ *
+ ****************************************************************************/
+
+int nxrwlock_rdlock(FAR rwlock_t *rwlock)
+{
+  irqstate_t flags;
+  int ret;
+
+  DEBUGASSERT(rwlock != NULL && !up_interrupt_context());
+
+  for (; ; )
+    {
+      /* Count this reader, then check for a writer.  The writer sets its
+       * flag before it counts the readers so either this reader sees the
+       * writer or the writer sees this reader.
+       */
+
+      rwlock_addreader(rwlock, 1);
+      if (!rwlock->writer)
+        {
+          return OK;
+        }
+
+      /* There is a writer.  Back out, waking up the writer if this was the
+       * last reader it waited for, and wait until the writer is done.
+       */
+
+      flags = enter_critical_section();
+
+      rwlock_addreader(rwlock, -1);
+      rwlock_drained(rwlock);
+
+      if (rwlock->writer)
+        {
+          rwlock->nrdwait++;
+          ret = nxsem_wait_uninterruptible(&rwlock->rdwait);
+          if (ret < 0)
+            {
+              rwlock->nrdwait--;
+              leave_critical_section(flags);
+              return ret;
+            }
+        }
+
+      leave_critical_section(flags);
+    }
+}
+
+/****************************************************************************
+ * Name: nxrwlock_tryrdlock
+ *
+ * Description:
+ *   Take the lock for reading if no writer holds or waits for it.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  -EAGAIN is returned if there is a
+ *   writer.
+ *
+ ****************************************************************************/
+
+int nxrwlock_tryrdlock(FAR rwlock_t *rwlock)
+{
+  DEBUGASSERT(rwlock != NULL);
+
+  rwlock_addreader(rwlock, 1);
+  if (!rwlock->writer)
+    {
+      return OK;
+    }
+
+  nxrwlock_rdunlock(rwlock);
+  return -EAGAIN;
+}
+
+/****************************************************************************
+ * Name: nxrwlock_rdunlock
+ *
+ * Description:
+ *   Release the lock taken for reading.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be released
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxrwlock_rdunlock(FAR rwlock_t *rwlock)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(rwlock != NULL);
+
+  rwlock_addreader(rwlock, -1);
+
+  /* Wake up the writer if it waits for this reader */
+
+  if (rwlock->writer)
+    {
+      flags = enter_critical_section();
+      rwlock_drained(rwlock);
+      leave_critical_section(flags);
+    }
+}
+
+/****************************************************************************
+ * Name: nxrwlock_wrlock
+ *
+ * Description:
+ *   Take the lock for writing, waiting for the other writers and for the
+ *   readers to leave.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be taken
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned
+ *   on failure:  -ECANCELED if the thread was canceled while waiting.
+ *
+ ****************************************************************************/
+
+int nxrwlock_wrlock(FAR rwlock_t *rwlock)
+{
+  irqstate_t flags;
+  int ret;
+
+  DEBUGASSERT(rwlock != NULL && !up_interrupt_context());
+
+  /* Wait for the other writers */
+
+  ret = nxsem_wait_uninterruptible(&rwlock->wrsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Keep new readers out, then wait for the current ones to leave */
+
+  flags = enter_critical_section();
+
+  rwlock->writer = true;
+  SP_DMB();
+
+  while (rwlock_nreaders(rwlock) != 0)
+    {
+      rwlock->drain = true;
+      ret = nxsem_wait_uninterruptible(&rwlock->wrwait);
+      if (ret < 0)
+        {
+          rwlock->drain  = false;
+          rwlock->writer = false;
+          rwlock_wakereaders(rwlock);
+          leave_critical_section(flags);
+
+          nxsem_post(&rwlock->wrsem);
+          return ret;
+        }
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxrwlock_wrunlock
+ *
+ * Description:
+ *   Release the lock taken for writing.  The lock is handed over to the
+ *   next waiting writer, if any, otherwise the waiting readers are woken
+ *   up.
+ *
+ * Input Parameters:
+ *   rwlock - The lock to be released
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxrwlock_wrunlock(FAR rwlock_t *rwlock)
+{
+  irqstate_t flags;
+  int sval;
+
+  DEBUGASSERT(rwlock != NULL && rwlock->writer);
+
+  flags = enter_critical_section();
+
+  /* Let the readers in only if no other writer waits */
+
+  nxsem_get_value(&rwlock->wrsem, &sval);
+  if (sval >= 0)
+    {
+      rwlock->writer = false;
+      rwlock_wakereaders(rwlock);
+    }
+
+  nxsem_post(&rwlock->wrsem);
+  leave_critical_section(flags);
+}